@@ -5,6 +5,8 @@
 
 #include  "ConfigData.h"
 
+#include  "config.h"
+
 #include  "platform.h"
 #include  "testing.h"
 
@@ -64,6 +66,12 @@ static float curTimezoneInHours = 0;
 static int curTimezoneInSeconds = 0;
 #endif
 
+/**
+ *  Set when curLocationCache holds a location estimated from the watch's
+ *  timezone rather than one from the phone.  Never persisted.
+ */
+static bool  fLocationProvisional = false;
+
 
 /**
  *  Silly little helper because we persist a "UTC offset" (from local) in seconds,
@@ -86,18 +94,19 @@ static void  compute_tz_in_hours()
 
 
 #ifndef PBL_SDK_2
-///  Return Pebble watch's effective local time offset from UTC, factoring in DST.
-static int  get_pebble_tz_secs()
+///  Return Pebble watch's effective local time offset from UTC, factoring in DST,
+///  at a given time.
+static int  get_pebble_tz_secs_at(time_t timeAt)
 {
 
 int gmtoff;
 
 #if TESTING_USE_DUMMY_COORDS
+   (void) timeAt;
    gmtoff = - TESTING_DUMMY_UTC_OFFSET;
 #else
 
-   time_t   tmNow = time(NULL);
-   struct tm * pTm = localtime(&tmNow);
+   struct tm * pTm = localtime(&timeAt);
 
    gmtoff = pTm->tm_gmtoff;
    if (pTm->tm_isdst > 0)
@@ -114,6 +123,111 @@ int gmtoff;
 
    return gmtoff;
 }
+
+
+///  Return Pebble watch's effective local time offset from UTC, factoring in DST.
+static int  get_pebble_tz_secs()
+{
+   return get_pebble_tz_secs_at(time(NULL));
+}
+
+
+///  Spacing of the offset probes looking for the next change.
+#define  TZ_PROBE_STEP_SECS   (7 * SECONDS_PER_DAY)
+
+///  Probes made: a little over a year ahead.
+#define  TZ_PROBE_STEPS       53
+
+/**
+ *  Time at or after which the watch's UTC offset is next expected to change
+ *  (or by which we should look again).  Zero to look at the next check.
+ */
+static time_t  timeNextTzCheck = 0;
+
+///  Set to have the next check read the offset, whatever the prediction.
+static bool  fTzVerifyDue = false;
+
+
+/**
+ *  Find when the watch's UTC offset next changes, by asking localtime() for
+ *  the offset a week at a time ahead, then bisecting the week in which it
+ *  differs down to the minute.  That's around 40 localtime() calls,
+ *  normally made just twice a year.
+ *
+ *  Offset changes closer together than a week (none known) can be missed;
+ *  the daily check via config_tz_verify_soon() catches those, as it also
+ *  re-predicts (another 40-odd calls, once a day) in case the watch has
+ *  since been given new rules.
+ *
+ *  @param timeFrom Time to search from.
+ *  @param tzSecsFrom Offset in effect at timeFrom.
+ *
+ *  @return First minute with a different offset, or the end of the
+ *          search if there is no change within it.
+ */
+static time_t  predict_next_tz_change(time_t timeFrom, int tzSecsFrom)
+{
+
+   //  offsets change on whole minutes, so keep probes minute aligned
+   time_t  timeBefore = timeFrom - (timeFrom % 60);
+
+   for (int step = 0;  step < TZ_PROBE_STEPS;  step++)
+   {
+      time_t timeProbe = timeBefore + TZ_PROBE_STEP_SECS;
+
+      if (get_pebble_tz_secs_at(timeProbe) != tzSecsFrom)
+      {
+         //  change is in (timeBefore, timeProbe]
+         while (timeProbe - timeBefore > 60)
+         {
+            time_t timeMid = timeBefore + ((timeProbe - timeBefore) / 120) * 60;
+
+            if (get_pebble_tz_secs_at(timeMid) == tzSecsFrom)
+            {
+               timeBefore = timeMid;
+            }
+            else
+            {
+               timeProbe = timeMid;
+            }
+         }
+         return timeProbe;
+      }
+
+      timeBefore = timeProbe;
+   }
+
+   return timeBefore;
+
+}  /* end of predict_next_tz_change() */
+
+
+/**
+ *  Fill curLocationCache with a guess at where the watch is, good enough to
+ *  draw a plausible dial until the phone tells us: longitude from the
+ *  standard (non-DST) UTC offset, at 15 degrees per hour, and latitude
+ *  CONFIG_PROVISIONAL_LATITUDE.  The cache is marked provisional, and
+ *  nothing is written to flash.
+ */
+static void  estimate_provisional_location(void)
+{
+
+   time_t timeNow = time(NULL);
+   struct tm * pTm = localtime(&timeNow);
+
+   //  (tm_gmtoff leaves DST out; if even that is unknown, Greenwich will do)
+   int stdOffsetSecs = (pTm->tm_isdst < 0) ? 0 : pTm->tm_gmtoff;
+
+   curLocationCache.usVersion      = CONFIG_DATA_CUR_VERSION;
+   curLocationCache.usReserved     = 0;
+   curLocationCache.fLatitude      = CONFIG_PROVISIONAL_LATITUDE;
+   curLocationCache.fLongitude     = stdOffsetSecs / 240.0;
+   curLocationCache.iUtcOffset     = -curTimezoneInSeconds;
+   curLocationCache.timeLastUpdate = timeNow;
+
+   fLocationProvisional = true;
+
+}  /* end of estimate_provisional_location() */
 #endif  // #ifndef PBL_SDK_2
 
 
@@ -151,6 +265,12 @@ void  config_data_init()
       memset(&curLocationCache, 0, sizeof(curLocationCache));
       // (Zeroing the timeLastUpdate field marks cache as invalid.)
       MY_APP_LOG(APP_LOG_LEVEL_WARNING, "* config_data_init(): no usable data");
+
+#ifndef PBL_SDK_2
+      //  rather than nothing to show until the phone answers, a guess
+      estimate_provisional_location();
+      compute_tz_in_hours();
+#endif
    }
    else
    {
@@ -168,21 +288,53 @@ bool  config_data_location_avail()
 }
 
 
+bool  config_data_location_is_provisional(void)
+{
+   return fLocationProvisional;
+}
+
+
 #ifndef PBL_SDK_2
 bool  config_has_tz_offset_changed()
 {
 
-   int latestTimezoneInSeconds = get_pebble_tz_secs();
-   if (latestTimezoneInSeconds != curTimezoneInSeconds)
+   time_t timeNow = time(NULL);
+
+   if ((timeNow < timeNextTzCheck) && ! fTzVerifyDue)
+   {
+      //  the usual case: nothing expected yet
+      return false;
+   }
+
+   fTzVerifyDue = false;
+
+   int latestTimezoneInSeconds = get_pebble_tz_secs_at(timeNow);
+   bool fChanged = (latestTimezoneInSeconds != curTimezoneInSeconds);
+
+   //  Even with the offset unchanged, predict again: the last prediction
+   //  was made at the previous switch, when the watch may not yet have had
+   //  the rules for the next one (and so found nothing within the year).
+
+   if (fChanged)
    {
       curTimezoneInSeconds = latestTimezoneInSeconds;
       compute_tz_in_hours();
-      return true;
    }
 
-   return false;
+   timeNextTzCheck = predict_next_tz_change(timeNow, latestTimezoneInSeconds);
+
+   MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "tz %d s, next change expected in %ld s",
+              latestTimezoneInSeconds, (long) (timeNextTzCheck - timeNow));
+
+   return fChanged;
 
 }
+
+
+void  config_tz_verify_soon(void)
+{
+   fTzVerifyDue = true;
+}
 #endif  // #ifndef PBL_SDK_2
 
 
@@ -234,8 +386,10 @@ bool  config_data_is_different(float latitude, float longitude, int32_t utcOffse
    float tmpLat, tmpLong;
    int32_t tmp_utcOffset;
 
-   return ! (config_data_location_get(&tmpLat, &tmpLong, &tmp_utcOffset, NULL) &&
-             (latitude == tmpLat) && (longitude == tmpLong) && (utcOffset == tmp_utcOffset));
+   //  (an estimate never matches: the phone's location should replace it)
+   return fLocationProvisional ||
+          ! (config_data_location_get(&tmpLat, &tmpLong, &tmp_utcOffset, NULL) &&
+               (latitude == tmpLat) && (longitude == tmpLong) && (utcOffset == tmp_utcOffset));
 
 }  /* end of config_data_is_different */
 
@@ -264,7 +418,7 @@ ConfigDataCurLocation   newLocation;
 
    int iRet;
 
-   if (locations_equiv(&newLocation, &curLocationCache))
+   if ((! fLocationProvisional) && locations_equiv(&newLocation, &curLocationCache))
    {
       //  we want to leave curLocationCache.timeLastUpdate undisturbed.
       return true;
@@ -280,6 +434,7 @@ ConfigDataCurLocation   newLocation;
    if (iRet == sizeof(newLocation))
    {
       curLocationCache = newLocation;
+      fLocationProvisional = false;
       compute_tz_in_hours();
 
       return true;
@@ -299,5 +454,6 @@ void  config_data_location_erase(void)
 
    //  clear cache to match:
    memset(&curLocationCache, 0, sizeof(curLocationCache));
+   fLocationProvisional = false;
 }
 
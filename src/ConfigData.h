@@ -23,16 +23,38 @@ void  config_data_init();
  */
 bool  config_data_location_avail();
 
+/**
+ *  Is the location only an estimate from the watch's timezone, made because
+ *  nothing was persisted yet (first run)?  Such a location counts as
+ *  available, but isn't written to flash, and is replaced as soon as the
+ *  phone supplies a real one via config_data_location_set().
+ *
+ *  @return \c true if the location is provisional.
+ */
+bool  config_data_location_is_provisional(void);
+
 /**
  *  Has timezone offset changed since our last check.
  *  Intended to detect whether the Pebble has changed its DST flag, or been
  *  updated by the phone.
  *
+ *  The time of the next DST switch is predicted, so that until then this is
+ *  just a compare against time(); localtime() is only called at the
+ *  predicted switch, or after config_tz_verify_soon() (which also has the
+ *  switch predicted afresh).
+ *
  *  Only makes sense in SDK v3 and later, since that is when Pebble first (!)
  *  added true on-watch support for timezones and DST.
  */
 #ifndef PBL_SDK_2
 bool  config_has_tz_offset_changed();
+
+/**
+ *  Have the next config_has_tz_offset_changed() really look at the watch's
+ *  offset, e.g. because the phone may have changed the watch's timezone,
+ *  or as a periodic check on the prediction.
+ */
+void  config_tz_verify_soon(void);
 #endif
 
 /**
@@ -0,0 +1,557 @@
+/**
+ *  @file
+ *
+ *  Daily watchface plan: computed off the drawing path, double buffered.
+ */
+
+
+#include  "DayPlan.h"
+
+#include  "ConfigData.h"
+#include  "platform.h"
+#include  "profiling.h"
+
+
+/**
+ *  Plans are built in steps, each small enough (a pair of calcSun() calls
+ *  at most) to be run from a timer callback without holding up the event
+ *  loop.  Steps run in this order.
+ */
+typedef enum {
+   BUILD_STEP_FIRST_BAND,                                   ///< one step per path
+   BUILD_STEP_TEXT = BUILD_STEP_FIRST_BAND + TWI_PATH_COUNT,
+   BUILD_STEP_MOON,
+   BUILD_STEP_DARK_HOURS,
+   BUILD_STEP_DONE
+} BuildStep;
+
+///  State of the spare plan's build, when done in time slices.
+static struct {
+   bool                 fRunning;
+   struct tm            tmDay;         ///< local date being planned
+   BuildStep            step;          ///< next step to run
+   AppTimer *           pTimer;        ///< scheduled next slice
+   DayPlanReadyHandler  onReady;
+   uint32_t             longestStepMs; ///< instrumentation
+   int                  cSlices;
+} build;
+
+
+///  PebbleOS persist_* key for the saved active plan.  (ConfigData.c has key 1.)
+#define  DAY_PLAN_PERSIST_KEY      2
+
+///  Version of DayPlanRecord's layout (and of DayPlan's).
+#define  DAY_PLAN_PERSIST_VERSION  3
+
+/**
+ *  The active plan as saved to flash, with what it was computed from, so
+ *  that a restart on the same day can show it without recomputing.
+ */
+typedef struct {
+
+   uint16_t  usVersion;        ///< DAY_PLAN_PERSIST_VERSION
+   uint16_t  cbPlan;           ///< sizeof(DayPlan), which varies by platform
+
+   float     fLatitude;        ///< config the plan was computed with
+   float     fLongitude;
+   float     fTzInHours;
+   bool      f24HourStyle;     ///< formatting of sunrise / sunset text
+
+   DayPlan   plan;
+
+   uint32_t  crc;              ///< CRC-32 of all of the above, padding included
+
+} DayPlanRecord;
+
+
+///  The two plan buffers: one active, the other spare.
+static DayPlan  aPlans[2];
+
+static DayPlan * pActivePlan = NULL;
+static DayPlan * pSparePlan  = &aPlans[0];
+
+///  Paths to compute bands with, per TwilightPathIndex.
+static TwilightPath * apPlanPaths[TWI_PATH_COUNT];
+
+
+void  day_plan_init(TwilightPath * const apPaths[TWI_PATH_COUNT])
+{
+
+   for (int iPath = 0;  iPath < TWI_PATH_COUNT;  iPath++)
+   {
+      apPlanPaths[iPath] = apPaths[iPath];
+   }
+
+   day_plan_cancel_build();
+
+   aPlans[0].fValid = false;
+   aPlans[1].fValid = false;
+
+   pActivePlan = NULL;
+   pSparePlan  = &aPlans[0];
+
+}  /* end of day_plan_init() */
+
+
+const DayPlan * day_plan_get_active(void)
+{
+   return pActivePlan;
+}
+
+
+bool  day_plan_is_for(const DayPlan *pPlan, const struct tm *pLocalDay)
+{
+
+   return ((pPlan != NULL) && pPlan->fValid &&
+           (pPlan->sYear  == pLocalDay->tm_year) &&
+           (pPlan->cMonth == pLocalDay->tm_mon) &&
+           (pPlan->cMday  == pLocalDay->tm_mday));
+
+}  /* end of day_plan_is_for() */
+
+
+bool  day_plan_spare_is_for(const struct tm *pLocalDay)
+{
+   return day_plan_is_for(pSparePlan, pLocalDay);
+}
+
+
+bool  day_plan_is_dark_minute(const DayPlan *pPlan, int localMinute)
+{
+
+   const TwilightBand * pAstro = &pPlan->aBands[TWI_PATH_ASTRO];
+
+   //  (with no astro twilight band at all, NO_RISE_SET_MINUTE sorts below
+   //   every minute and so reads as dark)
+   return ((localMinute < pAstro->sDawnMinute) ||
+           (localMinute > pAstro->sDuskMinute));
+
+}  /* end of day_plan_is_dark_minute() */
+
+
+/**
+ *  Given a local date, return the astronomical julian day.
+ *  This is not day-of-year, but a much larger value.
+ */
+static int  tm2jd(const struct tm *pDay)
+{
+   int y, m, d, a, b, c, e, f;
+   y = pDay->tm_year + 1900;
+   m = pDay->tm_mon + 1;
+   d = pDay->tm_mday;
+   if (m < 3)
+   {
+      m += 12;
+      y -= 1;
+   }
+   a = y / 100;
+   b = a / 4;
+   c = 2 - a + b;
+   e = 365.25 * (y + 4716);
+   f = 30.6001 * (m + 1);
+   return c + d + e + f - 1524;
+}
+
+
+#ifndef PBL_ROUND
+/**
+ *  Format a twilight path's dawn / dusk minute of day for display.
+ *
+ *  @param pszBuf Receives formatted text.
+ *  @param cbBuf Size of pszBuf.
+ *  @param pszFormat strftime() format to use.
+ *  @param pTmDay Date the minute falls on; its hour and minute are overwritten.
+ *  @param minuteOfDay Time to show, or NO_RISE_SET_MINUTE.
+ */
+static void  format_minute_of_day(char *pszBuf, size_t cbBuf, const char *pszFormat,
+                                  struct tm *pTmDay, int minuteOfDay)
+{
+
+   if (minuteOfDay == NO_RISE_SET_MINUTE)
+   {
+      strncpy(pszBuf, "--:--", cbBuf);
+      pszBuf[cbBuf - 1] = '\0';
+      return;
+   }
+
+   pTmDay->tm_hour = minuteOfDay / 60;
+   pTmDay->tm_min  = minuteOfDay % 60;
+
+   strftime(pszBuf, cbBuf, pszFormat, pTmDay);
+
+}  /* end of format_minute_of_day() */
+#endif
+
+
+/**
+ *  Run one step of building a plan.
+ *
+ *  @param pPlan Plan being built.
+ *  @param pDay Date being planned.  Time of day fields may be overwritten.
+ *  @param step Step to run.
+ */
+static void  build_step(DayPlan *pPlan, struct tm *pDay, BuildStep step)
+{
+
+   if (step < BUILD_STEP_TEXT)
+   {
+      int iPath = step - BUILD_STEP_FIRST_BAND;
+
+      twilight_path_compute_current(apPlanPaths[iPath], pDay, &pPlan->aBands[iPath]);
+      return;
+   }
+
+   switch (step)
+   {
+      case BUILD_STEP_TEXT:
+#ifndef PBL_ROUND
+         {
+            //  Want the user's default time format, but not for the current time.
+            //  We can't use clock_copy_time_string(), so make an equivalent format:
+            const char * pszTimeFormat = clock_is_24h_style() ? "%R" : "%l:%M";
+
+            format_minute_of_day(pPlan->szSunrise, sizeof(pPlan->szSunrise), pszTimeFormat,
+                                 pDay, pPlan->aBands[TWI_PATH_CIVIL].sDawnMinute);
+            format_minute_of_day(pPlan->szSunset,  sizeof(pPlan->szSunset),  pszTimeFormat,
+                                 pDay, pPlan->aBands[TWI_PATH_CIVIL].sDuskMinute);
+         }
+#endif
+         break;
+
+      case BUILD_STEP_MOON:
+         moon_phase_compute(tm2jd(pDay), (config_data_get_latitude() < 0), &pPlan->moon);
+         break;
+
+      case BUILD_STEP_DARK_HOURS:
+         pPlan->darkHourMask = 0;
+         for (int hour = 0;  hour < 24;  hour++)
+         {
+            if (day_plan_is_dark_minute(pPlan, hour * 60))
+            {
+               pPlan->darkHourMask |= (1ul << hour);
+            }
+         }
+         break;
+
+      default:
+         break;
+   }
+
+}  /* end of build_step() */
+
+
+/**
+ *  Stamp a fully built spare plan with its date, making it valid.
+ */
+static void  finish_spare(const struct tm *pLocalDay)
+{
+
+   pSparePlan->sYear  = pLocalDay->tm_year;
+   pSparePlan->cMonth = pLocalDay->tm_mon;
+   pSparePlan->cMday  = pLocalDay->tm_mday;
+   pSparePlan->fValid = true;
+
+}  /* end of finish_spare() */
+
+
+void  day_plan_build_spare(const struct tm *pLocalDay)
+{
+
+   day_plan_cancel_build();
+
+   //  work on a copy: the compute / format routines want a writable struct tm
+   struct tm  tmDay = *pLocalDay;
+
+   pSparePlan->fValid = false;
+
+   for (BuildStep step = BUILD_STEP_FIRST_BAND;  step < BUILD_STEP_DONE;  step++)
+   {
+      build_step(pSparePlan, &tmDay, step);
+   }
+
+   finish_spare(pLocalDay);
+
+}  /* end of day_plan_build_spare() */
+
+
+/**
+ *  Timer callback: run build steps until this slice's time budget is used
+ *  up (always at least one), then schedule the next slice or finish.
+ */
+static void  build_slice(void *pUnused)
+{
+
+   (void) pUnused;
+
+   build.pTimer = NULL;
+   build.cSlices++;
+
+   uint32_t sliceStartMs = profile_now_ms();
+
+   do
+   {
+      uint32_t stepStartMs = profile_now_ms();
+
+      build_step(pSparePlan, &build.tmDay, build.step);
+      build.step++;
+
+      uint32_t stepMs = profile_now_ms() - stepStartMs;
+      if (stepMs > build.longestStepMs)
+      {
+         build.longestStepMs = stepMs;
+      }
+
+   } while ((build.step < BUILD_STEP_DONE) &&
+            (profile_now_ms() - sliceStartMs < DAY_PLAN_SLICE_BUDGET_MS));
+
+   if (build.step < BUILD_STEP_DONE)
+   {
+      build.pTimer = app_timer_register(DAY_PLAN_SLICE_INTERVAL_MS, build_slice, NULL);
+      if (build.pTimer != NULL)
+      {
+         return;
+      }
+
+      //  can't schedule: finish up now rather than leave the plan half built
+      while (build.step < BUILD_STEP_DONE)
+      {
+         build_step(pSparePlan, &build.tmDay, build.step++);
+      }
+   }
+
+   build.fRunning = false;
+   finish_spare(&build.tmDay);
+
+   MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "day plan %d/%d: %d steps, %d slices, longest step %lu ms",
+              build.tmDay.tm_mon + 1, build.tmDay.tm_mday, BUILD_STEP_DONE, build.cSlices,
+              (unsigned long) build.longestStepMs);
+
+   if (build.onReady != NULL)
+   {
+      build.onReady();
+   }
+
+}  /* end of build_slice() */
+
+
+void  day_plan_build_spare_async(const struct tm *pLocalDay, DayPlanReadyHandler onReady)
+{
+
+   day_plan_cancel_build();
+
+   pSparePlan->fValid = false;
+
+   build.tmDay         = *pLocalDay;
+   build.step          = BUILD_STEP_FIRST_BAND;
+   build.onReady       = onReady;
+   build.longestStepMs = 0;
+   build.cSlices       = 0;
+   build.fRunning      = true;
+
+   build.pTimer = app_timer_register(0, build_slice, NULL);
+   if (build.pTimer == NULL)
+   {
+      //  no timer: do it the old fashioned way
+      build_slice(NULL);
+   }
+
+}  /* end of day_plan_build_spare_async() */
+
+
+bool  day_plan_build_pending_for(const struct tm *pLocalDay)
+{
+
+   return (build.fRunning &&
+           (build.tmDay.tm_year == pLocalDay->tm_year) &&
+           (build.tmDay.tm_mon  == pLocalDay->tm_mon) &&
+           (build.tmDay.tm_mday == pLocalDay->tm_mday));
+
+}  /* end of day_plan_build_pending_for() */
+
+
+void  day_plan_cancel_build(void)
+{
+
+   if (build.pTimer != NULL)
+   {
+      app_timer_cancel(build.pTimer);
+      build.pTimer = NULL;
+   }
+
+   build.fRunning = false;
+
+}  /* end of day_plan_cancel_build() */
+
+
+const DayPlan * day_plan_swap(void)
+{
+
+   //  (a build still under way would carry on into the old active plan)
+   day_plan_cancel_build();
+
+   DayPlan * pNewSpare = (pActivePlan != NULL) ? pActivePlan
+                                               : &aPlans[(pSparePlan == &aPlans[0]) ? 1 : 0];
+
+   pActivePlan = pSparePlan;
+   pSparePlan  = pNewSpare;
+
+   //  old active plan is stale as a spare
+   pSparePlan->fValid = false;
+
+   return pActivePlan;
+
+}  /* end of day_plan_swap() */
+
+
+void  day_plan_discard_spare(void)
+{
+   day_plan_cancel_build();
+   pSparePlan->fValid = false;
+}
+
+
+bool  day_plan_equal(const DayPlan *pPlanA, const DayPlan *pPlanB)
+{
+
+   for (int iPath = 0;  iPath < TWI_PATH_COUNT;  iPath++)
+   {
+      const TwilightBand * pBandA = &pPlanA->aBands[iPath];
+      const TwilightBand * pBandB = &pPlanB->aBands[iPath];
+
+      if ((pBandA->sDawnMinute != pBandB->sDawnMinute) ||
+          (pBandA->sDuskMinute != pBandB->sDuskMinute))
+      {
+         return false;
+      }
+   }
+
+#ifndef PBL_ROUND
+   //  (compared as strings: bytes past the terminator are left over from other days)
+   if ((strcmp(pPlanA->szSunrise, pPlanB->szSunrise) != 0) ||
+       (strcmp(pPlanA->szSunset, pPlanB->szSunset) != 0))
+   {
+      return false;
+   }
+#endif
+
+   return ((memcmp(&pPlanA->moon, &pPlanB->moon, sizeof(MoonShape)) == 0) &&
+           (pPlanA->darkHourMask == pPlanB->darkHourMask));
+
+}  /* end of day_plan_equal() */
+
+
+bool  day_plan_spare_matches_active(void)
+{
+
+   return ((pActivePlan != NULL) && pSparePlan->fValid &&
+           (pSparePlan->sYear  == pActivePlan->sYear) &&
+           (pSparePlan->cMonth == pActivePlan->cMonth) &&
+           (pSparePlan->cMday  == pActivePlan->cMday) &&
+           day_plan_equal(pSparePlan, pActivePlan));
+
+}  /* end of day_plan_spare_matches_active() */
+
+
+/**
+ *  CRC-32 (IEEE 802.3), bit at a time: a table would cost 1K of flash to
+ *  speed up a check made once per start.
+ */
+static uint32_t  crc32(const void *pData, size_t cbData)
+{
+
+   const uint8_t * pByte = pData;
+   uint32_t crc = 0xFFFFFFFF;
+
+   while (cbData-- > 0)
+   {
+      crc ^= *pByte++;
+      for (int bit = 0;  bit < 8;  bit++)
+      {
+         crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+      }
+   }
+
+   return ~crc;
+
+}  /* end of crc32() */
+
+
+///  Fill in everything but the plan and CRC of a record for the current config.
+static void  init_record(DayPlanRecord *pRecord)
+{
+
+   memset(pRecord, 0, sizeof(*pRecord));
+
+   pRecord->usVersion    = DAY_PLAN_PERSIST_VERSION;
+   pRecord->cbPlan       = sizeof(DayPlan);
+   pRecord->fLatitude    = config_data_get_latitude();
+   pRecord->fLongitude   = config_data_get_longitude();
+   pRecord->fTzInHours   = config_data_get_tz_in_hours();
+   pRecord->f24HourStyle = clock_is_24h_style();
+
+}  /* end of init_record() */
+
+
+void  day_plan_save_active(void)
+{
+
+   if ((pActivePlan == NULL) || (sizeof(DayPlanRecord) > PERSIST_DATA_MAX_LENGTH))
+   {
+      return;
+   }
+
+   DayPlanRecord  record;
+
+   init_record(&record);
+   record.plan = *pActivePlan;
+   record.crc  = crc32(&record, offsetof(DayPlanRecord, crc));
+
+   int iRet = persist_write_data(DAY_PLAN_PERSIST_KEY, &record, sizeof(record));
+   if (iRet < (int) sizeof(record))
+   {
+      MY_APP_LOG(APP_LOG_LEVEL_WARNING, "day plan save failed, ret = %d", iRet);
+   }
+
+}  /* end of day_plan_save_active() */
+
+
+bool  day_plan_restore(const struct tm *pLocalDay)
+{
+
+   DayPlanRecord  saved;
+   DayPlanRecord  current;
+
+   if ((sizeof(DayPlanRecord) > PERSIST_DATA_MAX_LENGTH) ||
+       (persist_read_data(DAY_PLAN_PERSIST_KEY, &saved, sizeof(saved)) < (int) sizeof(saved)))
+   {
+      return false;
+   }
+
+   init_record(&current);
+
+   if ((saved.usVersion != current.usVersion) || (saved.cbPlan != current.cbPlan) ||
+       (saved.crc != crc32(&saved, offsetof(DayPlanRecord, crc))))
+   {
+      MY_APP_LOG(APP_LOG_LEVEL_WARNING, "saved day plan unusable");
+      return false;
+   }
+
+   //  still good for today, here, and in this time format?
+   if ((saved.fLatitude != current.fLatitude) || (saved.fLongitude != current.fLongitude) ||
+       (saved.fTzInHours != current.fTzInHours) ||
+       (saved.f24HourStyle != current.f24HourStyle) ||
+       ! day_plan_is_for(&saved.plan, pLocalDay))
+   {
+      return false;
+   }
+
+   day_plan_cancel_build();
+
+   aPlans[0]   = saved.plan;
+   pActivePlan = &aPlans[0];
+   pSparePlan  = &aPlans[1];
+   pSparePlan->fValid = false;
+
+   return true;
+
+}  /* end of day_plan_restore() */
@@ -0,0 +1,165 @@
+/**
+ *  @file
+ *
+ *  Everything about the watchface which changes once per day (twilight
+ *  bands, sunrise / sunset text, moon phase, which hour marks fall on the
+ *  dark part of the dial), computed together ahead of time.
+ *
+ *  Two plans are kept: the active one, which drawing code reads and never
+ *  changes, and a spare which is built for the coming day (or for a new
+ *  location) and then swapped in.
+ */
+
+#pragma once
+
+#include  "pebble.h"
+
+#include  "moon_phase.h"
+#include  "TwilightPath.h"
+
+
+///  Index of each of our twilight paths, in the order they are painted.
+typedef enum {
+   TWI_PATH_NIGHT,         ///< boundary between night and astronomical twilight
+   TWI_PATH_ASTRO,         ///< boundary between astronomical and nautical twilight
+   TWI_PATH_NAUTICAL,      ///< boundary between nautical and civil twilight
+   TWI_PATH_CIVIL,         ///< daylight edge of civil twilight (sunrise / sunset)
+   TWI_PATH_COUNT
+} TwilightPathIndex;
+
+
+///  Local minute of day from which the next day's plan is prepared.
+#define  DAY_PLAN_PREPARE_MINUTE   (23 * 60)
+
+///  Most time, in ms, a time-sliced plan build may take per timer callback.
+#define  DAY_PLAN_SLICE_BUDGET_MS     10
+
+///  Gap, in ms, left between time-sliced plan build callbacks.
+#define  DAY_PLAN_SLICE_INTERVAL_MS   20
+
+///  Room for "hh:mm" plus terminator.
+#define  DAY_PLAN_TIME_TEXT_SIZE   6
+
+
+typedef struct {
+
+   ///  Has this plan been built?
+   bool  fValid;
+
+   ///  Local date this plan is for, as struct tm's tm_year / tm_mon / tm_mday.
+   int16_t  sYear;
+   uint8_t  cMonth;
+   uint8_t  cMday;
+
+   ///  Dawn / dusk times, per TwilightPathIndex.
+   TwilightBand  aBands[TWI_PATH_COUNT];
+
+#ifndef PBL_ROUND
+   ///  Sunrise / sunset, formatted per the user's 12 / 24 hour preference.
+   char  szSunrise[DAY_PLAN_TIME_TEXT_SIZE];
+   char  szSunset[DAY_PLAN_TIME_TEXT_SIZE];
+#endif
+
+   ///  Moon phase, ready to draw.
+   MoonShape  moon;
+
+   ///  Bit h set when hour h's dial mark is over the dark part of the dial.
+   uint32_t  darkHourMask;
+
+} DayPlan;
+
+
+/**
+ *  Supply the twilight paths which plans are computed with.  The paths must
+ *  outlive all use of this module.
+ *
+ *  @param apPaths One path per TwilightPathIndex.
+ */
+void  day_plan_init(TwilightPath * const apPaths[TWI_PATH_COUNT]);
+
+///  Plan that drawing code should use, or NULL if none has been built yet.
+const DayPlan * day_plan_get_active(void);
+
+///  Is a (possibly NULL) plan for the local date in *pLocalDay?
+bool  day_plan_is_for(const DayPlan *pPlan, const struct tm *pLocalDay);
+
+///  Is the spare plan built, and for the local date in *pLocalDay?
+bool  day_plan_spare_is_for(const struct tm *pLocalDay);
+
+/**
+ *  Compute a complete plan for a local date into the spare buffer, using
+ *  the current location, all at once.  The active plan is not touched.
+ *  Any time-sliced build in progress is abandoned.
+ *
+ *  @param pLocalDay Local date to plan; time of day fields are ignored.
+ */
+void  day_plan_build_spare(const struct tm *pLocalDay);
+
+///  Called when a time-sliced build completes.  The spare plan is then valid.
+typedef void (*DayPlanReadyHandler)(void);
+
+/**
+ *  As day_plan_build_spare(), but done in small steps from timer callbacks
+ *  so that the event loop (ticks, redraws, messages) keeps running.  Until
+ *  it completes, the active plan is untouched and the spare is not valid.
+ *  Any build already in progress is abandoned.
+ *
+ *  @param pLocalDay Local date to plan.
+ *  @param onReady Called once the spare plan is complete; may be NULL.
+ */
+void  day_plan_build_spare_async(const struct tm *pLocalDay, DayPlanReadyHandler onReady);
+
+///  Is a time-sliced build for the local date in *pLocalDay under way?
+bool  day_plan_build_pending_for(const struct tm *pLocalDay);
+
+///  Abandon any time-sliced build in progress.
+void  day_plan_cancel_build(void);
+
+/**
+ *  Make the spare plan active.  Callers must re-point anything holding on
+ *  to the old active plan's text, since that becomes the next spare.
+ *
+ *  @return New active plan.
+ */
+const DayPlan * day_plan_swap(void);
+
+/**
+ *  Forget the spare plan, e.g. because location has changed since it was
+ *  built, abandoning any build of it in progress.
+ */
+void  day_plan_discard_spare(void);
+
+/**
+ *  Does a time fall over the dark (night or astronomical twilight) part of
+ *  the dial?  With no astronomical twilight band at all, every time is dark.
+ */
+bool  day_plan_is_dark_minute(const DayPlan *pPlan, int localMinute);
+
+///  Does an hour's dial mark fall over the dark part of the dial?
+static inline bool  day_plan_is_dark_hour(const DayPlan *pPlan, int localHour)
+{
+   return (pPlan->darkHourMask & (1ul << localHour)) != 0;
+}
+
+
+///  Do two plans show the same thing (dates aside)?
+bool  day_plan_equal(const DayPlan *pPlanA, const DayPlan *pPlanB);
+
+///  Is the spare plan built, for the active plan's date, and the same as it?
+bool  day_plan_spare_matches_active(void);
+
+/**
+ *  Save the active plan to flash, along with the location, time zone and
+ *  time format it was computed for.  Blocking, like any flash write, so
+ *  best done once per new plan.
+ */
+void  day_plan_save_active(void);
+
+/**
+ *  Make the saved plan active, if it is intact, for the local date in
+ *  *pLocalDay, and was computed with the current location, time zone and
+ *  time format.  Lets a restart show the right face on its first frame.
+ *
+ *  @return \c true if the saved plan is now active.
+ */
+bool  day_plan_restore(const struct tm *pLocalDay);
@@ -36,7 +36,9 @@ static void  message_window_load(Window *pWindow)
       return;
    }
 
-   text_layer_set_font(pCaption, pFontMediumText);
+   //  (the watchface loads its custom font a little after start up)
+   text_layer_set_font(pCaption, (pFontMediumText != NULL) ? pFontMediumText
+                                 : fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD));
    text_layer_set_font(pMsgText, pFontSmallText);
    
    text_layer_set_text_alignment(pCaption, GTextAlignmentCenter);
@@ -6,6 +6,7 @@
 
 #include  "TransRotBmp.h"
 
+#include  "arena.h"
 #include  "helpers.h"
 
 
@@ -18,7 +19,7 @@ TransRotBmp* transrotbmp_create_with_resources(uint32_t residWhiteMask
 
 TransRotBmp* pMyRet;
 
-   pMyRet = (TransRotBmp*) malloc(sizeof(TransRotBmp));
+   pMyRet = (TransRotBmp*) arena_alloc(sizeof(TransRotBmp));
    if (pMyRet == 0)
    {
       return 0;
@@ -139,7 +140,7 @@ void  transrotbmp_destroy(TransRotBmp *pTransBmp)
    SAFE_DESTROY(gbitmap, pTransBmp->pBmpBlackMask);
 #endif
 
-   free(pTransBmp);
+   arena_free(pTransBmp);
 
    return;
 
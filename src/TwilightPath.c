@@ -6,27 +6,78 @@
 
 #include  "TwilightPath.h"
 
+#include  "arena.h"
 #include  "ConfigData.h"
 #include  "geometry.h"
 #include  "helpers.h"
-#include  "my_math.h"
 #include  "suncalc.h"
 
 
+#ifndef PBL_ROUND
+
 //  Values used in our static (non-computed) points to indicate a screen edge.
 //  These are relative to the dial's center hub, to vertical values must account
-//  for the face's screen offset if any.
+//  for the face's screen offset if any.  All four are on-screen pixel positions.
 #define X_RIGHT   (DISP_WIDTH / 2 - 1)
 #define X_LEFT    (-DISP_WIDTH / 2)
-#define Y_BOTTOM  (DISP_HEIGHT / 2 - FACE_VOFFSET)
+#define Y_BOTTOM  (DISP_HEIGHT / 2 - FACE_VOFFSET - 1)
 #define Y_TOP     (-DISP_HEIGHT / 2 - FACE_VOFFSET)
 
 
+/**
+ *  Screen edges, in clockwise order as seen on the display.  The corner at
+ *  the clockwise end of each edge is in aEdgeEndCorners[].
+ */
+typedef enum {
+   EDGE_LEFT,
+   EDGE_TOP,
+   EDGE_RIGHT,
+   EDGE_BOTTOM,
+   EDGE_COUNT
+} ScreenEdge;
+
+static const GPoint aEdgeEndCorners[EDGE_COUNT] = {
+   { X_LEFT,  Y_TOP    },      // left edge runs up to upper left
+   { X_RIGHT, Y_TOP    },      // top edge runs right to upper right
+   { X_RIGHT, Y_BOTTOM },      // right edge runs down to lower right
+   { X_LEFT,  Y_BOTTOM },      // bottom edge runs left to lower left
+};
+
+
+/**
+ *  Points of the one path being drawn, shared by all instances: bands are
+ *  rendered one at a time, and each is generated afresh from its dawn /
+ *  dusk minutes just before drawing.
+ *  
+ *  NOTE: sample file
+ *  
+ *    PebbleSDK-2.0-BETA4/Examples/watchapps/feature_gpath/src/feature_gpath.c
+ *  
+ *  includes this comment:
+ *  
+ *    A path can be concave, but it should not twist on itself
+ *    The points should be defined in clockwise order due to the rendering
+ *    implementation. Counter-clockwise will work in older firmwares, but
+ *    it is not officially supported
+ *  
+ *  So we change the ordering of our computed points depending on whether
+ *  the path is to enclose the top or bottom of the screen, to ensure that
+ *  our path goes in a clockwise direction.  We don't explicitly close the
+ *  path, but PebbleOS seems to infer that.
+ */
+static GPoint  aScratchPoints[POINTS_IN_TWILIGHT_PATH];
+
+///  Path over aScratchPoints, for Pebble graphics primitives.
+static GPath  scratchPath;
+
+#endif  // #ifndef PBL_ROUND
+
+
 TwilightPath * twilight_path_create(float zenithAngle, ScreenPartToEnclose toEnclose,
-                                    uint32_t greyBitmapResourceId)
+                                    DitherShade greyShade)
 {
 
-   TwilightPath * pMyRet = malloc(sizeof(TwilightPath));
+   TwilightPath * pMyRet = arena_alloc(sizeof(TwilightPath));
    if (pMyRet == 0)
    {
       return pMyRet;
@@ -34,27 +85,11 @@ TwilightPath * twilight_path_create(float zenithAngle, ScreenPartToEnclose toEnc
 
    pMyRet->fZenith = zenithAngle;
 
-   if (greyBitmapResourceId != INVALID_RESOURCE)
-   {
-      pMyRet->pBmpGrey = gbitmap_create_with_resource(greyBitmapResourceId);
-      if (pMyRet->pBmpGrey == NULL)
-      {
-         free(pMyRet);
-         return NULL;
-      }
-   }
-   else
-   {
-      pMyRet->pBmpGrey = NULL;
-   }
-
-   //  until twilight_path_compute_current() is called:
-   pMyRet->pPath = 0;
-   pMyRet->pathInfo.num_points = 0;
-   pMyRet->pathInfo.points = pMyRet->aPathPoints;
-
 #ifdef PBL_PLATFORM_APLITE
    pMyRet->toEnclose = toEnclose;
+   pMyRet->greyShade = greyShade;
+#else
+   (void) greyShade;
 #endif
 
    return pMyRet; 
@@ -133,30 +168,57 @@ static void  calcRiseAndSet(float *riseTime, float *setTime,
 } /* end of calcRiseAndSet() */
 
 
+/**
+ *  Convert a local hour + fraction, as returned by calcRiseAndSet(), to the
+ *  nearest minute of day.  This is the last float operation on the way from
+ *  sun position to screen: all path geometry works in integer minutes.
+ */
+static int16_t  hours_to_minute_of_day(float fLocalHour)
+{
+
+   if (fLocalHour == NO_RISE_SET_TIME)
+   {
+      return NO_RISE_SET_MINUTE;
+   }
+
+   int minute = (int)(fLocalHour * 60 + 0.5f);
+   if (minute >= MINUTES_PER_DAY)
+   {
+      minute -= MINUTES_PER_DAY;
+   }
+
+   return (int16_t) minute;
+
+}  /* end of hours_to_minute_of_day */
+
+
+#ifndef PBL_ROUND
+
 /**
  *  Find the location of a point in the twilight path, corresponding to some
- *  time expressed.  Since this is for drawing a twilight path, we attempt
- *  to ensure that the point is at the very edge of the screen.  This is
- *  expressed in the usual hub-relative twilight path form.
+ *  time expressed.  Since this is for drawing a twilight path, the point is
+ *  where a ray from the dial hub through the time's dial mark leaves the
+ *  screen.  This is expressed in the usual hub-relative twilight path form.
  *  
- *  We do not attempt to crop the point's coordinates to overall X/Y minima / maxima
- *  for the our host Pebble device's screen, since this would result in altering
- *  the effective hour angle (at least when done trivially, and cycles / RAM are
- *  both at premiums).
+ *  The ray is intersected with the screen edge exactly (rather than simply
+ *  cropping x and y), so the effective hour angle is unchanged while the
+ *  point, and so every path vertex, stays on the screen.  That keeps the
+ *  polygons handed to the rasteriser no larger than the screen itself.
  * 
- *  @param fLocalHour Local time, in hours and fractions of an hour.
- *  @param pPoint Point where a ray drawn from the dial hub through the localHour
- *                dial mark strikes the edge of the Pebble display.  May be off
- *                the screen, works because our target layer does clipping.
+ *  @param localMinute Local time, as minute of day (0 .. 1439).
+ *  @param pPoint Point where a ray drawn from the dial hub through the localMinute
+ *                dial mark strikes the edge of the Pebble display.
+ *  @param pEdge Receives the screen edge which *pPoint lies on.
  * 
- *  @return \c true if we produce a valid point, or \c false if the input hour 
- *           value is NO_RISE_SET_TIME (== "no such twilight band now"). 
+ *  @return \c true if we produce a valid point, or \c false if the input minute 
+ *           value is NO_RISE_SET_MINUTE (== "no such twilight band now"). 
  */
-bool  find_time_path_point(float fLocalHour, struct GPoint *pPoint)
+static bool  find_time_path_point(int localMinute, struct GPoint *pPoint,
+                                  ScreenEdge *pEdge)
 {
 
 
-   if (fLocalHour == NO_RISE_SET_TIME)
+   if (localMinute == NO_RISE_SET_MINUTE)
    {
       //  no path for this phase of twilight
       return (false);
@@ -171,19 +233,41 @@ bool  find_time_path_point(float fLocalHour, struct GPoint *pPoint)
    //  As observed in draw_small_hour_mark(), we can deal with these issues thusly:
    //  Since the Pebble's native Y axis values increase down the display, this causes a
    //  mirroring effect on sin/cos values so that angles increase in a clockwise direction.
-   //  So we only need to offset our hour value so that 00:00 comes out 1/4 of the way
+   //  So we only need to offset our time value so that 00:00 comes out 1/4 of the way
    //  around the dial from trig's natural 0 angle (18:00 on our face).
+   //
+   //  Like the hour marks and hour hand, we stay in Pebble's integer angle domain.
 
-   fLocalHour += 6;
+   int32_t trigAngle = (localMinute + 6 * 60) * TRIG_MAX_ANGLE / MINUTES_PER_DAY;
 
-   const float fLocalHourRadians = fLocalHour / 24 * M_PI * 2;
+   int32_t dx = cos_lookup(trigAngle);
+   int32_t dy = sin_lookup(trigAngle);
 
-   int16_t x = (int16_t)(my_cos(fLocalHourRadians) * FULL_DISP_RADIUS);
-   int16_t y = (int16_t)(my_sin(fLocalHourRadians) * FULL_DISP_RADIUS);
+   //  Distance from hub to the vertical / horizontal edge the ray heads toward.
+   int32_t xLimit = (dx >= 0) ? X_RIGHT  : -X_LEFT;
+   int32_t yLimit = (dy >= 0) ? Y_BOTTOM : -Y_TOP;
 
-   //  NB: tempting to clip x & y to the screen edge, but doing so changes
-   //      the effective hour angle.  Fortunately, Pebble's default for
-   //      the base layer which we're drawing into is clipping-enabled.
+   int32_t absDx = (dx >= 0) ? dx : -dx;
+   int32_t absDy = (dy >= 0) ? dy : -dy;
+
+   //  Ray reaches x == +-xLimit before y == +-yLimit iff |dy| / |dx| < yLimit / xLimit.
+   //  Either way the other coordinate is scaled along the ray, truncating toward
+   //  the hub so that it can't step off the screen.
+   int16_t x;
+   int16_t y;
+
+   if (absDy * xLimit < absDx * yLimit)
+   {
+      x = (dx >= 0) ? xLimit : -xLimit;
+      y = dy * xLimit / absDx;
+      *pEdge = (dx >= 0) ? EDGE_RIGHT : EDGE_LEFT;
+   }
+   else
+   {
+      y = (dy >= 0) ? yLimit : -yLimit;
+      x = dx * yLimit / absDy;
+      *pEdge = (dy >= 0) ? EDGE_BOTTOM : EDGE_TOP;
+   }
 
    *pPoint = GPoint(x, y);
 
@@ -192,172 +276,278 @@ bool  find_time_path_point(float fLocalHour, struct GPoint *pPoint)
 }  /* end of find_time_path_point() */
 
 
-void  twilight_path_compute_current(TwilightPath *pTwilightPath,
-                                    struct tm * localTime)
+/**
+ *  Distance of a point along its screen edge, increasing in the clockwise
+ *  direction.  Only meaningful when comparing two points on the same edge.
+ */
+static int  edge_position(GPoint point, ScreenEdge edge)
 {
 
+   switch (edge)
+   {
+      case EDGE_LEFT:    return -point.y;
+      case EDGE_TOP:     return  point.x;
+      case EDGE_RIGHT:   return  point.y;
+      default:           return -point.x;
+   }
 
-   //  Find time of day for dawn and dusk times.  Results are expressed
-   //  as local hour-of-day, with minutes as fraction of an hour.
-   float fDawnTime;
-   float fDuskTime;
-   calcRiseAndSet(&fDawnTime, &fDuskTime, localTime, pTwilightPath->fZenith);
+}  /* end of edge_position() */
+
+
+/**
+ *  Append to a path the screen corners passed when walking clockwise around
+ *  the screen edge from one edge point to another.
+ *  
+ *  @param aPoints Path points to append to.
+ *  @param iPt Index of next point to write in aPoints.
+ *  @param fromPoint Walk starts here.
+ *  @param fromEdge Edge fromPoint lies on.
+ *  @param toPoint Walk ends here.
+ *  @param toEdge Edge toPoint lies on.
+ * 
+ *  @return Updated iPt.
+ */
+static int  add_corners_clockwise(GPoint *aPoints, int iPt,
+                                  GPoint fromPoint, ScreenEdge fromEdge,
+                                  GPoint toPoint, ScreenEdge toEdge)
+{
+
+   if ((fromEdge == toEdge) &&
+       (edge_position(fromPoint, fromEdge) <= edge_position(toPoint, toEdge)))
+   {
+      //  short walk along a single edge: no corners at all
+      return iPt;
+   }
+
+   //  Otherwise pass the corner ending each edge until we reach toEdge.  When
+   //  both points share an edge but "to" lies behind "from", this goes all
+   //  the way around the screen, which is what we want: e.g. dawn just after
+   //  midnight with dusk just before it.
+   ScreenEdge edge = fromEdge;
+   do
+   {
+      aPoints[iPt++] = aEdgeEndCorners[edge];
+      edge = (edge + 1) % EDGE_COUNT;
+   } while (edge != toEdge);
+
+   return iPt;
 
-   //  save true dawn / dusk times
-   pTwilightPath->fDawnTime = fDawnTime;
-   pTwilightPath->fDuskTime = fDuskTime;
+}  /* end of add_corners_clockwise() */
+
+
+/**
+ *  Generate the points of a band's path, enclosing either top or bottom of
+ *  the watch screen.
+ *  
+ *  @param pBand Band to generate the path of.
+ *  @param toEnclose Part of the screen to enclose: normally as requested
+ *             when twilight_path_create() was called.
+ *  @param aPoints Receives up to POINTS_IN_TWILIGHT_PATH points.
+ * 
+ *  @return Number of points written, zero if the band has no dawn / dusk.
+ */
+static int  build_band_points(const TwilightBand *pBand, ScreenPartToEnclose toEnclose,
+                              GPoint *aPoints)
+{
 
    GPoint dawnPoint;
    GPoint duskPoint;
+   ScreenEdge dawnEdge;
+   ScreenEdge duskEdge;
 
-   //  Update dawn / dusk points to reflect zenith at present location / date.
-   //  We are computing coords of the proper points on the hour mark dial for
-   //  each of dawn and dusk times for the given zenith: these are relative
-   //  to the dial's center hub.
+   //  Find coords of the proper points on the screen edge for each of dawn
+   //  and dusk times: these are relative to the dial's center hub.
 
-   if ((! find_time_path_point(fDawnTime, &dawnPoint)) ||
-       (! find_time_path_point(fDuskTime, &duskPoint)))
+   if ((! find_time_path_point(pBand->sDawnMinute, &dawnPoint, &dawnEdge)) ||
+       (! find_time_path_point(pBand->sDuskMinute, &duskPoint, &duskEdge)))
    {
       //  this twilight path's zenith doesn't apply at this location / date
-      return;
+      return 0;
    }
 
-   //  Number of path points varies with latitude: we only include display
-   //  corner points when dawntime / dusktime values are themselves to the
-   //  left or right of the 45 degree lines into said corners.
-   //  Point order also varies depending on toEnclose (see aPathPoints
-   //  declaration comment in header).
+   //  Number of path points varies with latitude: we include just the display
+   //  corners passed when going clockwise from the path's first edge point to
+   //  its second.  Point order also varies depending on toEnclose (see
+   //  aScratchPoints declaration comment), but in both cases the walk is
+   //  clockwise: dawn round through noon to dusk for the top of the screen,
+   //  dusk round through midnight to dawn for the bottom.
 
-   pTwilightPath->aPathPoints[0] = GPoint(0, 0);    // always center hub
+   aPoints[0] = GPoint(0, 0);    // always center hub
 
    ///  Next point to write in array.
    int iPt = 1;
 
-#ifdef PBL_PLATFORM_APLITE
-   if (pTwilightPath->toEnclose != ENCLOSE_SCREEN_TOP)
+   if (toEnclose != ENCLOSE_SCREEN_TOP)
    {
       //  path encloses bottom part of screen
-      pTwilightPath->aPathPoints[iPt++] = duskPoint;
-      if (fDuskTime < 15)
-      {
-         //  fill to upper right corner
-         pTwilightPath->aPathPoints[iPt++] = GPoint(X_RIGHT, Y_TOP);
-      }
-      if (fDuskTime < 21)
-      {
-         //  fill to lower right corner
-         pTwilightPath->aPathPoints[iPt++] = GPoint(X_RIGHT, Y_BOTTOM);
-      }
-      if (fDawnTime > 3)
-      {
-         //  fill to lower left corner
-         pTwilightPath->aPathPoints[iPt++] = GPoint(X_LEFT, Y_BOTTOM);
-      }
-      if (fDawnTime > 9)
-      {
-         //  fill to upper left corner
-         pTwilightPath->aPathPoints[iPt++] = GPoint(X_LEFT, Y_TOP);
-      }
-      pTwilightPath->aPathPoints[iPt++] = dawnPoint;
+      aPoints[iPt++] = duskPoint;
+      iPt = add_corners_clockwise(aPoints, iPt, duskPoint, duskEdge, dawnPoint, dawnEdge);
+      aPoints[iPt++] = dawnPoint;
    }
    else
-#endif
    {
       //  path encloses top part of screen
-      pTwilightPath->aPathPoints[iPt++] = dawnPoint;
-
-      //  sometimes dawn might fall before midnight:
-      if ((fDawnTime < 3) || (fDawnTime > 21))
-      {
-         //  fill to lower left corner
-         pTwilightPath->aPathPoints[iPt++] = GPoint(X_LEFT, Y_BOTTOM);
-      }
-      if (fDawnTime < 9)
-      {
-         //  fill to upper left corner
-         pTwilightPath->aPathPoints[iPt++] = GPoint(X_LEFT, Y_TOP);
-      }
-      if (fDuskTime > 15)
-      {
-         //  fill to upper right corner
-         pTwilightPath->aPathPoints[iPt++] = GPoint(X_RIGHT, Y_TOP);
-      }
-
-      //  sometimes dusk might fall after midnight:
-      if ((fDuskTime > 21) || (fDuskTime < 3))
-      {
-         //  fill to lower right corner
-         pTwilightPath->aPathPoints[iPt++] = GPoint(X_RIGHT, Y_BOTTOM);
-      }
-      pTwilightPath->aPathPoints[iPt++] = duskPoint;
+      aPoints[iPt++] = dawnPoint;
+      iPt = add_corners_clockwise(aPoints, iPt, dawnPoint, dawnEdge, duskPoint, duskEdge);
+      aPoints[iPt++] = duskPoint;
    }
 
-   //  path descriptor, which is constant for life of this TwilightPath instance.
-   pTwilightPath->pathInfo.num_points = iPt;
-   pTwilightPath->pathInfo.points = pTwilightPath->aPathPoints;
+   return iPt;
+
+}  /* end of build_band_points() */
+
+#endif  // #ifndef PBL_ROUND
 
-   //  (Actual GPath creation is done in twilight_path_render().)
+
+void  twilight_path_compute_current(const TwilightPath *pTwilightPath,
+                                    struct tm * localTime, TwilightBand *pBand)
+{
+
+
+   //  Find time of day for dawn and dusk times.  Results are expressed
+   //  as local hour-of-day, with minutes as fraction of an hour.
+   float fDawnTime;
+   float fDuskTime;
+   calcRiseAndSet(&fDawnTime, &fDuskTime, localTime, pTwilightPath->fZenith);
+
+   //  save dawn / dusk times: everything past here is integer minutes
+   pBand->sDawnMinute = hours_to_minute_of_day(fDawnTime);
+   pBand->sDuskMinute = hours_to_minute_of_day(fDuskTime);
+
+   //  (The path's points are generated from these in twilight_path_render().)
 
    return;
 
 }  /* end of twilight_path_compute_current */
 
 
-void  twilight_path_render(TwilightPath *pTwilightPath, GContext *ctx,
-                           GColor color, GRect frameDst)
+#ifdef PBL_ROUND
+
+/**
+ *  Angle of a minute of day on our dial, in the form graphics_fill_radial()
+ *  uses: clockwise from 12 o'clock, which is noon on our 24 hour dial.
+ */
+static int32_t  minute_to_radial_angle(int localMinute)
 {
 
+   return ((localMinute + MINUTES_PER_DAY / 2) % MINUTES_PER_DAY) *
+          TRIG_MAX_ANGLE / MINUTES_PER_DAY;
+
+}  /* end of minute_to_radial_angle() */
 
-   //  Recreate path each time.  Not sure if this is strictly necessary
-   //  but it would probably not be good to apply gpath_move_to() more
-   //  than once for the same path instance.
-   if (pTwilightPath->pPath != NULL)
-      gpath_destroy(pTwilightPath->pPath);
 
-   if ((pTwilightPath->fDawnTime == NO_RISE_SET_TIME) ||
-       (pTwilightPath->fDuskTime == NO_RISE_SET_TIME))
+void  twilight_path_render(TwilightPath *pTwilightPath, const TwilightBand *pBand,
+                           GContext *ctx, GColor color, GRect frameDst)
+{
+
+   if ((pBand->sDawnMinute == NO_RISE_SET_MINUTE) ||
+       (pBand->sDuskMinute == NO_RISE_SET_MINUTE))
    {
       //  sun either never sets or never rises at this location / time.
       //  For now, simply render nothing.
-      pTwilightPath->pPath = 0;
       return;
    }
 
-   pTwilightPath->pPath = gpath_create(&(pTwilightPath->pathInfo));
-   if (pTwilightPath->pPath == NULL)
-      return;
+   //  On the round display a band is just a sector of the dial, from dawn
+   //  clockwise through noon to dusk.  Filling only the dial proper (not the
+   //  whole screen) leaves nothing for the dial mask to cover but its ring.
+   GRect  dialRect = twilight_path_dial_rect(frameDst);
+
+   int32_t angleStart = minute_to_radial_angle(pBand->sDawnMinute);
+   int32_t angleEnd   = minute_to_radial_angle(pBand->sDuskMinute);
+
+   graphics_context_set_fill_color(ctx, color);
+
+   if (angleEnd >= angleStart)
+   {
+      graphics_fill_radial(ctx, dialRect, GOvalScaleModeFitCircle, USABLE_FACE_RADIUS,
+                           angleStart, angleEnd);
+   }
+   else
+   {
+      //  band runs through 12 o'clock (noon): split it there
+      graphics_fill_radial(ctx, dialRect, GOvalScaleModeFitCircle, USABLE_FACE_RADIUS,
+                           angleStart, TRIG_MAX_ANGLE);
+      graphics_fill_radial(ctx, dialRect, GOvalScaleModeFitCircle, USABLE_FACE_RADIUS,
+                           0, angleEnd);
+   }
+
+}  /* end of twilight_path_render */
+
+
+GRect  twilight_path_dial_rect(GRect frameDst)
+{
 
    GPoint  centerPoint = grect_center_point(&frameDst);
    centerPoint.y += FACE_VOFFSET;
 
-   gpath_move_to(pTwilightPath->pPath, centerPoint);
+   return GRect(centerPoint.x - USABLE_FACE_RADIUS, centerPoint.y - USABLE_FACE_RADIUS,
+                2 * USABLE_FACE_RADIUS, 2 * USABLE_FACE_RADIUS);
 
-   //  do rendering
+}  /* end of twilight_path_dial_rect() */
 
-   if (pTwilightPath->pBmpGrey != NULL)
+#else  // #ifdef PBL_ROUND
+
+void  twilight_path_render(TwilightPath *pTwilightPath, const TwilightBand *pBand,
+                           GContext *ctx, GColor color, GRect frameDst)
+{
+
+
+   if ((pBand->sDawnMinute == NO_RISE_SET_MINUTE) ||
+       (pBand->sDuskMinute == NO_RISE_SET_MINUTE))
    {
-      graphics_context_set_compositing_mode(ctx, GCompOpAnd); 
-      graphics_draw_bitmap_in_rect(ctx, pTwilightPath->pBmpGrey, frameDst);
+      //  sun either never sets or never rises at this location / time.
+      //  For now, simply render nothing.
+      return;
    }
 
-   graphics_context_set_fill_color(ctx, color);
-   if ((pTwilightPath != NULL) && (pTwilightPath->pPath != NULL))
+   GPoint  centerPoint = grect_center_point(&frameDst);
+   centerPoint.y += FACE_VOFFSET;
+
+#ifdef PBL_PLATFORM_APLITE
+   ScreenPartToEnclose toEnclose = pTwilightPath->toEnclose;
+
+   if (pTwilightPath->greyShade != DITHER_NONE)
    {
-      gpath_draw_filled(ctx, pTwilightPath->pPath); 
+      //  grey the rest of the screen: the same dawn / dusk points, enclosing
+      //  the other part
+      int cOther = build_band_points(pBand, (toEnclose == ENCLOSE_SCREEN_TOP) ? ENCLOSE_SCREEN_BOTTOM
+                                                                             : ENCLOSE_SCREEN_TOP,
+                                     aScratchPoints);
+      dither_fill_polygon(ctx, aScratchPoints, cOther, centerPoint, pTwilightPath->greyShade);
    }
+#else
+   ScreenPartToEnclose toEnclose = ENCLOSE_SCREEN_TOP;
+#endif
+
+   //  Generate the band's path into the shared scratch path, rather than
+   //  gpath_create() one per frame or keep points for every band.
+   GPathInfo  pathInfo = { build_band_points(pBand, toEnclose, aScratchPoints),
+                           aScratchPoints };
+
+   if (pathInfo.num_points == 0)
+   {
+      return;
+   }
+
+   scratchPath = gpath_from_info(&pathInfo);
+
+   gpath_move_to(&scratchPath, centerPoint);
+
+   graphics_context_set_fill_color(ctx, color);
+   gpath_draw_filled(ctx, &scratchPath);
 
 }  /* end of twilight_path_render */
 
+#endif  // #ifdef PBL_ROUND
+
 
 void  twilight_path_destroy(TwilightPath *pTwilightPath)
 {
 
    if (pTwilightPath != 0)
    {
-      SAFE_DESTROY(gpath, pTwilightPath->pPath);
-      SAFE_DESTROY(gbitmap, pTwilightPath->pBmpGrey);
-
-      free(pTwilightPath);
+      arena_free(pTwilightPath);
    }
 
    return;
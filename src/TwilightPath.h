@@ -7,6 +7,8 @@
 
 #include  "pebble.h"
 
+#include  "dither_fill.h"
+
 
 ///  Should created path enclose top or bottom of screen?
 typedef enum {
@@ -18,8 +20,40 @@ typedef enum {
 ///  Dawn & dusk intercepts, up to four "corners" plus center point.
 #define  POINTS_IN_TWILIGHT_PATH   7
 
-///  For when a platform / function has no resource to supply.
-#define  INVALID_RESOURCE   ((unsigned) -1)
+///  Minutes in our 24 hour dial.
+#define  MINUTES_PER_DAY    (24 * 60)
+
+/**
+ *  Minute-of-day value meaning "no such dawn / dusk": the sun never reaches
+ *  this path's zenith at the current location / date.
+ */
+#define  NO_RISE_SET_MINUTE  ((int16_t) -1)
+
+
+/**
+ *  One day's worth of a twilight path: just its dawn / dusk times.  The
+ *  polygon filling its part of the screen follows from those, and is only
+ *  generated when drawing.  Produced by twilight_path_compute_current(),
+ *  consumed by twilight_path_render(); kept apart from TwilightPath so that
+ *  a whole day's bands can be computed ahead of time and held elsewhere.
+ */
+typedef struct {
+
+   /**
+    *  Local minute of day (0 .. 1439) of the path's zenith "dawn" at our
+    *  current location, for the date supplied to twilight_path_compute_current().
+    *  NO_RISE_SET_MINUTE if there is none.
+    */
+   int16_t  sDawnMinute;
+
+   /**
+    *  Local minute of day (0 .. 1439) of the path's zenith "dusk" at our
+    *  current location, for the date supplied to twilight_path_compute_current().
+    *  NO_RISE_SET_MINUTE if there is none.
+    */
+   int16_t  sDuskMinute;
+
+} TwilightBand;
 
 
 /** 
@@ -34,58 +68,23 @@ typedef enum {
  *  to encompass all of the watch screen above or below the zenith lines.
  *  
  *  The zenith line endpoints are calculated using the presently known
- *  user location, and the current date.
+ *  user location, and a given date, into a TwilightBand.  The path's points
+ *  are generated from the band at render time, into a buffer shared by all
+ *  instances (one band is drawn at a time).
+ *  
+ *  Path coords are relative, using as a zero-point the axis of the hour
+ *  hand's rotation.
  *  
- *  Our computed path coords are relative, using as a zero-point the axis
- *  of the hour hand's rotation.
+ *  On aplite, a path may also have a grey shade.  When present, everything
+ *  outside the path (i.e. the path through the same dawn / dusk points
+ *  enclosing the other part of the screen) is dithered to that shade
+ *  immediately before we fill our path.
  *  
- *  This structure also includes an optional bitmap resource.  When
- *  present, the bitmap is rendered immediately before we fill our path.
- *  When a bitmap is present, our path fill typically is used to carve out
- *  part of the bitmap (which can only be rendered to a rectangle) and
- *  change it back to white.
+ *  On the round display there is no path as such: the band is drawn as a
+ *  sector of the dial straight from the dawn / dusk times.
  */
 typedef struct {
 
-   /**
-    *  Collection of points comprising our path.  We don't explicitly close
-    *  the path, but PebbleOS seems to infer that.
-    *  
-    *  NOTE: sample file
-    *  
-    *    PebbleSDK-2.0-BETA4/Examples/watchapps/feature_gpath/src/feature_gpath.c
-    *  
-    *  includes this comment:
-    *  
-    *    A path can be concave, but it should not twist on itself
-    *    The points should be defined in clockwise order due to the rendering
-    *    implementation. Counter-clockwise will work in older firmwares, but
-    *    it is not officially supported
-    *  
-    *  So we change the ordering of our computed points depending on whether
-    *  the path is to enclose the top or bottom of the screen, to ensure that
-    *  our path goes in a clockwise direction.
-    */
-   GPoint aPathPoints[POINTS_IN_TWILIGHT_PATH];
-
-   ///  Descriptor pointing to aPathPoints, used to create a GPath.
-   GPathInfo pathInfo;
-
-   ///  Derived from the above, and ready for use with Pebble graphics primitives.
-   GPath *pPath;
-
-   /**
-    *  Bitmap resource to render to screen immediately before path fill.
-    *  NULL if there is no bitmap to render (i.e., for our initial
-    *  black-fill of the bottom part of the screen).
-    *  Non-null only for aplite platforms.
-    */
-   GBitmap* pBmpGrey;   // some shade of gray
-
-   /**
-    *  Color value used to fill within twilight path.
-    */
-
    /**
     *  Zenith value for our path.  This is the angle between the sun's zenith
     *  position ("high noon") and the position our twilight path represents.
@@ -95,27 +94,20 @@ typedef struct {
 #ifdef PBL_PLATFORM_APLITE
    ///  Does our path enclose the top or bottom part of the screen?
    ScreenPartToEnclose toEnclose;
-#endif
-
-   ///  For convenience, preserve the dawn and dusk times which we compute.
 
    /**
-    *  Local time (hour plus fraction) of fZenith's "dawn" at our current
-    *  location, for the date supplied to twilight_path_compute_current().
+    *  Shade to dither the rest of the screen to, immediately before path
+    *  fill.  DITHER_NONE for none (i.e., for our initial black-fill of the
+    *  bottom part of the screen).
     */
-   float  fDawnTime;
-
-   /**
-    *  Local time (hour plus fraction) of fZenith's "dusk" at our current
-    *  location, for the date supplied to twilight_path_compute_current().
-    */
-   float  fDuskTime;
+   DitherShade  greyShade;
+#endif
 
 } TwilightPath;
 
 #ifdef PBL_PLATFORM_APLITE
 
-//  Non-night colors are base for bitmap filling on top of.
+//  Non-night colors are base for dithering on top of.
 #define  TWI_COLOR_NIGHT      GColorBlack
 #define  TWI_COLOR_ASTRO      GColorBlack
 #define  TWI_COLOR_NAUTICAL   GColorWhite
@@ -134,61 +126,69 @@ typedef struct {
 
 //  Simplify parameter passage into twilight_path_create().
 #ifdef PBL_PLATFORM_APLITE
-#define TWI_APLITE_RES_ONLY(bitmap_id)  bitmap_id
+#define TWI_APLITE_SHADE_ONLY(shade)  shade
 #else
-#define TWI_APLITE_RES_ONLY(bitmap_id)  INVALID_RESOURCE
+#define TWI_APLITE_SHADE_ONLY(shade)  DITHER_NONE
 #endif
 
 /**
  *  Allocate a TwilightPath instance, save the supplied parameters in it,
  *  and pre-populate as much "static" data in the instance as possible.
  *  
- *  To be usable, the returned TwilightPath instance must first be passed to
- *  \ref twilight_path_compute_current().
+ *  To be rendered, the returned TwilightPath instance needs a TwilightBand
+ *  from \ref twilight_path_compute_current().
  * 
  *  @param zenithAngle Angle in degrees of sun position relative to zenith
  *             which we should use in calculating our graphics path.
  *  @param toEnclose Should graphics path enclose top or bottom of screen?
- *  @param bitmapResId Aplite:  Resource ID of bitmap to use when rendering.
- *                         Set to INVALID_RESOURCE for no bitmap.
- *                     Basalt:  Color value to fill with (no bitmap used!).
+ *  @param greyShade Aplite:  Shade to dither the rest of the screen to when
+ *                         rendering, or DITHER_NONE.
+ *                     Basalt / chalk:  DITHER_NONE (color is given at render).
  */
 TwilightPath * twilight_path_create(float zenithAngle, ScreenPartToEnclose toEnclose,
-                                    uint32_t greyBitmapResourceId);
+                                    DitherShade greyShade);
 
 
 /**
  *  Compute dawn / dusk times for supplied twilight path instance, using given
  *  date and current (most recently read from phone) location values to
  *  complete the calculations.
- *  
- *  With the dawn / dusk times in hand, create a graphics path showing those
- *  times and enclosing either top or bottom of the watch screen, as requested
- *  when twilight_path_create() was called to create this instance.
  * 
- *  @param pTwilightPath Twilight path instance to update for present location/date.
- *  @param utcTime UTC time to compute dawn / dusk for.
+ *  @param pTwilightPath Twilight path instance to compute for.
+ *  @param localTime Local date to compute dawn / dusk for.
+ *  @param pBand Receives dawn / dusk times.
  */
-void  twilight_path_compute_current(TwilightPath *pTwilightPath,
-                                    struct tm * localTime);
+void  twilight_path_compute_current(const TwilightPath *pTwilightPath,
+                                    struct tm * localTime, TwilightBand *pBand);
 
 
 /**
- *  Render optional bitmap (specified during _create()) to full screen using
- *  GCompAnd compositing, and then fill our path with the specified color.
- *  Thus we write the bitmap and then carve out a chunk of it corresponding
- *  to the "daytime" part beyond our twilight range.
+ *  Dither the screen outside our path to the optional grey shade (specified
+ *  during _create()), and then fill our path with the specified color.
+ *  Thus the grey covers the part of the screen up to our twilight range,
+ *  and the fill the "daytime" part beyond it.
  * 
- *  @param pTwilightPath Contains path info for filling.
- *  @param ctx Graphics context to render to.  Iff we are supplied a bitmap
- *              then we change the context's compositing mode to GCompAnd.
+ *  @param pTwilightPath Path to render.
+ *  @param pBand Day's dawn / dusk times, from twilight_path_compute_current().
+ *  @param ctx Graphics context to render to.
  *  @param color Color to fill our path with.
  *  @param frameDst Frame to constrain rendering to.  We expect this to be the
  *             entire display, so we apply our dial's vertical offset when
  *             centering the twilight hub.
  */
-void  twilight_path_render(TwilightPath *pTwilightPath, GContext *ctx,
-                           GColor color, GRect frameDst);
+void  twilight_path_render(TwilightPath *pTwilightPath, const TwilightBand *pBand,
+                           GContext *ctx, GColor color, GRect frameDst);
+
+
+#ifdef PBL_ROUND
+/**
+ *  Square enclosing the dial proper (inside the dial ring), i.e. the area
+ *  that twilight_path_render() fills sectors of.
+ *
+ *  @param frameDst Frame as passed to twilight_path_render().
+ */
+GRect  twilight_path_dial_rect(GRect frameDst);
+#endif
 
 
 void  twilight_path_destroy(TwilightPath *pTwilightPath);
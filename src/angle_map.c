@@ -0,0 +1,399 @@
+/**
+ *  @file
+ *
+ *  Per-pixel (per-tile on aplite) dial angle map, for rendering twilight
+ *  bands without path fills.
+ *
+ *  Which band a pixel shows depends only on its angle around the dial hub,
+ *  and on a fixed-size display that never changes.  So at start-up we store
+ *  each pixel's angle, quantised to ANGLE_MAP_STEPS steps per day, and once
+ *  a day we build a table giving the color (or, on aplite, the fill pattern)
+ *  of each step from the twilight paths' dawn / dusk minutes.  Rendering is
+ *  then one table lookup per pixel, written straight into the frame buffer.
+ *
+ *  Memory: basalt and chalk keep one byte for every pixel inside the dial
+ *  proper, using dial_spans to skip the rest (about 15.4K on basalt, 23.2K
+ *  on chalk).  Aplite's heap can't spare that, so it uses one byte per
+ *  4 x 4 tile of the whole screen (1.5K); tiles line up with the 4 x 4
+ *  grey dither patterns, so dithering is unaffected and band edges just get
+ *  coarser.
+ *
+ *  Only built when ANGLE_MAP_RENDER is set in config.h.
+ */
+
+
+#include "pebble.h"
+
+#include "angle_map.h"
+#include "config.h"
+#include "dial_spans.h"
+#include "dither_fill.h"
+#include "geometry.h"
+
+
+#if ANGLE_MAP_RENDER
+
+
+///  Most paths angle_map_set_bands() can handle.
+#define  MAX_BAND_PATHS   4
+
+///  Screen size, in tiles.
+#define  TILES_X  (DISP_WIDTH  / ANGLE_MAP_TILE)
+#define  TILES_Y  (DISP_HEIGHT / ANGLE_MAP_TILE)
+
+
+///  Angle step of each dial pixel / screen tile, in rendering order.
+static uint8_t * pAngleMap = NULL;
+
+///  Bytes allocated for pAngleMap.
+static size_t  cbAngleMap = 0;
+
+
+#ifdef PBL_COLOR
+
+///  Color (GColor8.argb) of each angle step, for the current day.
+static uint8_t  aStepColor[ANGLE_MAP_STEPS];
+
+#else
+
+/**
+ *  Band class of each angle step, for the current day: bit i set when the
+ *  step falls inside path i.
+ */
+static uint8_t  aStepClass[ANGLE_MAP_STEPS];
+
+///  Fill pattern for each band class: 4 rows of 32 pixels, LSB leftmost.
+static uint32_t  aClassPattern[1 << MAX_BAND_PATHS][ANGLE_MAP_TILE];
+
+#endif
+
+
+/**
+ *  Angle step of a point, given as twice its offset from the hub so that
+ *  tile centers can be expressed in integers.
+ */
+static uint8_t  angle_step_of(int dx2, int dy2)
+{
+
+   //  Trig angle 0 is 18:00 on our dial, so step 0 (midnight) is a quarter
+   //  turn back from it.
+   int32_t trigAngle = atan2_lookup((int16_t) dy2, (int16_t) dx2);
+
+   return (uint8_t) ((trigAngle * ANGLE_MAP_STEPS / TRIG_MAX_ANGLE) - ANGLE_MAP_STEPS / 4);
+
+}  /* end of angle_step_of() */
+
+
+bool  angle_map_create(void)
+{
+
+   if (pAngleMap != NULL)
+   {
+      return true;
+   }
+
+#ifdef PBL_COLOR
+
+   //  size it to hold only pixels inside the dial proper
+   cbAngleMap = 0;
+   for (int y = 0;  y < DISP_HEIGHT;  y++)
+   {
+      int16_t x0, x1;
+
+      if (dial_spans_get_row(y, &x0, &x1))
+      {
+         cbAngleMap += x1 - x0 + 1;
+      }
+   }
+
+   pAngleMap = malloc(cbAngleMap);
+   if (pAngleMap == NULL)
+   {
+      cbAngleMap = 0;
+      return false;
+   }
+
+   uint8_t * pStep = pAngleMap;
+
+   for (int y = 0;  y < DISP_HEIGHT;  y++)
+   {
+      int16_t x0, x1;
+
+      if (! dial_spans_get_row(y, &x0, &x1))
+      {
+         continue;
+      }
+
+      for (int x = x0;  x <= x1;  x++)
+      {
+         *pStep++ = angle_step_of(2 * (x - FACE_CENTER_X), 2 * (y - FACE_CENTER_Y));
+      }
+   }
+
+#else
+
+   cbAngleMap = TILES_X * TILES_Y;
+
+   pAngleMap = malloc(cbAngleMap);
+   if (pAngleMap == NULL)
+   {
+      cbAngleMap = 0;
+      return false;
+   }
+
+   uint8_t * pStep = pAngleMap;
+
+   for (int ty = 0;  ty < TILES_Y;  ty++)
+   {
+      for (int tx = 0;  tx < TILES_X;  tx++)
+      {
+         //  (doubled) offset of tile center from hub
+         *pStep++ = angle_step_of(2 * (tx * ANGLE_MAP_TILE - FACE_CENTER_X) + ANGLE_MAP_TILE - 1,
+                                  2 * (ty * ANGLE_MAP_TILE - FACE_CENTER_Y) + ANGLE_MAP_TILE - 1);
+      }
+   }
+
+#endif
+
+   return true;
+
+}  /* end of angle_map_create() */
+
+
+void  angle_map_destroy(void)
+{
+
+   if (pAngleMap != NULL)
+   {
+      free(pAngleMap);
+      pAngleMap = NULL;
+      cbAngleMap = 0;
+   }
+
+}  /* end of angle_map_destroy() */
+
+
+bool  angle_map_exists(void)
+{
+   return (pAngleMap != NULL);
+}
+
+
+size_t  angle_map_get_size(void)
+{
+   return cbAngleMap;
+}
+
+
+/**
+ *  Does a minute of day fall on the clockwise arc from one minute to another
+ *  (both ends included)?
+ */
+static bool  minute_in_arc(int minute, int fromMinute, int toMinute)
+{
+
+   return (((minute   - fromMinute + MINUTES_PER_DAY) % MINUTES_PER_DAY) <=
+           ((toMinute - fromMinute + MINUTES_PER_DAY) % MINUTES_PER_DAY));
+
+}  /* end of minute_in_arc() */
+
+
+/**
+ *  Does an angle step fall inside the screen region a twilight path fills?
+ *  Paths with no dawn / dusk today fill nothing, as with path rendering.
+ */
+static bool  step_in_path(int step, const TwilightPath *pPath, const TwilightBand *pBand)
+{
+
+   if ((pBand->sDawnMinute == NO_RISE_SET_MINUTE) ||
+       (pBand->sDuskMinute == NO_RISE_SET_MINUTE))
+   {
+      return false;
+   }
+
+   //  classify each step by the minute at its middle
+   int minute = (2 * step + 1) * MINUTES_PER_DAY / (2 * ANGLE_MAP_STEPS);
+
+#ifdef PBL_PLATFORM_APLITE
+   if (pPath->toEnclose != ENCLOSE_SCREEN_TOP)
+   {
+      return minute_in_arc(minute, pBand->sDuskMinute, pBand->sDawnMinute);
+   }
+#else
+   (void) pPath;
+#endif
+
+   return minute_in_arc(minute, pBand->sDawnMinute, pBand->sDuskMinute);
+
+}  /* end of step_in_path() */
+
+
+#ifndef PBL_COLOR
+
+/**
+ *  One row of a path's grey dither pattern, as 32 pixels LSB leftmost; or
+ *  all white when the path has no shade.
+ */
+static uint32_t  grey_pattern_row(const TwilightPath *pPath, int row)
+{
+   return dither_fill_pattern_row(pPath->greyShade, row) * 0x01010101u;
+}
+
+#endif
+
+
+void  angle_map_set_bands(TwilightPath * const apPaths[], const TwilightBand aBands[],
+                          const GColor aColors[], int nPaths, GColor colorBase)
+{
+
+   if (nPaths > MAX_BAND_PATHS)
+   {
+      nPaths = MAX_BAND_PATHS;
+   }
+
+#ifdef PBL_COLOR
+
+   for (int step = 0;  step < ANGLE_MAP_STEPS;  step++)
+   {
+      GColor color = colorBase;
+
+      for (int iPath = 0;  iPath < nPaths;  iPath++)
+      {
+         if (step_in_path(step, apPaths[iPath], &aBands[iPath]))
+         {
+            color = aColors[iPath];
+         }
+      }
+
+      aStepColor[step] = color.argb;
+   }
+
+#else
+
+   for (int step = 0;  step < ANGLE_MAP_STEPS;  step++)
+   {
+      uint8_t bandClass = 0;
+
+      for (int iPath = 0;  iPath < nPaths;  iPath++)
+      {
+         if (step_in_path(step, apPaths[iPath], &aBands[iPath]))
+         {
+            bandClass |= (1 << iPath);
+         }
+      }
+
+      aStepClass[step] = bandClass;
+   }
+
+   //  Replay the path renderer's painting for each class: AND in the path's
+   //  grey shade, then fill with its color if the class is inside the path.
+   for (int bandClass = 0;  bandClass < (1 << MAX_BAND_PATHS);  bandClass++)
+   {
+      for (int row = 0;  row < ANGLE_MAP_TILE;  row++)
+      {
+         uint32_t pattern = gcolor_equal(colorBase, GColorWhite) ? 0xFFFFFFFF : 0;
+
+         for (int iPath = 0;  iPath < nPaths;  iPath++)
+         {
+            const TwilightPath * pPath = apPaths[iPath];
+
+            if ((aBands[iPath].sDawnMinute == NO_RISE_SET_MINUTE) ||
+                (aBands[iPath].sDuskMinute == NO_RISE_SET_MINUTE))
+            {
+               //  path renderer draws neither bitmap nor fill
+               continue;
+            }
+
+            pattern &= grey_pattern_row(pPath, row);
+
+            if (bandClass & (1 << iPath))
+            {
+               pattern = gcolor_equal(aColors[iPath], GColorWhite) ? 0xFFFFFFFF : 0;
+            }
+         }
+
+         aClassPattern[bandClass][row] = pattern;
+      }
+   }
+
+#endif
+
+}  /* end of angle_map_set_bands() */
+
+
+void  angle_map_render(GContext *ctx)
+{
+
+   if (pAngleMap == NULL)
+   {
+      return;
+   }
+
+   GBitmap * pFrameBuffer = graphics_capture_frame_buffer(ctx);
+
+   if (pFrameBuffer == NULL)
+   {
+      return;
+   }
+
+   const uint8_t * pStep = pAngleMap;
+
+#ifdef PBL_COLOR
+
+   for (int y = 0;  y < DISP_HEIGHT;  y++)
+   {
+      int16_t x0, x1;
+
+      if (! dial_spans_get_row(y, &x0, &x1))
+      {
+         continue;
+      }
+
+      GBitmapDataRowInfo  row = gbitmap_get_data_row_info(pFrameBuffer, y);
+
+      //  clip span to the row's frame buffer memory (matters on chalk only)
+      int  xStart = (x0 < row.min_x) ? row.min_x : x0;
+      int  xEnd   = (x1 > row.max_x) ? row.max_x : x1;
+
+      const uint8_t * pRowStep = pStep + (xStart - x0);
+
+      for (int x = xStart;  x <= xEnd;  x++)
+      {
+         row.data[x] = aStepColor[*pRowStep++];
+      }
+
+      pStep += x1 - x0 + 1;
+   }
+
+#else
+
+   uint8_t * pData = gbitmap_get_data(pFrameBuffer);
+   uint16_t  cbRow = gbitmap_get_bytes_per_row(pFrameBuffer);
+
+   for (int ty = 0;  ty < TILES_Y;  ty++, pStep += TILES_X)
+   {
+      for (int row = 0;  row < ANGLE_MAP_TILE;  row++)
+      {
+         uint8_t * pDst = pData + (ty * ANGLE_MAP_TILE + row) * cbRow;
+
+         //  each frame buffer byte holds two tiles' worth of pixels
+         for (int tx = 0;  tx < TILES_X;  tx += 2)
+         {
+            uint32_t left  = aClassPattern[aStepClass[pStep[tx]]][row];
+            uint32_t right = aClassPattern[aStepClass[pStep[tx + 1]]][row];
+            int      shift = (tx * ANGLE_MAP_TILE) & 31;
+
+            *pDst++ = (uint8_t) (((left  >> shift)       & 0x0F) |
+                                 ((right >> (shift + 4)) & 0x0F) << 4);
+         }
+      }
+   }
+
+#endif
+
+   graphics_release_frame_buffer(ctx, pFrameBuffer);
+
+}  /* end of angle_map_render() */
+
+
+#endif  // #if ANGLE_MAP_RENDER
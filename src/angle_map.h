@@ -0,0 +1,74 @@
+/**
+ *  @file
+ *
+ *  Precomputed map of each dial pixel's (or, on aplite, each 4 x 4 tile's)
+ *  angle around the dial hub, expressed as a fraction of the day.  With it,
+ *  twilight bands can be rendered by looking up each pixel's angle in a
+ *  small per-day band table instead of filling one path per band.
+ */
+
+
+#ifndef sunclock_angle_map_h__
+#define sunclock_angle_map_h__
+
+
+#include "pebble.h"
+
+#include "TwilightPath.h"
+
+
+/**
+ *  Steps per day in the map's angle values: one byte per pixel, so each
+ *  step is 1440 / 256 == 5.625 minutes, about 1.7 pixels of arc at the
+ *  edge of the basalt dial.
+ */
+#define  ANGLE_MAP_STEPS   256
+
+///  Side of square screen tile sharing one map entry.
+#ifdef PBL_PLATFORM_APLITE
+# define ANGLE_MAP_TILE    4
+#else
+# define ANGLE_MAP_TILE    1
+#endif
+
+
+/**
+ *  Allocate and fill the angle map for this platform.
+ *
+ *  @return \c false if there is insufficient heap, in which case the
+ *          caller should fall back to path rendering.
+ */
+bool  angle_map_create(void);
+
+void  angle_map_destroy(void);
+
+///  Is there a map available to angle_map_render()?
+bool  angle_map_exists(void);
+
+///  Heap bytes held by the map.
+size_t  angle_map_get_size(void);
+
+/**
+ *  Build the per-day band table from a day's twilight bands.
+ *  The paths are given in the order that the path renderer paints them,
+ *  each with the color it fills with, so that later paths win; aplite also
+ *  honours each path's grey bitmap and top / bottom enclosure.
+ *
+ *  @param apPaths Twilight paths, in painting order.
+ *  @param aBands Day's dawn / dusk times for each path.
+ *  @param aColors Fill color for each path.
+ *  @param nPaths Entries in apPaths and aColors.
+ *  @param colorBase Color of dial before any path is painted.
+ */
+void  angle_map_set_bands(TwilightPath * const apPaths[], const TwilightBand aBands[],
+                          const GColor aColors[], int nPaths, GColor colorBase);
+
+/**
+ *  Write the twilight bands straight into the frame buffer.  On color
+ *  platforms only pixels inside the dial are written (the dial mask covers
+ *  the rest); on aplite the whole screen is.
+ */
+void  angle_map_render(GContext *ctx);
+
+
+#endif  // #ifndef sunclock_angle_map_h__
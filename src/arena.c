@@ -0,0 +1,109 @@
+/**
+ *  @file
+ *
+ *  Window-lifetime bump allocator: see arena.h.
+ */
+
+
+#include "pebble.h"
+
+#include "arena.h"
+
+#include "platform.h"
+
+
+static uint8_t * pArena = NULL;
+
+static size_t  cbArena = 0;
+
+///  Bytes handed out so far: the next allocation starts here.
+static size_t  cbArenaUsed = 0;
+
+static unsigned  cFallbacks = 0;
+
+
+bool  arena_create(size_t cbSize)
+{
+
+   arena_destroy();
+
+   pArena = malloc(cbSize);
+   if (pArena == NULL)
+   {
+      return false;
+   }
+
+   cbArena = cbSize;
+
+   return true;
+
+}  /* end of arena_create() */
+
+
+void  arena_destroy(void)
+{
+
+   if (pArena != NULL)
+   {
+      free(pArena);
+      pArena = NULL;
+   }
+
+   cbArena     = 0;
+   cbArenaUsed = 0;
+   cFallbacks  = 0;
+
+}  /* end of arena_destroy() */
+
+
+void *  arena_alloc(size_t cb)
+{
+
+   cb = (cb + 3) & ~((size_t) 3);
+
+   if ((pArena != NULL) && (cbArenaUsed + cb <= cbArena))
+   {
+      void * p = pArena + cbArenaUsed;
+
+      cbArenaUsed += cb;
+      return p;
+   }
+
+   MY_APP_LOG(APP_LOG_LEVEL_WARNING, "arena full: %u byte allocation from heap", (unsigned) cb);
+   cFallbacks++;
+
+   return malloc(cb);
+
+}  /* end of arena_alloc() */
+
+
+void  arena_free(void *p)
+{
+
+   if ((pArena != NULL) && ((uint8_t *) p >= pArena) && ((uint8_t *) p < pArena + cbArena))
+   {
+      //  goes with the arena
+      return;
+   }
+
+   free(p);
+
+}  /* end of arena_free() */
+
+
+size_t  arena_get_used(void)
+{
+   return cbArenaUsed;
+}
+
+
+size_t  arena_get_size(void)
+{
+   return cbArena;
+}
+
+
+unsigned  arena_get_fallback_count(void)
+{
+   return cFallbacks;
+}
@@ -0,0 +1,67 @@
+/**
+ *  @file
+ *
+ *  Bump allocator for the watchface's own structures: one heap block sized
+ *  for all of them at window load, released in one go at window unload.
+ *  Rather than a handful of small blocks scattered through the heap
+ *  between the SDK's own (layers, fonts, bitmaps), the face then holds
+ *  one, whose size is known at build time.
+ *
+ *  As built by default that is just the four TwilightPaths (48 bytes);
+ *  aplite adds its hour hand TransRotBmp only with HOUR_HAND_SPRITE_STEPS
+ *  set to 0.  See SUNCLOCK_ARENA_BYTES in sunclock.c.
+ *
+ *  If the arena is missing or full, arena_alloc() falls back to malloc(),
+ *  so callers need not care; arena_free() tells the two apart.
+ */
+
+
+#ifndef sunclock_arena_h__
+#define sunclock_arena_h__
+
+
+#include "pebble.h"
+
+
+///  Bytes of arena taken by an allocation of type T (kept word aligned).
+#define  ARENA_SIZEOF(T)   ((sizeof(T) + 3) & ~((size_t) 3))
+
+
+/**
+ *  Allocate the arena.  Any previous arena is released.
+ *
+ *  @param cbSize Bytes to reserve: sum of ARENA_SIZEOF() of what will
+ *                be allocated.
+ *
+ *  @return \c false if there is not enough heap (arena_alloc() then uses
+ *          malloc() throughout).
+ */
+bool  arena_create(size_t cbSize);
+
+/**
+ *  Release the arena.  Everything allocated from it must already be
+ *  finished with (arena_free()d or not, it makes no difference).
+ */
+void  arena_destroy(void);
+
+/**
+ *  Allocate from the arena, or from the heap if the arena is full.
+ *
+ *  @return NULL only if both are exhausted.
+ */
+void *  arena_alloc(size_t cb);
+
+///  Release an arena_alloc() allocation: a no-op unless it came from malloc().
+void  arena_free(void *p);
+
+///  Bytes of the arena handed out.
+size_t  arena_get_used(void);
+
+///  Bytes reserved by arena_create(), zero if none.
+size_t  arena_get_size(void);
+
+///  Allocations which fell back to malloc() since arena_create().
+unsigned  arena_get_fallback_count(void);
+
+
+#endif  // #ifndef sunclock_arena_h__
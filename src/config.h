@@ -8,3 +8,56 @@
 //NOTE: Change false to true if you want to enable the vibe function
 #define HOUR_VIBRATION false
 
+
+/**
+ *  Set to 1 to render the twilight bands by looking up each pixel's dial
+ *  angle in a precomputed map (see angle_map.c), rather than by filling
+ *  one path per band.  Costs heap: roughly one byte per dial pixel on color
+ *  platforms, one per 4 x 4 tile on aplite.  Falls back to path filling if
+ *  the map can't be allocated.
+ */
+#define ANGLE_MAP_RENDER 0
+
+
+/**
+ *  Set to 1 to keep a run-length encoded copy of the rendered dial (see
+ *  dial_cache.c), so that the per-minute redraws restore it with span fills
+ *  rather than re-rendering bands and mask.  Re-rendered when the day plan
+ *  changes.  Costs a few K of heap at most; if the dial won't encode within
+ *  DIAL_CACHE_MAX_BYTES it is rendered each time, as without the cache.
+ */
+#define DIAL_CACHE_RENDER 1
+
+
+/**
+ *  Set to 1 to draw the large time text from an atlas of its digits and
+ *  colon (see digit_atlas.c), rasterised from the font once, on the first
+ *  frame that has it, rather than laying out and rendering the text through
+ *  the font every frame.  Costs about 1K of heap, so is kept only at the
+ *  quality tier with the dial cache; without it the text is drawn as before.
+ */
+#define DIGIT_ATLAS_RENDER 1
+
+
+/**
+ *  Aplite hour hand: number of angles per revolution at which the hand is
+ *  pre-rendered, as run-length encoded sprites, and then simply blitted
+ *  (see hour_hand_bitmap.c).  Set to 0 to rotate the hand bitmap for every
+ *  frame with RotBitmapLayers instead.
+ *
+ *  The quality / memory trade-off: 144 steps (2.5 degrees, moving the hand
+ *  every 10 minutes on the 24 hour dial, tip within about 1.2 pixels of its
+ *  true position) is close to the per-minute look; 360 steps moves it every
+ *  4 minutes.  HOUR_HAND_SPRITE_SLOTS sprites, of a few hundred bytes of
+ *  heap each, are kept; one is enough, since the hand only moves forward.
+ */
+#define HOUR_HAND_SPRITE_STEPS 144
+#define HOUR_HAND_SPRITE_SLOTS 1
+
+
+/**
+ *  Latitude assumed, until the phone supplies a location, for the provisional
+ *  dial drawn on first run (longitude is estimated from the watch's
+ *  timezone).  Northern mid-latitudes, where most watches are.
+ */
+#define CONFIG_PROVISIONAL_LATITUDE 40.0
@@ -0,0 +1,202 @@
+/**
+ *  @file
+ *
+ *  Run-length encoded dial cache: see dial_cache.h.
+ *
+ *  Encoding is a flat sequence of (length, value) byte pairs, row after
+ *  row, runs never crossing a row end.  No row index is kept, since the
+ *  cache is only ever drawn whole, top to bottom.
+ */
+
+
+#include "pebble.h"
+
+#include "dial_cache.h"
+
+#include "geometry.h"
+#include "platform.h"
+#include "profiling.h"
+
+
+#if DIAL_CACHE_RENDER
+
+
+///  Encoded dial, or NULL when there is none.
+static uint8_t * pDialRuns = NULL;
+
+///  Bytes used in pDialRuns.
+static size_t  cbDialRuns = 0;
+
+
+/**
+ *  Find a frame buffer row's bytes.
+ *
+ *  @param pFrameBuffer Captured frame buffer.
+ *  @param y Screen row.
+ *  @param pFirst Receives index of the row's first byte in use.
+ *  @param pLast Receives index of the row's last byte in use.
+ *
+ *  @return Start of the row, to which *pFirst and *pLast are relative.
+ */
+static uint8_t *  frame_buffer_row(GBitmap *pFrameBuffer, int y, int *pFirst, int *pLast)
+{
+
+#ifdef PBL_COLOR
+   //  (on chalk, rows only hold the pixels on the round display)
+   GBitmapDataRowInfo  row = gbitmap_get_data_row_info(pFrameBuffer, y);
+
+   *pFirst = row.min_x;
+   *pLast  = row.max_x;
+   return row.data;
+#else
+   *pFirst = 0;
+   *pLast  = DISP_WIDTH / 8 - 1;
+   return gbitmap_get_data(pFrameBuffer) + y * gbitmap_get_bytes_per_row(pFrameBuffer);
+#endif
+
+}  /* end of frame_buffer_row() */
+
+
+/**
+ *  Run-length encode the frame buffer.
+ *
+ *  @param pFrameBuffer Captured frame buffer.
+ *  @param pOut Receives runs; NULL just to size them.
+ *  @param pcbRaw Receives number of frame buffer bytes encoded.
+ *
+ *  @return Bytes of runs.
+ */
+static size_t  encode_frame_buffer(GBitmap *pFrameBuffer, uint8_t *pOut, size_t *pcbRaw)
+{
+
+   size_t  cbRuns = 0;
+
+   *pcbRaw = 0;
+
+   for (int y = 0;  y < DISP_HEIGHT;  y++)
+   {
+      int  first, last;
+      const uint8_t * pRow = frame_buffer_row(pFrameBuffer, y, &first, &last);
+
+      *pcbRaw += last - first + 1;
+
+      for (int x = first;  x <= last;  )
+      {
+         uint8_t value = pRow[x];
+         int     len   = 1;
+
+         while ((x + len <= last) && (pRow[x + len] == value) && (len < 255))
+         {
+            len++;
+         }
+
+         if (pOut != NULL)
+         {
+            pOut[cbRuns]     = (uint8_t) len;
+            pOut[cbRuns + 1] = value;
+         }
+         cbRuns += 2;
+         x += len;
+      }
+   }
+
+   return cbRuns;
+
+}  /* end of encode_frame_buffer() */
+
+
+bool  dial_cache_draw(GContext *ctx)
+{
+
+   if (pDialRuns == NULL)
+   {
+      return false;
+   }
+
+   GBitmap * pFrameBuffer = graphics_capture_frame_buffer(ctx);
+
+   if (pFrameBuffer == NULL)
+   {
+      return false;
+   }
+
+   const uint8_t * pRun = pDialRuns;
+
+   for (int y = 0;  y < DISP_HEIGHT;  y++)
+   {
+      int  first, last;
+      uint8_t * pRow = frame_buffer_row(pFrameBuffer, y, &first, &last);
+
+      for (int x = first;  x <= last;  pRun += 2)
+      {
+         memset(pRow + x, pRun[1], pRun[0]);
+         x += pRun[0];
+      }
+   }
+
+   graphics_release_frame_buffer(ctx, pFrameBuffer);
+
+   return true;
+
+}  /* end of dial_cache_draw() */
+
+
+void  dial_cache_capture(GContext *ctx)
+{
+
+   dial_cache_destroy();
+
+   GBitmap * pFrameBuffer = graphics_capture_frame_buffer(ctx);
+
+   if (pFrameBuffer == NULL)
+   {
+      return;
+   }
+
+   size_t  cbRaw;
+   size_t  cbRuns = encode_frame_buffer(pFrameBuffer, NULL, &cbRaw);
+
+   if (cbRuns <= DIAL_CACHE_MAX_BYTES)
+   {
+      pDialRuns = malloc(cbRuns);
+      if (pDialRuns != NULL)
+      {
+         encode_frame_buffer(pFrameBuffer, pDialRuns, &cbRaw);
+         cbDialRuns = cbRuns;
+      }
+   }
+
+   graphics_release_frame_buffer(ctx, pFrameBuffer);
+
+   MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "dial cache: %u bytes of runs (%s), raw frame buffer %u",
+              (unsigned) cbRuns, (pDialRuns != NULL) ? "kept" : "dropped", (unsigned) cbRaw);
+
+}  /* end of dial_cache_capture() */
+
+
+void  dial_cache_invalidate(void)
+{
+   dial_cache_destroy();
+}
+
+
+void  dial_cache_destroy(void)
+{
+
+   if (pDialRuns != NULL)
+   {
+      free(pDialRuns);
+      pDialRuns  = NULL;
+      cbDialRuns = 0;
+   }
+
+}  /* end of dial_cache_destroy() */
+
+
+size_t  dial_cache_get_size(void)
+{
+   return cbDialRuns;
+}
+
+
+#endif  // #if DIAL_CACHE_RENDER
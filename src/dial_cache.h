@@ -0,0 +1,67 @@
+/**
+ *  @file
+ *
+ *  Run-length encoded copy of the rendered dial (twilight bands, mask, hour
+ *  marks: everything the base layer draws), so that the minute-by-minute
+ *  redraws caused by the time text and hour hand can restore the dial with
+ *  one or two thousand span fills instead of re-rendering it.
+ *
+ *  The dial is mostly large areas of solid color, so each frame buffer row
+ *  is stored as (length, value) runs of frame buffer bytes: one pixel per
+ *  byte on color platforms, eight on aplite, whose grey dither patterns
+ *  repeat byte for byte along a row.
+ *
+ *  Only built when DIAL_CACHE_RENDER is set in config.h.
+ */
+
+
+#ifndef sunclock_dial_cache_h__
+#define sunclock_dial_cache_h__
+
+
+#include "pebble.h"
+
+#include "config.h"
+
+
+#if DIAL_CACHE_RENDER
+
+/**
+ *  Most heap the cache may use.  A dial which doesn't encode within this is
+ *  simply rendered each time.  Sample dials come to 2.0 - 2.3K on aplite,
+ *  and 3.1 - 3.7K on color before anti-aliasing adds runs at band edges
+ *  (tools/host/dial_cache_check.c).
+ */
+#ifdef PBL_PLATFORM_APLITE
+# define DIAL_CACHE_MAX_BYTES   2560
+#else
+# define DIAL_CACHE_MAX_BYTES   8192
+#endif
+
+/**
+ *  If the cache holds a dial, write it to the frame buffer.
+ *
+ *  @return \c false if the cache is empty (or the frame buffer unavailable),
+ *          in which case the caller must render the dial.
+ */
+bool  dial_cache_draw(GContext *ctx);
+
+/**
+ *  Encode the frame buffer, just after a full render of the dial, into the
+ *  cache.  Any previous contents are replaced.
+ */
+void  dial_cache_capture(GContext *ctx);
+
+///  Forget the cached dial, e.g. because the day plan changed.
+void  dial_cache_invalidate(void);
+
+///  Release the cache's heap.
+void  dial_cache_destroy(void);
+
+///  Heap bytes held by the cache (zero if empty).
+size_t  dial_cache_get_size(void);
+
+#endif  // #if DIAL_CACHE_RENDER
+
+
+#endif  // #ifndef sunclock_dial_cache_h__
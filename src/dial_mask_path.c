@@ -13,7 +13,10 @@
 
 #include "pebble.h"
 
+#include "DayPlan.h"
+#include "dial_spans.h"
 #include "geometry.h"
+#include "helpers.h"
 #include "sunclock.h"
 
 
@@ -74,14 +77,16 @@ static const struct GPathInfo MediumHourMarkPathInfo =
     }
   };
 
-///  grect_center_point() of watchface dial's enclosing square
-GPoint dialHub;
+///  Center of watchface dial, in screen coordinates.
+static const GPoint dialHub = { FACE_CENTER_X, FACE_CENTER_Y };
 
 
 void  get_contrasting_colors(int localHour, GColor *pColorFill, GColor *pColorOutline)
 {
 
-   if (is_dark_time(localHour, 0))
+   const DayPlan * pPlan = day_plan_get_active();
+
+   if ((pPlan == NULL) || day_plan_is_dark_hour(pPlan, localHour % 24))
       {
       *pColorFill = GColorDarkGray;
       *pColorOutline = GColorWhite;
@@ -179,63 +184,34 @@ void  draw_small_hour_mark (GContext *ctx, int localHour)
 void  draw_watchface_mask(GContext *ctx, GRect layerFrame)
 {
 
-//void grect_align(GRect *rect, const GRect *inside_rect, const GAlign alignment, const bool clip);
-
-   //  do radial fill into a deliberately over-sized rectangle to ensure that
-   //  screen corners etc. are cleared as well.  Find a single dimension which
-   //  is used as both x and y overlap size.
-   int  maxSize = layerFrame.size.h;
-
-   GRect maskRect = GRect(layerFrame.origin.x - maxSize,
-                          layerFrame.origin.y - maxSize + FACE_VOFFSET,
-                          layerFrame.size.w + 2*maxSize,
-                          layerFrame.size.h + 2*maxSize);
-
-   dialHub = grect_center_point(&maskRect);
-
    // . . . insert drawing of hour markers here, a little oversized so they are cropped
    // . . . by the mask we then draw.
 
-   GPath * pLargeHourMarkPath  = gpath_create(&LargeHourMarkPathInfo);
-   GPath * pMediumHourMarkPath = gpath_create(&MediumHourMarkPathInfo);
-   gpath_move_to(pLargeHourMarkPath,  dialHub);
-   gpath_move_to(pMediumHourMarkPath, dialHub);
+   //  (on the stack: no heap traffic per frame)
+   GPath  largeHourMarkPath  = gpath_from_info(&LargeHourMarkPathInfo);
+   GPath  mediumHourMarkPath = gpath_from_info(&MediumHourMarkPathInfo);
+   gpath_move_to(&largeHourMarkPath,  dialHub);
+   gpath_move_to(&mediumHourMarkPath, dialHub);
 
    for (int hour = 0;  hour < 24;  hour += 6)
       {
-      fill_contrasting_path(ctx,  hour,   pLargeHourMarkPath);
+      fill_contrasting_path(ctx,  hour,   &largeHourMarkPath);
       draw_small_hour_mark (ctx,  hour+1);
       draw_small_hour_mark (ctx,  hour+2);
-      fill_contrasting_path(ctx,  hour+3, pMediumHourMarkPath);
+      fill_contrasting_path(ctx,  hour+3, &mediumHourMarkPath);
       draw_small_hour_mark (ctx,  hour+4);
       draw_small_hour_mark (ctx,  hour+5);
       }
 
 
-   gpath_destroy(pLargeHourMarkPath);
-   gpath_destroy(pMediumHourMarkPath);
-
-
-   graphics_context_set_fill_color(ctx, GColorBlack);
-
-   graphics_fill_radial(ctx, maskRect, GOvalScaleModeFitCircle,
-                        maxSize + FACE_EDGE_INSET,  /* uint16_t inset_thickness */
-                        DEG_TO_TRIGANGLE(0), DEG_TO_TRIGANGLE(360));
-
-   int minSize     = layerFrame.size.w;
-   int minSizeHalf = minSize / 2;
-
-   GRect dialRect = GRect(dialHub.x - minSizeHalf, dialHub.y - minSizeHalf,
-                          minSize, minSize);
-
-   graphics_context_set_fill_color(ctx, GColorWhite);
 
-   graphics_fill_radial(ctx, dialRect, GOvalScaleModeFitCircle,
-                        FACE_EDGE_INSET,  /* uint16_t inset_thickness */
-                        DEG_TO_TRIGANGLE(0), DEG_TO_TRIGANGLE(360));
+   //  Black out everything beyond the dial ring (trimming the hour marks'
+   //  deliberately over-size outer ends as we go), and whiten the ring, in
+   //  one pass of per-row spans.
+   dial_spans_draw_mask(ctx);
 
    graphics_context_set_stroke_color(ctx, GColorBlack);
-   graphics_draw_circle(ctx, dialHub, minSizeHalf - 1);
+   graphics_draw_circle(ctx, dialHub, layerFrame.size.w / 2 - 1);
 
    // . . . when all done with masked twilight bands, use
    //         graphics_capture_frame_buffer()
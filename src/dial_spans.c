@@ -0,0 +1,174 @@
+/**
+ *  @file
+ *
+ *  Scanline span tables for the watchface dial circle.
+ *
+ *  For each screen row we keep the half-width of two circles centered on
+ *  the dial hub: the dial proper (USABLE_FACE_RADIUS, where the twilight
+ *  bands show) and the outer edge of the white dial ring, FACE_EDGE_INSET
+ *  further out.  Everything outside the outer circle is black.  Since
+ *  both circles are symmetrical about the hub's x, one half-width per row
+ *  per circle is enough.
+ *
+ *  The mask is then a single pass down the frame buffer with at most five
+ *  memset()s per row, instead of a radial fill of a rectangle several
+ *  times the screen's area.
+ */
+
+
+#include "pebble.h"
+
+#include "dial_spans.h"
+#include "geometry.h"
+
+
+#ifndef PBL_PLATFORM_APLITE
+
+
+///  Outer radius of the white dial ring.
+#define  DIAL_RING_OUTER_RADIUS   (USABLE_FACE_RADIUS + FACE_EDGE_INSET)
+
+///  Half-width value for rows which don't intersect a circle at all.
+#define  NO_SPAN   (-1)
+
+
+///  Half-width of dial proper, per screen row; NO_SPAN if row misses it.
+static int8_t  aInnerHalfWidth[DISP_HEIGHT];
+
+///  Half-width of dial's outer ring edge, per screen row; NO_SPAN if row misses it.
+static int8_t  aOuterHalfWidth[DISP_HEIGHT];
+
+
+/**
+ *  Largest h such that (h*h + dy*dy) <= (radius*radius), or NO_SPAN if there
+ *  is no such h.  Pixel centers within radius are considered inside.
+ */
+static int  circle_half_width(int radius, int dy)
+{
+
+   int  rem = radius * radius - dy * dy;
+
+   if (rem < 0)
+   {
+      return NO_SPAN;
+   }
+
+   int  h = radius;
+
+   while (h * h > rem)
+   {
+      h--;
+   }
+
+   return h;
+
+}  /* end of circle_half_width() */
+
+
+void  dial_spans_init(void)
+{
+
+   for (int y = 0;  y < DISP_HEIGHT;  y++)
+   {
+      int  dy = y - FACE_CENTER_Y;
+
+      aInnerHalfWidth[y] = (int8_t) circle_half_width(USABLE_FACE_RADIUS,     dy);
+      aOuterHalfWidth[y] = (int8_t) circle_half_width(DIAL_RING_OUTER_RADIUS, dy);
+   }
+
+}  /* end of dial_spans_init() */
+
+
+bool  dial_spans_get_row(int y, int16_t *pX0, int16_t *pX1)
+{
+
+   if ((y < 0) || (y >= DISP_HEIGHT) || (aInnerHalfWidth[y] == NO_SPAN))
+   {
+      return false;
+   }
+
+   int  x0 = FACE_CENTER_X - aInnerHalfWidth[y];
+   int  x1 = FACE_CENTER_X + aInnerHalfWidth[y];
+
+   *pX0 = (x0 < 0) ? 0 : x0;
+   *pX1 = (x1 >= DISP_WIDTH) ? (DISP_WIDTH - 1) : x1;
+
+   return true;
+
+}  /* end of dial_spans_get_row() */
+
+
+/**
+ *  Fill part of a frame buffer row with a single color, clipped to the part
+ *  of the row actually backed by frame buffer memory.
+ */
+static void  fill_span(const GBitmapDataRowInfo *pRow, int x0, int x1, GColor color)
+{
+
+   if (x0 < pRow->min_x)
+   {
+      x0 = pRow->min_x;
+   }
+   if (x1 > pRow->max_x)
+   {
+      x1 = pRow->max_x;
+   }
+
+   if (x1 >= x0)
+   {
+      memset(pRow->data + x0, color.argb, x1 - x0 + 1);
+   }
+
+}  /* end of fill_span() */
+
+
+bool  dial_spans_draw_mask(GContext *ctx)
+{
+
+   GBitmap * pFrameBuffer = graphics_capture_frame_buffer(ctx);
+
+   if (pFrameBuffer == NULL)
+   {
+      return false;
+   }
+
+   for (int y = 0;  y < DISP_HEIGHT;  y++)
+   {
+      GBitmapDataRowInfo  row = gbitmap_get_data_row_info(pFrameBuffer, y);
+
+      int  outer = aOuterHalfWidth[y];
+      int  inner = aInnerHalfWidth[y];
+
+      if (outer == NO_SPAN)
+      {
+         //  row lies entirely outside dial ring
+         fill_span(&row, 0, DISP_WIDTH - 1, GColorBlack);
+         continue;
+      }
+
+      int  ringLeft  = FACE_CENTER_X - outer;
+      int  ringRight = FACE_CENTER_X + outer;
+
+      fill_span(&row, 0,             ringLeft - 1,   GColorBlack);
+      fill_span(&row, ringRight + 1, DISP_WIDTH - 1, GColorBlack);
+
+      if (inner == NO_SPAN)
+      {
+         //  row crosses ring only, above / below dial proper
+         fill_span(&row, ringLeft, ringRight, GColorWhite);
+      }
+      else
+      {
+         fill_span(&row, ringLeft,                  FACE_CENTER_X - inner - 1, GColorWhite);
+         fill_span(&row, FACE_CENTER_X + inner + 1, ringRight,                 GColorWhite);
+      }
+   }
+
+   graphics_release_frame_buffer(ctx, pFrameBuffer);
+
+   return true;
+
+}  /* end of dial_spans_draw_mask() */
+
+
+#endif  // #ifndef PBL_PLATFORM_APLITE
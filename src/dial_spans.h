@@ -0,0 +1,49 @@
+/**
+ *  @file
+ *
+ *  Per-scanline extents of the watchface dial circle, so the dial mask
+ *  (and anything else which needs to stay inside the dial) can be written
+ *  as simple horizontal spans instead of via oversized radial fills.
+ */
+
+
+#ifndef sunclock_dial_spans_h__
+#define sunclock_dial_spans_h__
+
+
+#include "pebble.h"
+
+
+#ifndef PBL_PLATFORM_APLITE
+
+/**
+ *  Build the span tables for this platform's dial geometry.  Must be called
+ *  before any other dial_spans_ routine; may safely be called again.
+ */
+void  dial_spans_init(void);
+
+/**
+ *  Find the part of a screen row which lies inside the dial proper (i.e.,
+ *  inside the white dial ring).
+ *
+ *  @param y Screen row, 0 .. DISP_HEIGHT - 1.
+ *  @param pX0 Receives leftmost on-screen x inside the dial.
+ *  @param pX1 Receives rightmost on-screen x inside the dial.
+ *
+ *  @return \c false if no part of row y lies inside the dial.
+ */
+bool  dial_spans_get_row(int y, int16_t *pX0, int16_t *pX1);
+
+/**
+ *  Write the dial mask straight into the frame buffer: black outside the
+ *  dial, and a white ring between the dial proper and the outer edge.
+ *  Pixels inside the dial are untouched.
+ *
+ *  @return \c false if the frame buffer could not be captured.
+ */
+bool  dial_spans_draw_mask(GContext *ctx);
+
+#endif  // #ifndef PBL_PLATFORM_APLITE
+
+
+#endif  // #ifndef sunclock_dial_spans_h__
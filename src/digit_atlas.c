@@ -0,0 +1,406 @@
+/**
+ *  @file
+ *
+ *  Pre-rendered digit glyphs for the time text: see digit_atlas.h.
+ *
+ *  Each glyph is kept as a 1-bit mask of its inked box only, rows packed
+ *  leftmost pixel first in the least significant bit, like aplite's frame
+ *  buffer.  Roughly 20 x 30 pixels, so about 90 bytes a digit.
+ */
+
+
+#include "pebble.h"
+
+#include "digit_atlas.h"
+
+#include "geometry.h"
+#include "platform.h"
+
+
+#if DIGIT_ATLAS_RENDER
+
+
+#define  GLYPH_COUNT      ((int) sizeof(DIGIT_ATLAS_CHARS) - 1)
+
+///  Most characters digit_atlas_draw() lays out: "00:00".
+#define  MAX_TEXT_CHARS   5
+
+/**
+ *  Frame buffer cell each glyph is rasterised in: mid screen, where even
+ *  chalk's rows are full width, and (for aplite) byte aligned.
+ */
+#define  CELL_X           (((DISP_WIDTH - DIGIT_ATLAS_MAX_WIDTH) / 2) & ~7)
+
+#ifdef PBL_COLOR
+# define  CELL_BYTE_X     CELL_X
+# define  CELL_ROW_BYTES  DIGIT_ATLAS_MAX_WIDTH
+#else
+# define  CELL_BYTE_X     (CELL_X / 8)
+# define  CELL_ROW_BYTES  (DIGIT_ATLAS_MAX_WIDTH / 8)
+#endif
+
+
+typedef struct {
+   uint16_t  offset;     ///< first byte of the glyph's mask in pAtlasBits
+   uint8_t   advance;    ///< pen advance, in pixels
+   uint8_t   xInk;       ///< inked box, relative to the pen position...
+   uint8_t   yInk;       ///< ...and the top of the text box
+   uint8_t   wInk;       ///< 0 for a glyph with no ink
+   uint8_t   hInk;
+} AtlasGlyph;
+
+
+static AtlasGlyph  aGlyphs[GLYPH_COUNT];
+
+///  Glyph masks, or NULL when there is no atlas.
+static uint8_t * pAtlasBits = NULL;
+
+///  Bytes in pAtlasBits.
+static size_t  cbAtlasBits = 0;
+
+
+///  Bytes in each row of a glyph's mask.
+static inline int  mask_row_bytes(const AtlasGlyph *pGlyph)
+{
+   return (pGlyph->wInk + 7) / 8;
+}
+
+
+///  Start of a frame buffer row, indexed by x (by x / 8 on aplite).
+static uint8_t *  frame_buffer_row(GBitmap *pFrameBuffer, int y)
+{
+
+#ifdef PBL_COLOR
+   return gbitmap_get_data_row_info(pFrameBuffer, y).data;
+#else
+   return gbitmap_get_data(pFrameBuffer) + y * gbitmap_get_bytes_per_row(pFrameBuffer);
+#endif
+
+}  /* end of frame_buffer_row() */
+
+
+///  Did the font ink a pixel of the cell (drawn white on black)?
+static bool  cell_pixel_inked(const uint8_t *pRow, int x)
+{
+
+#ifdef PBL_COLOR
+   return pRow[x] == GColorWhite.argb;
+#else
+   return (pRow[x >> 3] >> (x & 7)) & 1;
+#endif
+
+}  /* end of cell_pixel_inked() */
+
+
+/**
+ *  Rasterise one glyph in the frame buffer cell, restoring the cell's
+ *  pixels afterwards.
+ *
+ *  @param iGlyph Index in DIGIT_ATLAS_CHARS.
+ *  @param pSave Room for the cell's pixels: height x CELL_ROW_BYTES.
+ *  @param fStore \c false to find the glyph's inked box, \c true to copy
+ *             its mask into pAtlasBits, once the box is known.
+ *
+ *  @return \c false if the frame buffer was unavailable, or the ink
+ *          reached the cell's right edge (glyph too wide).
+ */
+static bool  rasterise_glyph(GContext *ctx, GFont font, int16_t height, int iGlyph,
+                             uint8_t *pSave, bool fStore)
+{
+
+   AtlasGlyph *pGlyph = &aGlyphs[iGlyph];
+   char        szGlyph[2] = { DIGIT_ATLAS_CHARS[iGlyph], '\0' };
+   int         yCell = (DISP_HEIGHT - height) / 2;
+   GRect       cell  = GRect(CELL_X, yCell, DIGIT_ATLAS_MAX_WIDTH, height);
+
+   GBitmap * pFrameBuffer = graphics_capture_frame_buffer(ctx);
+   if (pFrameBuffer == NULL)
+   {
+      return false;
+   }
+   for (int y = 0;  y < height;  y++)
+   {
+      memcpy(pSave + y * CELL_ROW_BYTES, frame_buffer_row(pFrameBuffer, yCell + y) + CELL_BYTE_X,
+             CELL_ROW_BYTES);
+   }
+   graphics_release_frame_buffer(ctx, pFrameBuffer);
+
+   graphics_context_set_fill_color(ctx, GColorBlack);
+   graphics_fill_rect(ctx, cell, 0, GCornerNone);
+   graphics_context_set_text_color(ctx, GColorWhite);
+   graphics_draw_text(ctx, szGlyph, font, cell, GTextOverflowModeWordWrap,
+                      GTextAlignmentLeft, NULL);
+
+   pFrameBuffer = graphics_capture_frame_buffer(ctx);
+   if (pFrameBuffer == NULL)
+   {
+      return false;
+   }
+
+   bool  fFits = true;
+
+   if (! fStore)
+   {
+      int  xMin = DIGIT_ATLAS_MAX_WIDTH, xMax = -1;
+      int  yMin = height, yMax = -1;
+
+      for (int y = 0;  y < height;  y++)
+      {
+         const uint8_t * pRow = frame_buffer_row(pFrameBuffer, yCell + y);
+
+         for (int x = 0;  x < DIGIT_ATLAS_MAX_WIDTH;  x++)
+         {
+            if (cell_pixel_inked(pRow, CELL_X + x))
+            {
+               xMin = (x < xMin) ? x : xMin;
+               xMax = (x > xMax) ? x : xMax;
+               yMin = (y < yMin) ? y : yMin;
+               yMax = (y > yMax) ? y : yMax;
+            }
+         }
+      }
+
+      //  (ink in the last column may have been clipped)
+      fFits = (xMax < DIGIT_ATLAS_MAX_WIDTH - 1);
+
+      pGlyph->xInk = (xMax < 0) ? 0 : xMin;
+      pGlyph->yInk = (xMax < 0) ? 0 : yMin;
+      pGlyph->wInk = (xMax < 0) ? 0 : xMax - xMin + 1;
+      pGlyph->hInk = (xMax < 0) ? 0 : yMax - yMin + 1;
+   }
+   else
+   {
+      uint8_t * pMask = pAtlasBits + pGlyph->offset;
+
+      memset(pMask, 0, mask_row_bytes(pGlyph) * pGlyph->hInk);
+
+      for (int y = 0;  y < pGlyph->hInk;  y++)
+      {
+         const uint8_t * pRow = frame_buffer_row(pFrameBuffer, yCell + pGlyph->yInk + y);
+         uint8_t *       pMaskRow = pMask + y * mask_row_bytes(pGlyph);
+
+         for (int x = 0;  x < pGlyph->wInk;  x++)
+         {
+            if (cell_pixel_inked(pRow, CELL_X + pGlyph->xInk + x))
+            {
+               pMaskRow[x >> 3] |= 1 << (x & 7);
+            }
+         }
+      }
+   }
+
+   for (int y = 0;  y < height;  y++)
+   {
+      memcpy(frame_buffer_row(pFrameBuffer, yCell + y) + CELL_BYTE_X, pSave + y * CELL_ROW_BYTES,
+             CELL_ROW_BYTES);
+   }
+   graphics_release_frame_buffer(ctx, pFrameBuffer);
+
+   return fFits;
+
+}  /* end of rasterise_glyph() */
+
+
+bool  digit_atlas_build(GContext *ctx, GFont font, int16_t height)
+{
+
+   digit_atlas_destroy();
+
+   if ((font == NULL) || (height <= 0) || (height > DISP_HEIGHT))
+   {
+      return false;
+   }
+
+   //  (the cell's own pixels, while a glyph is drawn over them)
+   uint8_t * pSave = malloc(height * CELL_ROW_BYTES);
+   if (pSave == NULL)
+   {
+      return false;
+   }
+
+   //  first pass: advances, and inked boxes to size the masks
+   bool    fOk    = true;
+   size_t  cbBits = 0;
+
+   for (int iGlyph = 0;  fOk && (iGlyph < GLYPH_COUNT);  iGlyph++)
+   {
+      char   szGlyph[2] = { DIGIT_ATLAS_CHARS[iGlyph], '\0' };
+      GSize  size = graphics_text_layout_get_content_size(szGlyph, font,
+                                                          GRect(0, 0, DISP_WIDTH, height),
+                                                          GTextOverflowModeWordWrap,
+                                                          GTextAlignmentLeft);
+
+      fOk = (size.w <= DIGIT_ATLAS_MAX_WIDTH) &&
+            rasterise_glyph(ctx, font, height, iGlyph, pSave, false);
+
+      aGlyphs[iGlyph].advance = size.w;
+      aGlyphs[iGlyph].offset  = cbBits;
+      cbBits += mask_row_bytes(&aGlyphs[iGlyph]) * aGlyphs[iGlyph].hInk;
+   }
+
+   //  second pass: the masks themselves
+   if (fOk)
+   {
+      pAtlasBits = malloc(cbBits);
+      fOk = (pAtlasBits != NULL);
+   }
+   if (fOk)
+   {
+      cbAtlasBits = cbBits;
+      for (int iGlyph = 0;  fOk && (iGlyph < GLYPH_COUNT);  iGlyph++)
+      {
+         fOk = rasterise_glyph(ctx, font, height, iGlyph, pSave, true);
+      }
+   }
+
+   free(pSave);
+
+   if (! fOk)
+   {
+      digit_atlas_destroy();
+   }
+
+   MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "digit atlas: %u bytes of masks (%s)",
+              (unsigned) cbBits, fOk ? "kept" : "dropped");
+
+   return fOk;
+
+}  /* end of digit_atlas_build() */
+
+
+bool  digit_atlas_is_built(void)
+{
+   return pAtlasBits != NULL;
+}
+
+
+/**
+ *  Write one glyph's inked pixels to the frame buffer.
+ *
+ *  @param xPen Screen x of the glyph's pen position.
+ *  @param yTop Screen y of the top of the text box.
+ */
+static void  blit_glyph(GBitmap *pFrameBuffer, const AtlasGlyph *pGlyph, int xPen, int yTop,
+                        GColor ink)
+{
+
+   GRect           bounds = gbitmap_get_bounds(pFrameBuffer);
+   const uint8_t * pMask  = pAtlasBits + pGlyph->offset;
+
+   for (int y = 0;  y < pGlyph->hInk;  y++, pMask += mask_row_bytes(pGlyph))
+   {
+      int yScreen = yTop + pGlyph->yInk + y;
+
+      if ((yScreen < bounds.origin.y) || (yScreen >= bounds.origin.y + bounds.size.h))
+      {
+         continue;
+      }
+
+#ifdef PBL_COLOR
+      GBitmapDataRowInfo  row = gbitmap_get_data_row_info(pFrameBuffer, yScreen);
+#else
+      uint8_t * pRow = frame_buffer_row(pFrameBuffer, yScreen);
+#endif
+
+      for (int x = 0;  x < pGlyph->wInk;  x++)
+      {
+         if (! ((pMask[x >> 3] >> (x & 7)) & 1))
+         {
+            continue;
+         }
+
+         int xScreen = xPen + pGlyph->xInk + x;
+
+#ifdef PBL_COLOR
+         if ((xScreen >= row.min_x) && (xScreen <= row.max_x))
+         {
+            row.data[xScreen] = ink.argb;
+         }
+#else
+         if ((xScreen < bounds.origin.x) || (xScreen >= bounds.origin.x + bounds.size.w))
+         {
+            continue;
+         }
+         if (gcolor_equal(ink, GColorBlack))
+         {
+            pRow[xScreen >> 3] &= ~(1 << (xScreen & 7));
+         }
+         else
+         {
+            pRow[xScreen >> 3] |= 1 << (xScreen & 7);
+         }
+#endif
+      }
+   }
+
+}  /* end of blit_glyph() */
+
+
+bool  digit_atlas_draw(GContext *ctx, const char *pszText, GRect box, GColor ink)
+{
+
+   if (pAtlasBits == NULL)
+   {
+      return false;
+   }
+
+   //  lay out: pen advances only, as the font has no kerning
+   const AtlasGlyph * apGlyphs[MAX_TEXT_CHARS];
+   int                cGlyphs = 0;
+   int                width   = 0;
+
+   for (const char *pch = pszText;  *pch != '\0';  pch++)
+   {
+      const char * pFound = strchr(DIGIT_ATLAS_CHARS, *pch);
+
+      if ((pFound == NULL) || (cGlyphs == MAX_TEXT_CHARS))
+      {
+         return false;
+      }
+
+      apGlyphs[cGlyphs] = &aGlyphs[pFound - DIGIT_ATLAS_CHARS];
+      width += apGlyphs[cGlyphs]->advance;
+      cGlyphs++;
+   }
+
+   GBitmap * pFrameBuffer = graphics_capture_frame_buffer(ctx);
+   if (pFrameBuffer == NULL)
+   {
+      return false;
+   }
+
+   int xPen = box.origin.x + (box.size.w - width) / 2;
+
+   for (int iGlyph = 0;  iGlyph < cGlyphs;  iGlyph++)
+   {
+      blit_glyph(pFrameBuffer, apGlyphs[iGlyph], xPen, box.origin.y, ink);
+      xPen += apGlyphs[iGlyph]->advance;
+   }
+
+   graphics_release_frame_buffer(ctx, pFrameBuffer);
+
+   return true;
+
+}  /* end of digit_atlas_draw() */
+
+
+void  digit_atlas_destroy(void)
+{
+
+   if (pAtlasBits != NULL)
+   {
+      free(pAtlasBits);
+      pAtlasBits  = NULL;
+      cbAtlasBits = 0;
+   }
+
+}  /* end of digit_atlas_destroy() */
+
+
+size_t  digit_atlas_get_size(void)
+{
+   return cbAtlasBits;
+}
+
+
+#endif  // #if DIGIT_ATLAS_RENDER
@@ -0,0 +1,74 @@
+/**
+ *  @file
+ *
+ *  Atlas of the large time text's characters -- digits and colon --
+ *  rasterised once from its font, so that the time can be drawn every frame
+ *  by blitting at most five small 1-bit glyph masks, instead of laying out
+ *  the text and rendering each glyph through the font.
+ *
+ *  The SDK offers no off-screen context, so glyphs are rasterised by the
+ *  font into a cell of the frame buffer (its pixels saved and restored
+ *  around each), from inside a layer update proc.  The cell is mid screen,
+ *  where even chalk's round display has full width rows.  Only each
+ *  glyph's inked rows and columns are kept.
+ *
+ *  Only built when DIGIT_ATLAS_RENDER is set in config.h.
+ */
+
+
+#ifndef sunclock_digit_atlas_h__
+#define sunclock_digit_atlas_h__
+
+
+#include "pebble.h"
+
+#include "config.h"
+
+
+#if DIGIT_ATLAS_RENDER
+
+///  Characters the atlas holds.
+#define  DIGIT_ATLAS_CHARS       "0123456789:"
+
+///  Widest glyph cell rasterised, in pixels; fonts with wider glyphs get no atlas.
+#define  DIGIT_ATLAS_MAX_WIDTH   32
+
+/**
+ *  Rasterise the atlas from a font: from a layer update proc, as the frame
+ *  buffer is borrowed to draw each glyph in.  Any previous atlas is replaced.
+ *
+ *  @param ctx Graphics context being drawn.
+ *  @param font Font to rasterise.
+ *  @param height Height of the box the text is drawn in.
+ *
+ *  @return \c false if out of heap, or a glyph too wide.
+ */
+bool  digit_atlas_build(GContext *ctx, GFont font, int16_t height);
+
+///  Has digit_atlas_build() succeeded (since the last destroy)?
+bool  digit_atlas_is_built(void);
+
+/**
+ *  Draw text from the atlas, as graphics_draw_text() would have drawn it
+ *  on one line centered in a box.
+ *
+ *  @param ctx Graphics context.
+ *  @param pszText Text to draw: DIGIT_ATLAS_CHARS only.
+ *  @param box Box to center the text in; as tall as the atlas was built for.
+ *  @param ink Text color.
+ *
+ *  @return \c false if there is no atlas or the text has other characters:
+ *          nothing is drawn, and the caller should use the font.
+ */
+bool  digit_atlas_draw(GContext *ctx, const char *pszText, GRect box, GColor ink);
+
+///  Release the atlas's heap.
+void  digit_atlas_destroy(void);
+
+///  Heap bytes held by the atlas (zero if none).
+size_t  digit_atlas_get_size(void);
+
+#endif  // #if DIGIT_ATLAS_RENDER
+
+
+#endif  // #ifndef sunclock_digit_atlas_h__
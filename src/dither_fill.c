@@ -0,0 +1,217 @@
+/**
+ *  @file
+ *
+ *  Dithered polygon fills for aplite: see dither_fill.h.
+ */
+
+
+#include "pebble.h"
+
+#include "dither_fill.h"
+
+
+/**
+ *  Pattern rows, per shade.  Same pixels as the 32 x 4 grey bitmaps these
+ *  replaced (light_grey.png etc.), but in frame buffer bit order.
+ */
+static const uint8_t  aShadeRows[DITHER_SHADE_COUNT][DITHER_PATTERN_ROWS] = {
+   [DITHER_NONE]       = { 0xFF, 0xFF, 0xFF, 0xFF },
+   [DITHER_LIGHT_GREY] = { 0xEE, 0xDD, 0x77, 0xBB },
+   [DITHER_GREY]       = { 0xAA, 0x55, 0x66, 0x99 },
+   [DITHER_DARK_GREY]  = { 0x22, 0x11, 0x44, 0x88 },
+};
+
+
+uint8_t  dither_fill_pattern_row(DitherShade shade, int y)
+{
+   return aShadeRows[shade][y % DITHER_PATTERN_ROWS];
+}
+
+
+#ifdef PBL_PLATFORM_APLITE
+
+///  Where an edge crosses a screen row: the pixels it covers in that row.
+typedef struct {
+   int16_t  xLo;
+   int16_t  xHi;
+} Crossing;
+
+
+/**
+ *  X coordinate of an edge at some y, which must lie within the edge's
+ *  vertical extent.
+ */
+static int  edge_x_at(GPoint p0, GPoint p1, int y)
+{
+   return p0.x + (y - p0.y) * (p1.x - p0.x) / (p1.y - p0.y);
+}
+
+
+/**
+ *  Find where a polygon's edges cross a screen row.
+ *
+ *  Each edge counts for rows from its upper end to just above its lower
+ *  one, so a vertex shared by two edges isn't counted twice; the polygon's
+ *  bottom row, which would then have no crossings, uses the edges ending
+ *  there instead.  Horizontal edges never cross: the spans of the rows they
+ *  lie on already reach them.
+ *
+ *  @return Number of crossings written to aCross, sorted left to right.
+ */
+static int  row_crossings(const GPoint *aPoints, int cPoints, int y, bool fBottomRow,
+                          Crossing *aCross)
+{
+
+   int  cCross = 0;
+
+   for (int iPt = 0;  iPt < cPoints;  iPt++)
+   {
+      GPoint p0 = aPoints[iPt];
+      GPoint p1 = aPoints[(iPt + 1) % cPoints];
+
+      if (p0.y > p1.y)
+      {
+         GPoint swap = p0;
+         p0 = p1;
+         p1 = swap;
+      }
+
+      bool fCrosses = fBottomRow ? ((p0.y < y) && (y == p1.y))
+                                 : ((p0.y <= y) && (y < p1.y));
+      if (! fCrosses)
+      {
+         continue;
+      }
+
+      //  cover all pixels the edge passes through in this row, not just the
+      //  one at its top, so shallow edges leave no gaps
+      int xA = edge_x_at(p0, p1, y);
+      int xB = (y < p1.y) ? edge_x_at(p0, p1, y + 1) : xA;
+
+      Crossing cross = { (xA < xB) ? xA : xB, (xA < xB) ? xB : xA };
+
+      //  insertion sort: there are only ever a handful
+      int iIns = cCross++;
+      while ((iIns > 0) && (aCross[iIns - 1].xLo > cross.xLo))
+      {
+         aCross[iIns] = aCross[iIns - 1];
+         iIns--;
+      }
+      aCross[iIns] = cross;
+   }
+
+   return cCross;
+
+}  /* end of row_crossings() */
+
+
+/**
+ *  AND a pattern byte into a run of pixels in one frame buffer row.
+ *
+ *  @param pRow Row's first byte.
+ *  @param x0 First pixel.
+ *  @param x1 Last pixel (included).
+ *  @param pattern Pattern byte for this row.
+ */
+static void  and_span(uint8_t *pRow, int x0, int x1, uint8_t pattern)
+{
+
+   int      iFirst = x0 >> 3;
+   int      iLast  = x1 >> 3;
+   uint8_t  maskFirst = (uint8_t) (0xFF << (x0 & 7));
+   uint8_t  maskLast  = (uint8_t) (0xFF >> (7 - (x1 & 7)));
+
+   if (iFirst == iLast)
+   {
+      pRow[iFirst] &= pattern | (uint8_t) ~(maskFirst & maskLast);
+      return;
+   }
+
+   pRow[iFirst] &= pattern | (uint8_t) ~maskFirst;
+
+   for (int i = iFirst + 1;  i < iLast;  i++)
+   {
+      pRow[i] &= pattern;
+   }
+
+   pRow[iLast] &= pattern | (uint8_t) ~maskLast;
+
+}  /* end of and_span() */
+
+
+void  dither_fill_polygon(GContext *ctx, const GPoint *aPoints, int cPoints,
+                          GPoint offset, DitherShade shade)
+{
+
+   if ((shade == DITHER_NONE) || (cPoints < 3) || (cPoints > DITHER_MAX_POINTS))
+   {
+      return;
+   }
+
+   GPoint  aScreen[DITHER_MAX_POINTS];
+   int     yMin = INT16_MAX;
+   int     yMax = INT16_MIN;
+
+   for (int iPt = 0;  iPt < cPoints;  iPt++)
+   {
+      aScreen[iPt] = GPoint(aPoints[iPt].x + offset.x, aPoints[iPt].y + offset.y);
+
+      if (aScreen[iPt].y < yMin)
+      {
+         yMin = aScreen[iPt].y;
+      }
+      if (aScreen[iPt].y > yMax)
+      {
+         yMax = aScreen[iPt].y;
+      }
+   }
+
+   GBitmap * pFrameBuffer = graphics_capture_frame_buffer(ctx);
+
+   if (pFrameBuffer == NULL)
+   {
+      return;
+   }
+
+   GRect      bounds = gbitmap_get_bounds(pFrameBuffer);
+   uint8_t  * pData  = gbitmap_get_data(pFrameBuffer);
+   uint16_t   cbRow  = gbitmap_get_bytes_per_row(pFrameBuffer);
+   int        xRight = bounds.origin.x + bounds.size.w - 1;
+   int        yFrom  = (yMin > bounds.origin.y) ? yMin : bounds.origin.y;
+   int        yTo    = (yMax < bounds.origin.y + bounds.size.h - 1) ? yMax
+                                                                    : bounds.origin.y + bounds.size.h - 1;
+
+   for (int y = yFrom;  y <= yTo;  y++)
+   {
+      Crossing  aCross[DITHER_MAX_POINTS];
+      int       cCross = row_crossings(aScreen, cPoints, y, (y == yMax), aCross);
+      uint8_t * pRow = pData + y * cbRow;
+      uint8_t   pattern = dither_fill_pattern_row(shade, y);
+
+      for (int iCross = 0;  iCross + 1 < cCross;  iCross += 2)
+      {
+         //  span between a pair of crossings, taking in both edges' pixels
+         int x0 = aCross[iCross].xLo;
+         int x1 = (aCross[iCross].xHi > aCross[iCross + 1].xHi) ? aCross[iCross].xHi
+                                                                : aCross[iCross + 1].xHi;
+
+         if (x0 < bounds.origin.x)
+         {
+            x0 = bounds.origin.x;
+         }
+         if (x1 > xRight)
+         {
+            x1 = xRight;
+         }
+         if (x0 <= x1)
+         {
+            and_span(pRow, x0, x1, pattern);
+         }
+      }
+   }
+
+   graphics_release_frame_buffer(ctx, pFrameBuffer);
+
+}  /* end of dither_fill_polygon() */
+
+#endif  // #ifdef PBL_PLATFORM_APLITE
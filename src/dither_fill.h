@@ -0,0 +1,73 @@
+/**
+ *  @file
+ *
+ *  Grey shades for aplite's 1-bit display, as ordered dither patterns
+ *  applied straight to the frame buffer inside a polygon.  This replaces
+ *  blitting a tiled grey bitmap over the whole screen: the patterns are a
+ *  few bytes of const data, and only the polygon's own rows and spans are
+ *  touched.
+ *
+ *  Each pattern repeats every 4 pixels both ways, so one frame buffer byte
+ *  (8 pixels, leftmost in the least significant bit) holds a whole row of
+ *  it.  Darker shades include every black pixel of lighter ones, so
+ *  applying several in any order gives the darkest.
+ */
+
+
+#ifndef sunclock_dither_fill_h__
+#define sunclock_dither_fill_h__
+
+
+#include "pebble.h"
+
+
+///  Rows in each pattern before it repeats.
+#define  DITHER_PATTERN_ROWS   4
+
+typedef enum {
+   DITHER_NONE,          ///< no shade: white, i.e. leave pixels as they are
+   DITHER_LIGHT_GREY,    ///< one pixel in four black
+   DITHER_GREY,          ///< half black
+   DITHER_DARK_GREY,     ///< three in four black
+   DITHER_SHADE_COUNT
+} DitherShade;
+
+
+/**
+ *  Frame buffer byte for one row of a shade's pattern.
+ *
+ *  @param shade Shade to look up.
+ *  @param y Screen row; patterns are aligned to the top of the screen.
+ *
+ *  @return Eight pixels, leftmost in bit 0, 1 for white.
+ */
+uint8_t  dither_fill_pattern_row(DitherShade shade, int y);
+
+
+#ifdef PBL_PLATFORM_APLITE
+
+///  Most points dither_fill_polygon() accepts.
+#define  DITHER_MAX_POINTS     8
+
+/**
+ *  Darken the pixels inside a polygon to (at least) a shade: each is ANDed
+ *  with the shade's pattern, so black stays black and white turns grey.
+ *  Scanline filled straight into the frame buffer.
+ *
+ *  Pixels on the polygon's edges are included, so a path filled with
+ *  gpath_draw_filled() over a neighbouring polygon leaves no gap.
+ *
+ *  @param ctx Graphics context whose frame buffer we draw to.
+ *  @param aPoints Polygon points, in order (either direction), closed
+ *             implicitly.  Relative to offset.
+ *  @param cPoints Number of points; at most DITHER_MAX_POINTS.
+ *  @param offset Screen position of the points' origin.
+ *  @param shade Shade to apply; DITHER_NONE does nothing.
+ */
+void  dither_fill_polygon(GContext *ctx, const GPoint *aPoints, int cPoints,
+                          GPoint offset, DitherShade shade);
+
+#endif  // #ifdef PBL_PLATFORM_APLITE
+
+
+#endif  // #ifndef sunclock_dither_fill_h__
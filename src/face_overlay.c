@@ -0,0 +1,272 @@
+/**
+ *  @file
+ *
+ *  Single layer for the text and hour hand over the dial: see face_overlay.h.
+ */
+
+
+#include "pebble.h"
+
+#include "face_overlay.h"
+
+#include "config.h"
+#include "DayPlan.h"
+#include "digit_atlas.h"
+#include "geometry.h"
+#include "helpers.h"
+#include "hour_hand.h"
+#include "moon_phase.h"
+#include "platform.h"
+#include "profiling.h"
+#include "quality_tier.h"
+
+
+///  Where and how a text item is drawn.
+typedef struct {
+   GRect           box;
+   GTextAlignment  alignment;
+   bool            fBlackText;    ///< black, rather than white, text
+} OverlayTextStyle;
+
+#define  TEXT_STYLE(x, y, w, h, align, fBlack)   { { { x, y }, { w, h } }, align, fBlack }
+
+/**
+ *  Text item layout, as the TextLayers had it.  The date shares its box
+ *  with the day of week, and sunset with sunrise: alignment keeps them apart.
+ */
+static const OverlayTextStyle  aTextStyles[OVERLAY_ITEM_COUNT] = {
+   [OVERLAY_TIME]    = TEXT_STYLE(0, TEXT_TIME_Y, DISP_WIDTH, 42, GTextAlignmentCenter, true),
+#ifndef PBL_ROUND
+   [OVERLAY_WEEKDAY] = TEXT_STYLE(0, TEXT_DATE_Y, DISP_WIDTH, 127 + 26, GTextAlignmentLeft, false),
+   [OVERLAY_DATE]    = TEXT_STYLE(0, TEXT_DATE_Y, DISP_WIDTH, 127 + 26, GTextAlignmentRight, false),
+   [OVERLAY_SUNRISE] = TEXT_STYLE(0, 147, DISP_WIDTH, 30, GTextAlignmentLeft, false),
+   [OVERLAY_SUNSET]  = TEXT_STYLE(0, 147, DISP_WIDTH, 30, GTextAlignmentRight, false),
+#else
+   //  no day of week, so center date
+   [OVERLAY_DATE]    = TEXT_STYLE(0, TEXT_DATE_Y, DISP_WIDTH, 127 + 26, GTextAlignmentCenter, true),
+#endif
+};
+
+#undef TEXT_STYLE
+
+static const char * const  apszItemNames[OVERLAY_ITEM_COUNT] = {
+   [OVERLAY_TIME]    = "time",
+   [OVERLAY_MOON]    = "moon",
+   [OVERLAY_HAND]    = "hand",
+#ifndef PBL_ROUND
+   [OVERLAY_WEEKDAY] = "weekday",
+   [OVERLAY_SUNRISE] = "sunrise",
+   [OVERLAY_SUNSET]  = "sunset",
+#endif
+   [OVERLAY_DATE]    = "date",
+};
+
+
+static Layer *  pOverlayLayer = NULL;
+
+///  Text items' text and font (unused for the moon and hand).
+static char   aszItemText[OVERLAY_ITEM_COUNT][OVERLAY_TEXT_SIZE];
+static GFont  aItemFont[OVERLAY_ITEM_COUNT];
+
+///  Items changed since the overlay was last drawn, one bit each.
+static uint16_t  dirtyItems = 0;
+
+///  Times each item was marked dirty, and the overlay drawn, since create.
+static uint32_t  aDirtyCount[OVERLAY_ITEM_COUNT];
+static uint32_t  cOverlayDraws = 0;
+
+#if DIGIT_ATLAS_RENDER
+///  Did building the digit atlas for the time's current font fail?  (Not retried.)
+static bool  fAtlasFailed = false;
+
+
+/**
+ *  Draw the time text from the digit atlas, building that first if need be.
+ *
+ *  @return \c false if there is no atlas: the caller should use the font.
+ */
+static bool  draw_time_from_atlas(GContext *ctx, GColor ink)
+{
+
+   //  (it costs heap, so only at the tier which also has the dial cache)
+   if (! quality_has_dial_cache())
+   {
+      return false;
+   }
+
+   if (! digit_atlas_is_built() && ! fAtlasFailed)
+   {
+      fAtlasFailed = ! digit_atlas_build(ctx, aItemFont[OVERLAY_TIME],
+                                         aTextStyles[OVERLAY_TIME].box.size.h);
+   }
+
+   return digit_atlas_draw(ctx, aszItemText[OVERLAY_TIME], aTextStyles[OVERLAY_TIME].box, ink);
+
+}  /* end of draw_time_from_atlas() */
+#endif
+
+
+static void  overlay_update_callback(Layer *me, GContext *ctx)
+{
+
+   (void) me;
+
+   PROFILE_START(overlay);
+
+   //  the whole frame was redrawn beneath us, so every item is drawn, not
+   //  just the dirty ones
+   for (int item = 0;  item < OVERLAY_ITEM_COUNT;  item++)
+   {
+      if (item == OVERLAY_HAND)
+      {
+         hour_hand_draw(ctx);
+         continue;
+      }
+
+      if (item == OVERLAY_MOON)
+      {
+         //  (no moon at the floor quality tier, nor until there's a plan)
+         const DayPlan * pPlan = day_plan_get_active();
+
+         if (quality_has_moon() && (pPlan != NULL))
+         {
+            moon_phase_draw(ctx, &pPlan->moon, GColorWhite);
+         }
+         continue;
+      }
+
+      if ((aItemFont[item] == NULL) || (aszItemText[item][0] == '\0'))
+      {
+         continue;
+      }
+
+      GColor ink = aTextStyles[item].fBlackText ? GColorBlack : GColorWhite;
+
+      PROFILE_START(text);
+
+#if DIGIT_ATLAS_RENDER
+      if ((item == OVERLAY_TIME) && draw_time_from_atlas(ctx, ink))
+      {
+         PROFILE_END(text, "time text from atlas");
+         continue;
+      }
+#endif
+
+      graphics_context_set_text_color(ctx, ink);
+      graphics_draw_text(ctx, aszItemText[item], aItemFont[item], aTextStyles[item].box,
+                         GTextOverflowModeWordWrap, aTextStyles[item].alignment, NULL);
+
+      if (item == OVERLAY_TIME)
+      {
+         PROFILE_END(text, "time text from font");
+      }
+   }
+
+   dirtyItems = 0;
+   cOverlayDraws++;
+
+   PROFILE_END(overlay, "overlay");
+
+}  /* end of overlay_update_callback() */
+
+
+bool  face_overlay_create(Layer *pParent)
+{
+
+   pOverlayLayer = layer_create(layer_get_bounds(pParent));
+   if (pOverlayLayer == NULL)
+   {
+      return false;
+   }
+
+   memset(aszItemText, 0, sizeof(aszItemText));
+   memset(aItemFont,   0, sizeof(aItemFont));
+   memset(aDirtyCount, 0, sizeof(aDirtyCount));
+   dirtyItems    = 0;
+   cOverlayDraws = 0;
+
+   layer_set_update_proc(pOverlayLayer, overlay_update_callback);
+   layer_add_child(pParent, pOverlayLayer);
+
+   return true;
+
+}  /* end of face_overlay_create() */
+
+
+void  face_overlay_destroy(void)
+{
+
+   if (pOverlayLayer != NULL)
+   {
+      layer_remove_from_parent(pOverlayLayer);
+   }
+   SAFE_DESTROY(layer, pOverlayLayer);
+
+#if DIGIT_ATLAS_RENDER
+   digit_atlas_destroy();
+   fAtlasFailed = false;
+#endif
+
+}  /* end of face_overlay_destroy() */
+
+
+void  face_overlay_mark_dirty(OverlayItem item)
+{
+
+   aDirtyCount[item]++;
+
+   //  one invalidation covers everything changed before the next frame
+   if ((dirtyItems == 0) && (pOverlayLayer != NULL))
+   {
+      layer_mark_dirty(pOverlayLayer);
+   }
+   dirtyItems |= 1u << item;
+
+}  /* end of face_overlay_mark_dirty() */
+
+
+void  face_overlay_set_font(OverlayItem item, GFont font)
+{
+
+   if (aItemFont[item] != font)
+   {
+      aItemFont[item] = font;
+      face_overlay_mark_dirty(item);
+
+#if DIGIT_ATLAS_RENDER
+      //  rebuilt from the new font on the next frame
+      if (item == OVERLAY_TIME)
+      {
+         digit_atlas_destroy();
+         fAtlasFailed = false;
+      }
+#endif
+   }
+
+}  /* end of face_overlay_set_font() */
+
+
+void  face_overlay_set_text(OverlayItem item, const char *pszText)
+{
+
+   if (strncmp(aszItemText[item], pszText, OVERLAY_TEXT_SIZE - 1) != 0)
+   {
+      strncpy(aszItemText[item], pszText, OVERLAY_TEXT_SIZE - 1);
+      aszItemText[item][OVERLAY_TEXT_SIZE - 1] = '\0';
+      face_overlay_mark_dirty(item);
+   }
+
+}  /* end of face_overlay_set_text() */
+
+
+void  face_overlay_log_counts(void)
+{
+
+   for (int item = 0;  item < OVERLAY_ITEM_COUNT;  item++)
+   {
+      MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "overlay %s: dirty %lu times",
+                 apszItemNames[item], (unsigned long) aDirtyCount[item]);
+   }
+   MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "overlay: drawn %lu times", (unsigned long) cOverlayDraws);
+
+}  /* end of face_overlay_log_counts() */
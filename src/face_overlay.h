@@ -0,0 +1,75 @@
+/**
+ *  @file
+ *
+ *  Everything drawn over the dial -- time, date and sunrise / sunset text,
+ *  the moon phase and the hour hand -- as items of one layer.
+ *
+ *  These were seven layers (six TextLayers and the hand's), each a heap
+ *  block with its own bounds, visited and drawn in turn on every frame,
+ *  and each invalidated whenever its widget ran, whether or not it showed
+ *  anything new.  Here each item is marked dirty only when it really
+ *  changes, and the layer only when the first of its items does; a frame
+ *  then draws all the items, in the order below, with plain graphics calls.
+ */
+
+
+#ifndef sunclock_face_overlay_h__
+#define sunclock_face_overlay_h__
+
+
+#include "pebble.h"
+
+
+///  What the overlay draws, bottom to top.
+typedef enum {
+   OVERLAY_TIME,        ///< time of day
+   OVERLAY_MOON,        ///< moon phase, drawn from the active DayPlan
+   OVERLAY_HAND,        ///< hour hand, drawn by hour_hand_draw()
+#ifndef PBL_ROUND
+   OVERLAY_WEEKDAY,     ///< day of week, top left
+#endif
+   OVERLAY_DATE,        ///< month, day and year
+#ifndef PBL_ROUND
+   OVERLAY_SUNRISE,     ///< sunrise time, bottom left
+   OVERLAY_SUNSET,      ///< sunset time, bottom right
+#endif
+   OVERLAY_ITEM_COUNT
+} OverlayItem;
+
+///  Longest text an item holds, with its terminator ("~Sep 30, 2026").
+#define  OVERLAY_TEXT_SIZE   14
+
+
+/**
+ *  Create the overlay layer, covering its parent, with no text or fonts
+ *  yet: items without both are not drawn.
+ *
+ *  @return \c false if out of heap.
+ */
+bool  face_overlay_create(Layer *pParent);
+
+void  face_overlay_destroy(void);
+
+/**
+ *  Set a text item's font.  Until an item has one, it isn't drawn.
+ */
+void  face_overlay_set_font(OverlayItem item, GFont font);
+
+/**
+ *  Set a text item's text, which is copied (truncated to
+ *  OVERLAY_TEXT_SIZE - 1 characters).  The item is marked dirty only if
+ *  the text differs from what it already shows.
+ */
+void  face_overlay_set_text(OverlayItem item, const char *pszText);
+
+/**
+ *  Note that an item has changed, so the overlay needs drawing again: for
+ *  items not set through this module, i.e. the moon and hour hand.
+ */
+void  face_overlay_mark_dirty(OverlayItem item);
+
+///  Log how often each item was marked dirty, and the overlay drawn (debug builds only).
+void  face_overlay_log_counts(void);
+
+
+#endif  // #ifndef sunclock_face_overlay_h__
@@ -33,7 +33,8 @@
 #define TEXT_TIME_Y     16
 #define TEXT_DATE_Y     56
 
-#define TEXT_MOON_Y     117
+//  center of the moon phase disc
+#define MOON_CENTER_Y   134
 
 //  also, since these vary with platform as well:
 
@@ -65,7 +66,8 @@
 #define TEXT_TIME_Y     36
 #define TEXT_DATE_Y      0
 
-#define TEXT_MOON_Y     113
+//  center of the moon phase disc
+#define MOON_CENTER_Y   130
 
 #define CHARGE_PCT_NOTICE         30
 #define CHARGE_PCT_WARN           20
@@ -83,6 +85,9 @@
 
 #define HOUR_HAND_CHARGE_RADIUS   (HOUR_HAND_HUB_RADIUS - 2)
 
+#define MOON_CENTER_X  (DISP_WIDTH / 2)
+#define MOON_RADIUS    12
+
 
 #endif  // #ifndef geometry_h__
 
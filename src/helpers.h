@@ -15,3 +15,13 @@
       pAlloc = NULL;                 \
    }
 
+
+/**
+ *  A GPath for the given points, as gpath_create() would make, but by value:
+ *  for paths held in a struct or on the stack rather than on the heap.
+ *  The points are referenced, not copied.
+ */
+#define gpath_from_info(pInfo) \
+   ((GPath) { .num_points = (pInfo)->num_points, .points = (pInfo)->points, \
+              .rotation = 0, .offset = { 0, 0 } })
+
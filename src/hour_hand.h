@@ -10,11 +10,30 @@
 
 
 
-void  hour_hand_init (const Window *window);
+/**
+ *  Set up the hour hand, which is drawn by hour_hand_draw() as an item of
+ *  the face overlay (see face_overlay.h).
+ *
+ *  @param pParent Layer for an implementation which still needs layers of
+ *             its own: aplite's RotBitmapLayers, with HOUR_HAND_SPRITE_STEPS
+ *             0.  They draw above the whole overlay.
+ */
+void  hour_hand_init (Layer *pParent);
 
 void  hour_hand_deinit();
 
-void  hour_hand_set_angle(int32_t hour_angle);
+/**
+ *  Set the hand's angle.
+ *
+ *  @return \c true if the hand as drawn by hour_hand_draw() has changed,
+ *          so the overlay needs drawing again.
+ */
+bool  hour_hand_set_angle(int32_t hour_angle);
+
+/**
+ *  Draw the hand, from the overlay's update proc.
+ */
+void  hour_hand_draw(GContext *ctx);
 
 
 //  For now, we use the original bitmap approach on aplite,
@@ -37,8 +56,18 @@ void  hour_hand_set_angle(int32_t hour_angle);
 /**
  *  Set hour hand's appearance based on whether it is over the night part
  *  of the background.
+ *
+ *  @return \c true if that changed the hand.
+ */
+bool  hour_hand_set_is_night (bool fIsNightNow);
+
+/**
+ *  Set battery state, shown by the color of the hour hand's hub.  The
+ *  caller is responsible for tracking battery state changes.
+ *
+ *  @return \c true if that changed the hand.
  */
-void  hour_hand_set_is_night (bool fIsNightNow);
+bool  hour_hand_set_battery (BatteryChargeState charge);
 #endif
 
 
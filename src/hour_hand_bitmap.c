@@ -1,11 +1,19 @@
 /**
  *  @file
- *  
+ *
  *  Provides bitmap-based display of hour hand.
- *  
+ *
  *  This is the approach used since Pebble version 1.x, but in version 3.x
  *  appears quite aliased when compared to anti-aliasing on the rest of
  *  the display.
+ *
+ *  Rotating the bitmap is one of the most expensive things aplite draws, and
+ *  RotBitmapLayers redo it (once for each of the white and black masks) on
+ *  every frame, though the hand hardly moves.  So with HOUR_HAND_SPRITE_STEPS
+ *  set in config.h, the hand's angle is quantised to that many steps per
+ *  revolution, and the hand is rotated just once per step, on first use,
+ *  into a run-length encoded sprite (see rle_mask.h) which each frame then
+ *  blits, as an item of the face overlay.
  */
 
 
@@ -16,26 +24,366 @@
 
 #if HOUR_HAND_USE_BITMAP
 
+#include  "config.h"
+#include  "geometry.h"
+#include  "helpers.h"
+#include  "platform.h"
+#include  "rle_mask.h"
 #include  "TransRotBmp.h"
 
 
+///  Pivot point within hour.png: the hand's axis.
+#define  HAND_PIVOT_X   9
+#define  HAND_PIVOT_Y  56
+
+
+#if HOUR_HAND_SPRITE_STEPS
+
+///  The hand pre-rendered at one angle step.
+typedef struct {
+   int16_t    step;       ///< angle step rendered; -1 for an empty slot
+   GPoint     origin;     ///< screen position of mask's top left pixel
+   RleMask    mask;
+   uint8_t  * pRuns;      ///< heap block behind mask.pRuns
+   uint32_t   lastUse;    ///< for replacing the least recently used slot
+} HandSprite;
+
+///  Builds a sprite's runs a pixel at a time.  Sizes them if pOut is NULL.
+typedef struct {
+   uint8_t  * pOut;
+   size_t     cb;
+   int        kind;
+   int        length;
+} RunWriter;
+
+
+///  Hour hand's white and black masks, from the "png-trans" resource.
+static GBitmap * pBmpHandWhite = NULL;
+static GBitmap * pBmpHandBlack = NULL;
+
+static HandSprite  aSprites[HOUR_HAND_SPRITE_SLOTS];
+
+///  Angle step to draw; -1 until hour_hand_set_angle() is called.
+static int16_t  sStep = -1;
+
+static uint32_t  cSpriteUses = 0;
+
+
+/**
+ *  Divide by TRIG_MAX_RATIO, rounding to nearest: converts the result of
+ *  multiplying by a sin_lookup() / cos_lookup() value back to pixels.
+ */
+static int  trig_ratio_round(int32_t value)
+{
+   return (value >= 0) ?  ((value + TRIG_MAX_RATIO / 2) / TRIG_MAX_RATIO)
+                       : -((-value + TRIG_MAX_RATIO / 2) / TRIG_MAX_RATIO);
+}
+
+
+static void  run_flush(RunWriter *pWriter)
+{
+
+   while (pWriter->length > 0)
+   {
+      int length = (pWriter->length > RLE_LENGTH_MASK + 1) ? RLE_LENGTH_MASK + 1
+                                                           : pWriter->length;
+      if (pWriter->pOut != NULL)
+      {
+         pWriter->pOut[pWriter->cb] = (uint8_t) ((pWriter->kind << RLE_KIND_SHIFT) | (length - 1));
+      }
+      pWriter->cb++;
+      pWriter->length -= length;
+   }
+
+}  /* end of run_flush() */
+
+
+static void  run_add(RunWriter *pWriter, int kind)
+{
+
+   if (kind != pWriter->kind)
+   {
+      run_flush(pWriter);
+      pWriter->kind = kind;
+   }
+   pWriter->length++;
+
+}  /* end of run_add() */
+
+
+///  RLE_RUN_* kind of a pixel of the unrotated hand; transparent outside it.
+static int  hand_pixel_kind(int x, int y)
+{
+
+   GRect bounds = gbitmap_get_bounds(pBmpHandWhite);
+
+   if ((x < 0) || (y < 0) || (x >= bounds.size.w) || (y >= bounds.size.h))
+   {
+      return RLE_RUN_SKIP;
+   }
+
+   //  (the black mask has bits set where the hand is black: drawn with GCompOpClear)
+   const uint8_t * pWhite = gbitmap_get_data(pBmpHandWhite) + y * gbitmap_get_bytes_per_row(pBmpHandWhite);
+   const uint8_t * pBlack = gbitmap_get_data(pBmpHandBlack) + y * gbitmap_get_bytes_per_row(pBmpHandBlack);
+   uint8_t  bit = 1 << (x & 7);
+
+   if (pWhite[x >> 3] & bit)
+   {
+      return RLE_RUN_WHITE;
+   }
+   if (pBlack[x >> 3] & bit)
+   {
+      return RLE_RUN_BLACK;
+   }
+   return RLE_RUN_SKIP;
+
+}  /* end of hand_pixel_kind() */
+
+
+/**
+ *  Rotate the hand into runs, sampling the nearest source pixel for each
+ *  pixel of a box around the hub.
+ *
+ *  @param pOut Receives runs; NULL just to size them.
+ *  @param box Box to encode, relative to the hub.
+ *  @param sinA sin_lookup() of the hand angle.
+ *  @param cosA cos_lookup() of the hand angle.
+ *
+ *  @return Bytes of runs.
+ */
+static size_t  encode_rotated_hand(uint8_t *pOut, GRect box, int32_t sinA, int32_t cosA)
+{
+
+   RunWriter  writer = { pOut, 0, RLE_RUN_SKIP, 0 };
+
+   for (int dy = box.origin.y;  dy < box.origin.y + box.size.h;  dy++)
+   {
+      for (int dx = box.origin.x;  dx < box.origin.x + box.size.w;  dx++)
+      {
+         //  screen y increases downward, so positive angles turn clockwise
+         int x = HAND_PIVOT_X + trig_ratio_round( dx * cosA + dy * sinA);
+         int y = HAND_PIVOT_Y + trig_ratio_round(-dx * sinA + dy * cosA);
+
+         run_add(&writer, hand_pixel_kind(x, y));
+      }
+
+      //  runs never cross a row end
+      run_flush(&writer);
+   }
+
+   return writer.cb;
+
+}  /* end of encode_rotated_hand() */
+
+
+/**
+ *  Pre-render the hand at an angle step into a sprite slot.
+ *
+ *  @return \c false if out of heap; the slot is then left empty.
+ */
+static bool  render_sprite(HandSprite *pSprite, int step)
+{
+
+   if (pSprite->pRuns != NULL)
+   {
+      free(pSprite->pRuns);
+      pSprite->pRuns = NULL;
+   }
+   pSprite->step = -1;
+
+   int32_t  angle = (int32_t) step * TRIG_MAX_ANGLE / HOUR_HAND_SPRITE_STEPS;
+   int32_t  sinA  = sin_lookup(angle);
+   int32_t  cosA  = cos_lookup(angle);
+   GRect    bounds = gbitmap_get_bounds(pBmpHandWhite);
+
+   //  box around the hub enclosing the rotated bitmap's corners
+   int  xMin = INT16_MAX, xMax = INT16_MIN;
+   int  yMin = INT16_MAX, yMax = INT16_MIN;
+
+   for (int iCorner = 0;  iCorner < 4;  iCorner++)
+   {
+      int sx = ((iCorner & 1) ? bounds.size.w : 0) - HAND_PIVOT_X;
+      int sy = ((iCorner & 2) ? bounds.size.h : 0) - HAND_PIVOT_Y;
+      int x  = trig_ratio_round(sx * cosA - sy * sinA);
+      int y  = trig_ratio_round(sx * sinA + sy * cosA);
+
+      xMin = (x < xMin) ? x : xMin;
+      xMax = (x > xMax) ? x : xMax;
+      yMin = (y < yMin) ? y : yMin;
+      yMax = (y > yMax) ? y : yMax;
+   }
+
+   GRect   box = GRect(xMin - 1, yMin - 1, xMax - xMin + 3, yMax - yMin + 3);
+   size_t  cbRuns = encode_rotated_hand(NULL, box, sinA, cosA);
+
+   pSprite->pRuns = malloc(cbRuns);
+   if (pSprite->pRuns == NULL)
+   {
+      MY_APP_LOG(APP_LOG_LEVEL_WARNING, "no heap for %u byte hand sprite", (unsigned) cbRuns);
+      return false;
+   }
+
+   encode_rotated_hand(pSprite->pRuns, box, sinA, cosA);
+
+   pSprite->step   = step;
+   pSprite->origin = GPoint(FACE_CENTER_X + box.origin.x, FACE_CENTER_Y + box.origin.y);
+   pSprite->mask   = (RleMask) { box.size.w, box.size.h, pSprite->pRuns };
+
+   MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "hand sprite %d: %d x %d, %u bytes of runs",
+              step, box.size.w, box.size.h, (unsigned) cbRuns);
+
+   return true;
+
+}  /* end of render_sprite() */
+
+
+///  Sprite for an angle step, rendered into the least recently used slot if need be.
+static HandSprite *  get_sprite(int step)
+{
+
+   HandSprite * pVictim = &aSprites[0];
+
+   for (int iSlot = 0;  iSlot < HOUR_HAND_SPRITE_SLOTS;  iSlot++)
+   {
+      if (aSprites[iSlot].step == step)
+      {
+         aSprites[iSlot].lastUse = ++cSpriteUses;
+         return &aSprites[iSlot];
+      }
+      if (aSprites[iSlot].lastUse < pVictim->lastUse)
+      {
+         pVictim = &aSprites[iSlot];
+      }
+   }
+
+   if (! render_sprite(pVictim, step))
+   {
+      return NULL;
+   }
+
+   pVictim->lastUse = ++cSpriteUses;
+   return pVictim;
+
+}  /* end of get_sprite() */
+
+
+void  hour_hand_draw(GContext *ctx)
+{
+
+   if (sStep < 0)
+   {
+      return;
+   }
+
+   HandSprite * pSprite = get_sprite(sStep);
+
+   if (pSprite != NULL)
+   {
+      rle_mask_draw(&pSprite->mask, ctx, pSprite->origin);
+   }
+
+}  /* end of hour_hand_draw() */
+
+
+bool  hour_hand_set_angle(int32_t hour_angle)
+{
+
+   int32_t  angle = hour_angle % TRIG_MAX_ANGLE;
+   if (angle < 0)
+   {
+      angle += TRIG_MAX_ANGLE;
+   }
+
+   int  step = (angle * HOUR_HAND_SPRITE_STEPS + TRIG_MAX_ANGLE / 2) / TRIG_MAX_ANGLE;
+   step %= HOUR_HAND_SPRITE_STEPS;
+
+   //  most minutes, the hand stays on the same step: nothing to redraw
+   if ((step == sStep) || (pBmpHandWhite == NULL))
+   {
+      return false;
+   }
+
+   sStep = step;
+   return true;
+
+}
+
+
+void  hour_hand_init (Layer *pParent)
+{
+
+   (void) pParent;
+
+   pBmpHandWhite = gbitmap_create_with_resource(RESOURCE_ID_IMAGE_HOUR_WHITE);
+   pBmpHandBlack = gbitmap_create_with_resource(RESOURCE_ID_IMAGE_HOUR_BLACK);
+
+   if ((pBmpHandWhite == NULL) || (pBmpHandBlack == NULL))
+   {
+      hour_hand_deinit();
+      return;
+   }
+
+   for (int iSlot = 0;  iSlot < HOUR_HAND_SPRITE_SLOTS;  iSlot++)
+   {
+      aSprites[iSlot] = (HandSprite) { .step = -1 };
+   }
+   sStep = -1;
+   cSpriteUses = 0;
+
+}
+
+
+void  hour_hand_deinit()
+{
+
+
+   //  undo everything init() did
+
+   for (int iSlot = 0;  iSlot < HOUR_HAND_SPRITE_SLOTS;  iSlot++)
+   {
+      if (aSprites[iSlot].pRuns != NULL)
+      {
+         free(aSprites[iSlot].pRuns);
+      }
+      aSprites[iSlot] = (HandSprite) { .step = -1 };
+   }
+
+   SAFE_DESTROY(gbitmap, pBmpHandWhite);
+   SAFE_DESTROY(gbitmap, pBmpHandBlack);
+
+   return;
+
+}
+
+
+#else  // #if HOUR_HAND_SPRITE_STEPS
+
+
 ///  Hour hand bitmap, a transparent png which can rotate to any angle.
 static TransRotBmp* pTransRotBmpHourHand = 0;
 
 
-void  hour_hand_set_angle(int32_t hour_angle)
+bool  hour_hand_set_angle(int32_t hour_angle)
 {
 
    transrotbmp_set_angle(pTransRotBmpHourHand, hour_angle);
    transrotbmp_set_pos_centered(pTransRotBmpHourHand, 0, 9 + 2);
 
+   //  (the RotBitmapLayers redraw themselves)
+   return false;
+
 }
 
 
-void  hour_hand_init (const Window *window)
+void  hour_hand_draw(GContext *ctx)
 {
+   //  the RotBitmapLayers draw the hand
+   (void) ctx;
+}
+
 
-   Layer *window_layer = window_get_root_layer(window);
+void  hour_hand_init (Layer *pParent)
+{
 
    pTransRotBmpHourHand = transrotbmp_create_with_resource_prefix(RESOURCE_ID_IMAGE_HOUR);
    if (pTransRotBmpHourHand == NULL)
@@ -43,8 +391,8 @@ void  hour_hand_init (const Window *window)
       return;
    }
 
-   transrotbmp_set_src_ic(pTransRotBmpHourHand, GPoint(9, 56));
-   transrotbmp_add_to_layer(pTransRotBmpHourHand, window_layer);
+   transrotbmp_set_src_ic(pTransRotBmpHourHand, GPoint(HAND_PIVOT_X, HAND_PIVOT_Y));
+   transrotbmp_add_to_layer(pTransRotBmpHourHand, pParent);
 
 }
 
@@ -63,5 +411,7 @@ void  hour_hand_deinit()
 }
 
 
+#endif  // #if HOUR_HAND_SPRITE_STEPS
+
 #endif  // #if HOUR_HAND_USE_BITMAP
 
@@ -12,6 +12,8 @@
 #include  "hour_hand.h"
 
 #include  "geometry.h"
+#include  "helpers.h"
+#include  "quality_tier.h"
 #include  "testing.h"
 
 
@@ -40,9 +42,7 @@ static const GPathInfo HOUR_HAND_POINTS = {
 };
 
 
-static GPath *s_hour_hand_path;
-
-static Layer *s_path_layer;
+static GPath s_hour_hand_path;    // by value: see gpath_from_info()
 
 static GPoint s_center;    // axis of our hour hand, _not_ center of screen
 
@@ -66,35 +66,80 @@ static int32_t  s_hour_angle;
 static bool  s_is_night_now;
 
 
-void  hour_hand_set_angle(int32_t hour_angle)
+/**
+ *  Color of the small circle in the center of the hub, reflecting battery
+ *  charge.  Range of light yellow .. dark red suggested somewhere online,
+ *  for another face.
+ */
+static GColor  charge_color(uint8_t charge_percent)
+{
+
+   if ((charge_percent <= CHARGE_PCT_CRITICAL) || TESTING_SHOW_LOW_BATTERY)
+   {
+      return GColorRed;
+   }
+   else if (charge_percent <= CHARGE_PCT_WARN)
+   {
+      return GColorOrange;
+   }
+   else if (charge_percent <= CHARGE_PCT_NOTICE)
+   {
+      return GColorChromeYellow;     // more orange than orange?  :-)
+   }
+
+   //  anything above 30%, just use our default hour hand color
+   return GColorFromRGB(HR_HND_RGB_RED, HR_HND_RGB_GREEN, HR_HND_RGB_BLUE);
+
+}
+
+
+bool  hour_hand_set_angle(int32_t hour_angle)
 {
+
+   bool fChanged = (hour_angle != s_hour_angle);
+
    s_hour_angle = hour_angle;
 //BUGBUG - when forcing positions for graphics testing:
 //   s_hour_angle = 3*(TRIG_MAX_ANGLE / 4);
+   return fChanged;
+
 }
 
 
-void  hour_hand_set_is_night (bool fIsNightNow)
+bool  hour_hand_set_is_night (bool fIsNightNow)
 {
+
+   bool fChanged = (fIsNightNow != s_is_night_now);
+
    s_is_night_now = fIsNightNow;
+   return fChanged;
+
 }
 
 
-void battery_State_Handler(BatteryChargeState charge)
+bool  hour_hand_set_battery (BatteryChargeState charge)
 {
+
+   //  (only the hub's color shows, not the exact charge)
+   bool fChanged = ! gcolor_equal(charge_color(charge.charge_percent),
+                                  charge_color(s_battery_charge.charge_percent));
+
    s_battery_charge = charge;
+   return fChanged;
+
 }
 
 
-static void path_layer_update_callback(Layer *path_layer, GContext *ctx)
+void  hour_hand_draw(GContext *ctx)
 {
 
 
    //BUGBUG - as of SDK 3.2, no alpha support for graphics fill operations
    //         (path, circle, whatever).  Only bitmaps.  :-(
    graphics_context_set_compositing_mode(ctx, GCompOpSet);
+   graphics_context_set_antialiased(ctx, quality_has_antialiasing());
 
-   gpath_rotate_to(s_hour_hand_path, s_hour_angle);    // angular units?
+   gpath_rotate_to(&s_hour_hand_path, s_hour_angle);    // angular units?
 
 // TODO:  revisit once we can get alpha fills in a gpath!
 //   graphics_context_set_fill_color(ctx, GColorFromRGBA(HR_HND_RGB_RED,
@@ -111,12 +156,12 @@ static void path_layer_update_callback(Layer *path_layer, GContext *ctx)
       graphics_context_set_fill_color(ctx, GColorBlack);
    }
 
-   gpath_draw_filled(ctx, s_hour_hand_path); 
+   gpath_draw_filled(ctx, &s_hour_hand_path); 
 
    //  white outline seems to look better with both fill colors
    graphics_context_set_stroke_color(ctx, GColorWhite);
 
-   gpath_draw_outline(ctx, s_hour_hand_path);
+   gpath_draw_outline(ctx, &s_hour_hand_path);
 
    //  draw stock black hub over axis / hour hand, regardless of hour hand color
 
@@ -128,59 +173,28 @@ static void path_layer_update_callback(Layer *path_layer, GContext *ctx)
    graphics_draw_circle(ctx, s_center, HOUR_HAND_HUB_RADIUS);
 
    //  optionally write a smaller circle in center of hub, whose color reflects battery charge.
-   //  Range of light yellow .. dark red suggested somewhere online, for another face.
-
    //  somehow interpolate from charge % in s_battery_charge to get maybe ten color "levels"?
-   uint8_t charge_percent = s_battery_charge.charge_percent;
-   GColor charge_color;
-
-   if ((charge_percent <= CHARGE_PCT_CRITICAL) || TESTING_SHOW_LOW_BATTERY)
-   {
-      charge_color = GColorRed;
-   }
-   else if (charge_percent <= CHARGE_PCT_WARN)
-   {
-      charge_color = GColorOrange;
-   }
-   else if (charge_percent <= CHARGE_PCT_NOTICE)
-   {
-      charge_color = GColorChromeYellow;     // more orange than orange?  :-)
-   }
-   else
-   {
-      //  anything above 30%, just use our default hour hand color
-      charge_color = GColorFromRGB(HR_HND_RGB_RED, HR_HND_RGB_GREEN, HR_HND_RGB_BLUE);
-   }
-
-   graphics_context_set_fill_color(ctx, charge_color);
+   graphics_context_set_fill_color(ctx, charge_color(s_battery_charge.charge_percent));
 
    graphics_fill_circle(ctx, s_center, HOUR_HAND_CHARGE_RADIUS);
 
 }
 
 
-void  hour_hand_init (const Window *window)
+void  hour_hand_init (Layer *pParent)
 {
 
-   Layer *window_layer = window_get_root_layer(window);
-   GRect bounds = layer_get_frame(window_layer);
-
-   s_path_layer = layer_create(bounds);
-  
-   //  Define the draw callback to use for this layer
-   layer_set_update_proc(s_path_layer, path_layer_update_callback);
-   layer_add_child(window_layer, s_path_layer);
+   (void) pParent;
 
    // Initialize and define the two paths used to draw the needle to north and to south
-   s_hour_hand_path = gpath_create(&HOUR_HAND_POINTS );
+   s_hour_hand_path = gpath_from_info(&HOUR_HAND_POINTS);
 
    //  hour hand axis: not quite the center of the screen
    s_center = GPoint(FACE_CENTER_X, FACE_CENTER_Y);
-   gpath_move_to(s_hour_hand_path, s_center);
+   gpath_move_to(&s_hour_hand_path, s_center);
 
-   // track current battery charge level
+   //  (battery charge level is fed us via hour_hand_set_battery())
    s_battery_charge = battery_state_service_peek();
-   battery_state_service_subscribe(battery_State_Handler);
 
 }
 
@@ -189,16 +203,7 @@ void  hour_hand_deinit()
 {
 
 
-   //  undo everything init() did
-
-   battery_state_service_unsubscribe();
-
-   gpath_destroy(s_hour_hand_path);
-   s_hour_hand_path = 0;
-
-   layer_remove_from_parent(s_path_layer);
-   layer_destroy(s_path_layer);
-   s_path_layer = 0;
+   //  nothing init() did needs undoing: the path is held by value
 
    return;
 
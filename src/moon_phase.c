@@ -0,0 +1,112 @@
+/**
+ *  @file
+ *
+ *  Procedural moon phase: see moon_phase.h.
+ */
+
+
+#include "pebble.h"
+
+#include "moon_phase.h"
+
+#include "my_math.h"
+
+
+///  Mean length of a lunation, in days.
+#define  SYNODIC_MONTH      29.530588853
+
+///  Julian day of a new moon (January 6th, 2000, 18:14 UTC).
+#define  NEW_MOON_EPOCH     2451550.26
+
+
+/**
+ *  Largest integer not above x.  (my_floor() truncates toward zero, which
+ *  for a terminator left of center would move it a column right.)
+ */
+static int  floor_to_int(float x)
+{
+
+   int i = (int) x;
+
+   return (x < i) ? i - 1 : i;
+
+}  /* end of floor_to_int() */
+
+
+/**
+ *  Age of the moon, as a fraction of the lunation: 0 new, 0.5 full.
+ */
+static float  moon_age(int julianDay)
+{
+
+   //  (double: a float can't hold the day number to better than a quarter day)
+   double lunations = (julianDay - NEW_MOON_EPOCH) / SYNODIC_MONTH;
+
+   return (float) (lunations - my_floor(lunations));
+
+}  /* end of moon_age() */
+
+
+void  moon_phase_compute(int julianDay, bool fSouthernHemisphere, MoonShape *pShape)
+{
+
+   float age = moon_age(julianDay);
+
+   //  terminator's x, as a fraction of the row's half width: +1 at new
+   //  moon (the right limb), through 0 at first quarter, to -1 at full
+   float terminator = my_cos(2 * M_PI * age);
+   bool  fWaxing    = (age < 0.5f);
+
+   for (int iRow = 0;  iRow < MOON_ROWS;  iRow++)
+   {
+      int   dy = iRow - MOON_RADIUS;
+      float halfWidth = my_sqrt((MOON_RADIUS + 0.5f) * (MOON_RADIUS + 0.5f) - dy * dy);
+      int   limb = floor_to_int(halfWidth);
+
+      //  waxing (seen from the north), lit right of the terminator; waning,
+      //  the mirror image
+      int   inner = floor_to_int(halfWidth * terminator) + 1;
+      int   left  = fWaxing ? inner : -limb;
+      int   right = fWaxing ? limb  : -inner;
+
+      left  = (left  < -limb) ? -limb : left;
+      right = (right >  limb) ?  limb : right;
+
+      if (fSouthernHemisphere)
+      {
+         int swap = left;
+         left  = -right;
+         right = -swap;
+      }
+
+      pShape->aSpans[iRow].left  = (int8_t) left;
+      pShape->aSpans[iRow].right = (int8_t) right;
+   }
+
+}  /* end of moon_phase_compute() */
+
+
+void  moon_phase_draw(GContext *ctx, const MoonShape *pShape, GColor color)
+{
+
+   GPoint center = GPoint(MOON_CENTER_X, MOON_CENTER_Y);
+
+   graphics_context_set_stroke_color(ctx, color);
+
+   //  outline, so the dark part still shows as a disc
+   graphics_draw_circle(ctx, center, MOON_RADIUS);
+
+   for (int iRow = 0;  iRow < MOON_ROWS;  iRow++)
+   {
+      const MoonSpan * pSpan = &pShape->aSpans[iRow];
+
+      if (pSpan->left <= pSpan->right)
+      {
+         int y = center.y + iRow - MOON_RADIUS;
+
+         graphics_draw_line(ctx, GPoint(center.x + pSpan->left,  y),
+                                 GPoint(center.x + pSpan->right, y));
+      }
+   }
+
+}  /* end of moon_phase_draw() */
@@ -0,0 +1,60 @@
+/**
+ *  @file
+ *
+ *  Moon phase, drawn procedurally: a disc outline, with the lit part
+ *  between the limb and the terminator (an ellipse, half the disc wide
+ *  times the cosine of the phase angle) filled.  The shape is worked out
+ *  once a day, as the lit span of each row of the disc, and kept in the
+ *  DayPlan; drawing just fills those spans.
+ *
+ *  This replaces a 30 pt font of 28 moon glyphs: no font to load, and the
+ *  terminator follows the day's illuminated fraction rather than the
+ *  nearest of 28 steps.
+ */
+
+
+#ifndef sunclock_moon_phase_h__
+#define sunclock_moon_phase_h__
+
+
+#include "pebble.h"
+
+#include "geometry.h"
+
+
+///  Rows in the moon disc.
+#define  MOON_ROWS   (2 * MOON_RADIUS + 1)
+
+///  Lit pixels of one row of the disc, relative to its center.  Empty if left > right.
+typedef struct {
+   int8_t  left;
+   int8_t  right;
+} MoonSpan;
+
+///  A day's moon.
+typedef struct {
+   MoonSpan  aSpans[MOON_ROWS];    ///< top row first
+} MoonShape;
+
+
+/**
+ *  Work out the moon's shape for a day.
+ *
+ *  @param julianDay Astronomical julian day number of the date.
+ *  @param fSouthernHemisphere Seen from south of the equator, the moon is
+ *             lit from the other side.
+ *  @param pShape Receives the shape.
+ */
+void  moon_phase_compute(int julianDay, bool fSouthernHemisphere, MoonShape *pShape);
+
+/**
+ *  Draw the moon, centered at (MOON_CENTER_X, MOON_CENTER_Y).
+ *
+ *  @param ctx Graphics context.
+ *  @param pShape Shape, from moon_phase_compute().
+ *  @param color Outline and lit part color.
+ */
+void  moon_phase_draw(GContext *ctx, const MoonShape *pShape, GColor color);
+
+
+#endif  // #ifndef sunclock_moon_phase_h__
@@ -4,6 +4,7 @@
  * - http://www.codeproject.com/Articles/69941/Best-Square-Root-Method-Algorithm-Function-Precisi
  */
 #include "my_math.h"
+#include "my_math_coeffs.h"
 
 #define SQRT_MAGIC_F 0x5f3759df 
 float my_sqrt(const float x)
@@ -35,7 +36,7 @@ float my_atan(float x)
 {
   if (x>0) 
   {
-    return (M_PI/2)*(0.596227*x + x*x)/(1 + 2*0.596227*x + x*x);
+    return 1.57079633f*(0.596227f*x + x*x)/(1.0f + 2.0f*0.596227f*x + x*x);
   } 
   else
   {
@@ -46,58 +47,44 @@ float my_atan(float x)
 /* not quite rint(), i.e. results not properly rounded to nearest-or-even */
 float my_rint (float x)
 {
-  float t = my_floor (my_fabs(x) + 0.5);
-  return (x < 0.0) ? -t : t;
+  float t = my_floor (my_fabs(x) + 0.5f);
+  return (x < 0.0f) ? -t : t;
 }
 
-/* minimax approximation to cos on [-pi/4, pi/4] with rel. err. ~= 7.5e-13 */
+/*
+ * Kernel polynomials are fitted for float evaluation by tools/gen_trig_coeffs.py,
+ * which also documents the error / cost of each candidate degree.  Regenerate
+ * my_math_coeffs.h with that tool rather than editing coefficients here.
+ */
+
+/* minimax approximation to cos on [-pi/4, pi/4] */
 float cos_core (float x)
 {
-  float x8, x4, x2;
-  x2 = x * x;
-  x4 = x2 * x2;
-  x8 = x4 * x4;
-  /* evaluate polynomial using Estrin's scheme */
-  return (-2.7236370439787708e-7 * x2 + 2.4799852696610628e-5) * x8 +
-         (-1.3888885054799695e-3 * x2 + 4.1666666636943683e-2) * x4 +
-         (-4.9999999999963024e-1 * x2 + 1.0000000000000000e+0);
+  return cos_core_poly (x * x);
 }
 
-/* minimax approximation to sin on [-pi/4, pi/4] with rel. err. ~= 5.5e-12 */
+/* minimax approximation to sin on [-pi/4, pi/4] */
 float sin_core (float x)
 {
-  float x4, x2;
-  x2 = x * x;
-  x4 = x2 * x2;
-  /* evaluate polynomial using a mix of Estrin's and Horner's scheme */
-  return ((2.7181216275479732e-6 * x2 - 1.9839312269456257e-4) * x4 + 
-          (8.3333293048425631e-3 * x2 - 1.6666666640797048e-1)) * x2 * x + x;
+  return x * sin_core_poly (x * x);
 }
 
-/* minimax approximation to arcsin on [0, 0.5625] with rel. err. ~= 1.5e-11 */
+/* minimax approximation to arcsin on [0, 0.5625] */
 float asin_core (float x)
 {
-  float x8, x4, x2;
-  x2 = x * x;
-  x4 = x2 * x2;
-  x8 = x4 * x4;
-  /* evaluate polynomial using a mix of Estrin's and Horner's scheme */
-  return (((4.5334220547132049e-2 * x2 - 1.1226216762576600e-2) * x4 +
-           (2.6334281471361822e-2 * x2 + 2.0596336163223834e-2)) * x8 +
-          (3.0582043602875735e-2 * x2 + 4.4630538556294605e-2) * x4 +
-          (7.5000364034134126e-2 * x2 + 1.6666666300567365e-1)) * x2 * x + x; 
+  return x * asin_core_poly (x * x);
 }
 
-/* relative error < 7e-12 on [-50000, 50000] */
+/* absolute error ~= 1.3e-7 on [-1000, 1000], limited by float argument reduction */
 float my_sin (float x)
 {
   float q, t;
   int quadrant;
-  /* Cody-Waite style argument reduction */
-  q = my_rint (x * 6.3661977236758138e-1);
+  /* Cody-Waite style argument reduction, pi/2 split so q * hi is exact */
+  q = my_rint (x * 6.36619772e-1f);
   quadrant = (int)q;
-  t = x - q * 1.5707963267923333e+00;
-  t = t - q * 2.5633441515945189e-12;
+  t = x - q * 1.5703125f;
+  t = t - q * 4.83826794897e-4f;
   if (quadrant & 1) {
     t = cos_core(t);
   } else {
@@ -108,10 +95,84 @@ float my_sin (float x)
 
 float my_cos(float x)
 {
-  return my_sin(x + (M_PI/2));
+  return my_sin(x + 1.57079633f);
+}
+
+/*
+ * Batched forms, for callers which need many samples at once (year tables,
+ * validation grids, etc.).  out may alias in.
+ *
+ * Host builds (tools/host) run them MY_MATH_LANES at a time, in GCC vector
+ * extensions: SSE2 by default, AVX2 with -mavx2.  The steps and constants are
+ * my_sin()'s, so every lane gives exactly my_sin()'s result.  The watch has
+ * no SIMD unit and takes the scalar loops alone.
+ */
+#if defined(__AVX2__)
+#define MY_MATH_LANES 8
+#elif defined(__SSE2__)
+#define MY_MATH_LANES 4
+#endif
+
+#ifdef MY_MATH_LANES
+typedef float vfloat __attribute__ ((vector_size (MY_MATH_LANES * 4)));
+typedef int   vint   __attribute__ ((vector_size (MY_MATH_LANES * 4)));
+
+/* mask ? a : b, lane by lane (mask lanes all ones or all zeros) */
+static inline vfloat vselect (vint mask, vfloat a, vfloat b)
+{
+  return (vfloat) (((vint) a & mask) | ((vint) b & ~mask));
+}
+
+static vfloat my_sin_v (vfloat x)
+{
+  vfloat q, t, u, y;
+  vint quadrant;
+  /* my_rint(): my_floor() truncates */
+  y = x * 6.36619772e-1f;
+  t = __builtin_convertvector (__builtin_convertvector (vselect (y < 0.0f, -y, y) + 0.5f, vint), vfloat);
+  q = vselect (y < 0.0f, -t, t);
+  quadrant = __builtin_convertvector (q, vint);
+  t = x - q * 1.5703125f;
+  t = t - q * 4.83826794897e-4f;
+  u = t * t;
+  t = vselect ((quadrant & 1) != 0, COS_CORE_POLY (u), t * SIN_CORE_POLY (u));
+  return vselect ((quadrant & 2) != 0, -t, t);
+}
+#endif
+
+void my_sin_n (const float *in, float *out, int n)
+{
+  int i = 0;
+#ifdef MY_MATH_LANES
+  for (; i + MY_MATH_LANES <= n; i += MY_MATH_LANES)
+  {
+    vfloat x;
+    __builtin_memcpy (&x, in + i, sizeof x);
+    x = my_sin_v (x);
+    __builtin_memcpy (out + i, &x, sizeof x);
+  }
+#endif
+  for (; i < n; i++)
+    out[i] = my_sin (in[i]);
+}
+
+void my_cos_n (const float *in, float *out, int n)
+{
+  int i = 0;
+#ifdef MY_MATH_LANES
+  for (; i + MY_MATH_LANES <= n; i += MY_MATH_LANES)
+  {
+    vfloat x;
+    __builtin_memcpy (&x, in + i, sizeof x);
+    x = my_sin_v (x + 1.57079633f);
+    __builtin_memcpy (out + i, &x, sizeof x);
+  }
+#endif
+  for (; i < n; i++)
+    out[i] = my_cos (in[i]);
 }
 
-/* relative error < 2e-11 on [-1, 1] */
+/* kernel rel. error ~= 5e-7; for |x| > 0.5625 my_sqrt() dominates (abs. error ~= 1.5e-3) */
 float my_acos (float x)
 {
   float xa, t;
@@ -120,18 +181,18 @@ float my_acos (float x)
    * arccos(x) = pi/2 - arcsin(x)
    * arccos(x) = 2 * arcsin (sqrt ((1-x) / 2))
    */
-  if (xa > 0.5625) {
-    t = 2.0 * asin_core (my_sqrt (0.5 * (1.0 - xa)));
+  if (xa > 0.5625f) {
+    t = 2.0f * asin_core (my_sqrt (0.5f * (1.0f - xa)));
   } else {
-    t = 1.5707963267948966 - asin_core (xa);
+    t = 1.57079633f - asin_core (xa);
   }
   /* arccos (-x) = pi - arccos(x) */
-  return (x < 0.0) ? (3.1415926535897932 - t) : t;
+  return (x < 0.0f) ? (3.14159265f - t) : t;
 }
 
 float my_asin (float x)
 {
-  return (M_PI/2) - my_acos(x);
+  return 1.57079633f - my_acos(x);
 }
 
 float my_tan(float x)
@@ -20,4 +20,8 @@ float my_cos(float x);
 float my_acos (float x);
 float my_asin (float x);
 float my_tan(float x);
-float my_max(float x, float y);
\ No newline at end of file
+float my_max(float x, float y);
+
+//  Batched my_sin() / my_cos(): out[i] = f(in[i]) for 0 <= i < n.  out may alias in.
+void my_sin_n (const float *in, float *out, int n);
+void my_cos_n (const float *in, float *out, int n);
@@ -0,0 +1,73 @@
+/**
+ *  @file
+ *  
+ *  Minimax polynomial coefficients for the trig kernels in my_math.c.
+ *  
+ *  GENERATED by tools/gen_trig_coeffs.py -- do not edit by hand.
+ *  Re-run the tool to change the accuracy target or kernel degrees.
+ *  
+ *  Each kernel is  f(x) = P(x*x)  (cos) or  x * P(x*x)  (sin, asin), with
+ *  P evaluated by Horner's rule in float.  Errors are max relative error
+ *  over the kernel's reduced range: "fit" for the ideal polynomial, "float"
+ *  for float coefficients and float arithmetic as run on the watch.
+ *  Each P is also given as a macro, which my_math.c's vector forms (host
+ *  builds only) evaluate four lanes at a time.
+ *  Cycle counts are estimates (fmul ~40, fadd ~50 soft-float cycles).
+ *  
+ *  Target error: 1.0e-06
+ *  
+ *   cos_core
+ *      deg  terms  fmul fadd  ~cycles   fit err    float err
+ *        1      2     2    1      130   2.27e-03   2.27e-03
+ *        2      3     3    2      220   1.18e-05   1.19e-05
+ *        3      4     4    3      310   3.26e-08   1.56e-07  <==
+ *        4      5     5    4      400   5.61e-11   1.02e-07
+ *        5      6     6    5      490   6.58e-14   1.01e-07
+ *        6      7     7    6      580   3.14e-16   1.01e-07
+ *  
+ *   sin_core
+ *      deg  terms  fmul fadd  ~cycles   fit err    float err
+ *        1      2     3    1      170   4.08e-04   4.09e-04
+ *        2      3     4    2      260   1.51e-06   1.62e-06
+ *        3      4     5    3      350   3.24e-09   1.34e-07  <==
+ *        4      5     6    4      440   4.55e-12   1.34e-07
+ *        5      6     7    5      530   4.77e-15   1.34e-07
+ *        6      7     8    6      620   2.42e-16   1.34e-07
+ *  
+ *   asin_core
+ *      deg  terms  fmul fadd  ~cycles   fit err    float err
+ *        1      2     3    1      170   1.26e-03   1.26e-03
+ *        2      3     4    2      260   7.02e-05   7.03e-05
+ *        3      4     5    3      350   4.50e-06   4.65e-06
+ *        4      5     6    4      440   3.12e-07   5.07e-07  <==
+ *        5      6     7    5      530   2.29e-08   2.07e-07
+ *        6      7     8    6      620   1.74e-09   1.63e-07
+ *  
+ */
+
+#pragma once
+
+
+///  cos_core on [-0.785398, 0.785398]: degree 3 in x*x, float rel. err. ~= 1.6e-07
+#define COS_CORE_POLY(u)  (9.999999404e-01f + (u) * (-4.999984205e-01f + (u) * (4.165441915e-02f + (u) * (-1.357940375e-03f))))
+
+static inline float cos_core_poly (float u)
+{
+  return COS_CORE_POLY (u);
+}
+
+///  sin_core on [-0.785398, 0.785398]: degree 3 in x*x, float rel. err. ~= 1.3e-07
+#define SIN_CORE_POLY(u)  (1.000000000e+00f + (u) * (-1.666665077e-01f + (u) * (8.332016878e-03f + (u) * (-1.950182195e-04f))))
+
+static inline float sin_core_poly (float u)
+{
+  return SIN_CORE_POLY (u);
+}
+
+///  asin_core on [0, 0.5625]: degree 4 in x*x, float rel. err. ~= 5.1e-07
+#define ASIN_CORE_POLY(u)  (1.000000358e+00f + (u) * (1.666194499e-01f + (u) * (7.613074780e-02f + (u) * (3.540231287e-02f + (u) * (5.913481861e-02f)))))
+
+static inline float asin_core_poly (float u)
+{
+  return ASIN_CORE_POLY (u);
+}
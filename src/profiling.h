@@ -0,0 +1,72 @@
+/**
+ *  @file
+ *  
+ *  Millisecond timers for logging how long drawing and set-up stages take.
+ *  Compiled out entirely unless TESTING_ENABLE_PROFILING is set.
+ *  
+ *  Usage:
+ *  
+ *     PROFILE_START(bands);
+ *     ... work ...
+ *     PROFILE_END(bands, "band render");
+ */
+
+#pragma once
+
+#include "pebble.h"
+
+#include "platform.h"
+#include "testing.h"
+
+
+///  Wall clock time in milliseconds, good for differences only.  Always
+///  available, for code that budgets its own running time.
+static inline uint32_t  profile_now_ms(void)
+{
+   time_t   seconds;
+   uint16_t millis;
+
+   time_ms(&seconds, &millis);
+
+   return (uint32_t) seconds * 1000 + millis;
+}
+
+
+#if TESTING_ENABLE_PROFILING
+
+# define PROFILE_START(name)  uint32_t name##StartMs = profile_now_ms()
+
+//  (void) keeps aplite, where MY_APP_LOG() is empty, free of unused warnings.
+# define PROFILE_END(name, pszLabel)                                    \
+   (void) name##StartMs;                                                \
+   MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "%s: %lu ms", pszLabel,              \
+              (unsigned long) (profile_now_ms() - name##StartMs))
+
+///  Log heap use at some point of interest.
+# define PROFILE_HEAP(pszLabel)                                         \
+   MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "%s: heap used %u, free %u", pszLabel, \
+              (unsigned) heap_bytes_used(), (unsigned) heap_bytes_free())
+
+///  Start timing one stage of start up: elapsed time and heap use.
+# define PROFILE_STAGE_START(name)                                      \
+   uint32_t name##StartMs   = profile_now_ms();                         \
+   size_t   name##StartHeap = heap_bytes_used()
+
+///  Log a start up stage's duration and heap delta, and when (relative to
+///  originMs) it finished, building a timeline of start up in the log.
+# define PROFILE_STAGE_END(name, pszLabel, originMs)                    \
+   (void) name##StartMs;  (void) name##StartHeap;                       \
+   MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "startup %s: %lu ms, heap %ld, done at %lu ms", \
+              pszLabel, (unsigned long) (profile_now_ms() - name##StartMs), \
+              (long) heap_bytes_used() - (long) name##StartHeap,        \
+              (unsigned long) (profile_now_ms() - (originMs)))
+
+#else
+
+# define PROFILE_START(name)
+# define PROFILE_END(name, pszLabel)
+# define PROFILE_HEAP(pszLabel)
+# define PROFILE_STAGE_START(name)
+# define PROFILE_STAGE_END(name, pszLabel, originMs)
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ *  @file
+ *
+ *  Heap-driven choice of QualityTier: see quality_tier.h.
+ */
+
+
+#include "pebble.h"
+
+#include "quality_tier.h"
+
+#include "platform.h"
+#include "testing.h"
+
+
+/**
+ *  Estimated heap, in bytes, for what every tier keeps: window, hour hand,
+ *  arena, and the text and hand overlay layer.
+ *
+ *  Like the per-feature figures below, these are rough sums of bitmap,
+ *  layer and font sizes, with margin; they only need to be right to within
+ *  a tier's worth.
+ */
+#ifdef PBL_PLATFORM_APLITE
+//  (the watchface overlay is const data: see watchface_rle.h)
+# define QUALITY_FLOOR_HEAP   2048
+#else
+# define QUALITY_FLOOR_HEAP   3072
+#endif
+
+/**
+ *  Estimated heap for the feature each tier drops, indexed by that tier
+ *  (QUALITY_TIER_FULL drops nothing).  The dial cache figure is a typical
+ *  encoded dial, not DIAL_CACHE_MAX_BYTES (the cache is optional anyway),
+ *  plus about 1K for the time's digit atlas, which goes with it.
+ *  Anti-aliasing costs no heap of ours, and there is none on aplite, where
+ *  its tier (needing no less than the one above) is thus never chosen; it
+ *  is given a little margin on color for the SDK's own use while filling.
+ *  tools/host/quality_tier_check.c prints the resulting thresholds.
+ */
+static const uint16_t  aFeatureHeap[QUALITY_TIER_COUNT] = {
+#ifdef PBL_PLATFORM_APLITE
+   [QUALITY_TIER_NO_DIAL_CACHE] = 3072,
+   [QUALITY_TIER_NO_ANTIALIAS]  = 0,
+   [QUALITY_TIER_SYSTEM_FONTS]  = 1536,
+   //  per-band render state (grey shades are const patterns)
+   [QUALITY_TIER_FLOOR]         = 64,
+#else
+   [QUALITY_TIER_NO_DIAL_CACHE] = 5120,
+   [QUALITY_TIER_NO_ANTIALIAS]  = 512,
+   [QUALITY_TIER_SYSTEM_FONTS]  = 2048,
+   [QUALITY_TIER_FLOOR]         = 512,
+#endif
+};
+
+static const char * const  apszTierNames[QUALITY_TIER_COUNT] = {
+   [QUALITY_TIER_FULL]          = "full",
+   [QUALITY_TIER_NO_DIAL_CACHE] = "no dial cache",
+   [QUALITY_TIER_NO_ANTIALIAS]  = "no anti-aliasing",
+   [QUALITY_TIER_SYSTEM_FONTS]  = "system fonts",
+   [QUALITY_TIER_FLOOR]         = "floor",
+};
+
+
+static QualityTier  eTier = QUALITY_TIER_FULL;
+
+
+size_t  quality_tier_get_min_heap(QualityTier tier)
+{
+
+   size_t  cb = QUALITY_FLOOR_HEAP;
+
+   //  everything the tiers below this one drop, this one keeps
+   for (int iTier = tier + 1;  iTier < QUALITY_TIER_COUNT;  iTier++)
+   {
+      cb += aFeatureHeap[iTier];
+   }
+
+   return cb;
+
+}  /* end of quality_tier_get_min_heap() */
+
+
+QualityTier  quality_tier_choose(size_t cbHeapFree)
+{
+
+#if TESTING_HEAP_BUDGET
+   cbHeapFree = TESTING_HEAP_BUDGET;
+#endif
+
+   //  (below even the floor, the floor it is: it may yet fit)
+   eTier = QUALITY_TIER_FLOOR;
+
+   for (int iTier = QUALITY_TIER_FULL;  iTier < QUALITY_TIER_FLOOR;  iTier++)
+   {
+      if (cbHeapFree >= quality_tier_get_min_heap((QualityTier) iTier))
+      {
+         eTier = (QualityTier) iTier;
+         break;
+      }
+   }
+
+   MY_APP_LOG(APP_LOG_LEVEL_INFO, "quality tier: %s (%u bytes free, %u wanted for full)",
+              apszTierNames[eTier], (unsigned) cbHeapFree,
+              (unsigned) quality_tier_get_min_heap(QUALITY_TIER_FULL));
+
+   return eTier;
+
+}  /* end of quality_tier_choose() */
+
+
+QualityTier  quality_tier_get(void)
+{
+   return eTier;
+}
+
+
+const char *  quality_tier_get_name(QualityTier tier)
+{
+   return ((unsigned) tier < QUALITY_TIER_COUNT) ? apszTierNames[tier] : "?";
+}
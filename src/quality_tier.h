@@ -0,0 +1,84 @@
+/**
+ *  @file
+ *
+ *  How much of the watchface to build, chosen once at window load from the
+ *  heap then free.  Rather than all or nothing (mark_heap_failure()), each
+ *  tier down drops one more optional feature, most expendable first; the
+ *  floor keeps only the night / day split of the dial and the hour hand.
+ *
+ *  A tier whose feature costs no heap on a platform needs just what the
+ *  tier above it does, so is never chosen there: aplite has no
+ *  anti-aliasing to drop, and goes from no dial cache straight to system
+ *  fonts.
+ */
+
+
+#ifndef sunclock_quality_tier_h__
+#define sunclock_quality_tier_h__
+
+
+#include "pebble.h"
+
+
+///  Tiers, best first.  Each drops its feature plus those of all the tiers above.
+typedef enum {
+   QUALITY_TIER_FULL,             ///< everything
+   QUALITY_TIER_NO_DIAL_CACHE,    ///< dial and time text re-rendered each time: see dial_cache.h, digit_atlas.h
+   QUALITY_TIER_NO_ANTIALIAS,     ///< no anti-aliasing (color platforms; never chosen on aplite)
+   QUALITY_TIER_SYSTEM_FONTS,     ///< time and date in system fonts
+   QUALITY_TIER_FLOOR,            ///< no twilight bands nor moon: night / day and hour hand only
+   QUALITY_TIER_COUNT
+} QualityTier;
+
+
+/**
+ *  Choose the best tier whose estimated heap needs fit, and log it.
+ *
+ *  @param cbHeapFree Heap free before the face allocates anything.
+ *                    Overridden by TESTING_HEAP_BUDGET if that is set.
+ *
+ *  @return Tier chosen, also available from quality_tier_get().
+ */
+QualityTier  quality_tier_choose(size_t cbHeapFree);
+
+///  Tier from the last quality_tier_choose(); QUALITY_TIER_FULL before that.
+QualityTier  quality_tier_get(void);
+
+///  Short name of a tier, for logging.
+const char *  quality_tier_get_name(QualityTier tier);
+
+/**
+ *  Least heap, free at window load, with which a tier is chosen.
+ *  Estimates: see quality_tier.c.
+ */
+size_t  quality_tier_get_min_heap(QualityTier tier);
+
+
+static inline bool  quality_has_dial_cache(void)
+{
+   return quality_tier_get() < QUALITY_TIER_NO_DIAL_CACHE;
+}
+
+static inline bool  quality_has_antialiasing(void)
+{
+   return quality_tier_get() < QUALITY_TIER_NO_ANTIALIAS;
+}
+
+static inline bool  quality_has_custom_fonts(void)
+{
+   return quality_tier_get() < QUALITY_TIER_SYSTEM_FONTS;
+}
+
+///  (the moon is drawn, costing no heap of its own, so it goes only at the floor)
+static inline bool  quality_has_moon(void)
+{
+   return quality_tier_get() < QUALITY_TIER_FLOOR;
+}
+
+static inline bool  quality_has_twilight_bands(void)
+{
+   return quality_tier_get() < QUALITY_TIER_FLOOR;
+}
+
+
+#endif  // #ifndef sunclock_quality_tier_h__
@@ -0,0 +1,131 @@
+/**
+ *  @file
+ *
+ *  Run-length encoded overlay masks: see rle_mask.h.
+ */
+
+
+#include "pebble.h"
+
+#include "rle_mask.h"
+
+
+#ifdef PBL_PLATFORM_APLITE
+
+/**
+ *  Set or clear a run of pixels in one frame buffer row.
+ *
+ *  @param pRow Row's first byte.
+ *  @param x0 First pixel.
+ *  @param x1 Last pixel (included).
+ *  @param fWhite Set pixels (white) rather than clear them (black)?
+ *
+ *  @return Bytes written.
+ */
+static size_t  fill_span(uint8_t *pRow, int x0, int x1, bool fWhite)
+{
+
+   int      iFirst = x0 >> 3;
+   int      iLast  = x1 >> 3;
+   uint8_t  maskFirst = (uint8_t) (0xFF << (x0 & 7));
+   uint8_t  maskLast  = (uint8_t) (0xFF >> (7 - (x1 & 7)));
+
+   if (iFirst == iLast)
+   {
+      maskFirst &= maskLast;
+   }
+
+   if (fWhite)
+   {
+      pRow[iFirst] |= maskFirst;
+   }
+   else
+   {
+      pRow[iFirst] &= (uint8_t) ~maskFirst;
+   }
+
+   if (iFirst == iLast)
+   {
+      return 1;
+   }
+
+   if (iLast - iFirst > 1)
+   {
+      memset(pRow + iFirst + 1, fWhite ? 0xFF : 0x00, iLast - iFirst - 1);
+   }
+
+   if (fWhite)
+   {
+      pRow[iLast] |= maskLast;
+   }
+   else
+   {
+      pRow[iLast] &= (uint8_t) ~maskLast;
+   }
+
+   return iLast - iFirst + 1;
+
+}  /* end of fill_span() */
+
+
+size_t  rle_mask_draw(const RleMask *pMask, GContext *ctx, GPoint origin)
+{
+
+   GBitmap * pFrameBuffer = graphics_capture_frame_buffer(ctx);
+
+   if (pFrameBuffer == NULL)
+   {
+      return 0;
+   }
+
+   GRect      bounds = gbitmap_get_bounds(pFrameBuffer);
+   uint8_t  * pData  = gbitmap_get_data(pFrameBuffer);
+   uint16_t   cbRow  = gbitmap_get_bytes_per_row(pFrameBuffer);
+   int        xLeft  = bounds.origin.x;
+   int        xRight = bounds.origin.x + bounds.size.w - 1;
+   size_t     cbWritten = 0;
+
+   const uint8_t * pRun = pMask->pRuns;
+
+   for (int row = 0;  row < pMask->height;  row++)
+   {
+      int   y = origin.y + row;
+      bool  fOnScreen = (y >= bounds.origin.y) && (y < bounds.origin.y + bounds.size.h);
+      uint8_t * pRow = pData + y * cbRow;
+
+      for (int col = 0;  col < pMask->width;  pRun++)
+      {
+         int kind   = *pRun >> RLE_KIND_SHIFT;
+         int length = (*pRun & RLE_LENGTH_MASK) + 1;
+         int x0     = origin.x + col;
+         int x1     = x0 + length - 1;
+
+         col += length;
+
+         if ((kind == RLE_RUN_SKIP) || (! fOnScreen))
+         {
+            continue;
+         }
+
+         if (x0 < xLeft)
+         {
+            x0 = xLeft;
+         }
+         if (x1 > xRight)
+         {
+            x1 = xRight;
+         }
+         if (x0 <= x1)
+         {
+            cbWritten += fill_span(pRow, x0, x1, (kind == RLE_RUN_WHITE));
+         }
+      }
+   }
+
+   graphics_release_frame_buffer(ctx, pFrameBuffer);
+
+   return cbWritten;
+
+}  /* end of rle_mask_draw() */
+
+#endif  // #ifdef PBL_PLATFORM_APLITE
@@ -0,0 +1,56 @@
+/**
+ *  @file
+ *
+ *  Run-length encoded 1-bit overlay masks for aplite: an image of black,
+ *  white and transparent pixels drawn straight into the frame buffer.
+ *  Unlike a "png-trans" resource (a white mask composited with GCompOpOr
+ *  and a black one with GCompOpClear, both full size bitmaps on the heap),
+ *  the mask is const data, and drawing it touches only its opaque runs.
+ *
+ *  Masks are generated from png files by tools/gen_rle_mask.py.  Each row
+ *  is a series of one byte runs, never crossing the row's end: the top two
+ *  bits give the run's kind (RLE_RUN_*), the other six its length less one.
+ */
+
+
+#ifndef sunclock_rle_mask_h__
+#define sunclock_rle_mask_h__
+
+
+#include "pebble.h"
+
+
+///  Run kinds, in a run byte's top bits.
+#define  RLE_RUN_SKIP      0     ///< transparent: leave pixels as they are
+#define  RLE_RUN_BLACK     1
+#define  RLE_RUN_WHITE     2
+
+#define  RLE_KIND_SHIFT    6
+#define  RLE_LENGTH_MASK   ((1 << RLE_KIND_SHIFT) - 1)
+
+
+typedef struct {
+   uint8_t          width;
+   uint8_t          height;
+   const uint8_t  * pRuns;      ///< height rows of runs, each totalling width pixels
+} RleMask;
+
+
+#ifdef PBL_PLATFORM_APLITE
+
+/**
+ *  Draw a mask's opaque pixels into the frame buffer, clipped to it.
+ *
+ *  @param pMask Mask to draw.
+ *  @param ctx Graphics context whose frame buffer we draw to.
+ *  @param origin Screen position of the mask's top left pixel.
+ *
+ *  @return Frame buffer bytes written, for instrumentation; zero if the
+ *          frame buffer was unavailable.
+ */
+size_t  rle_mask_draw(const RleMask *pMask, GContext *ctx, GPoint origin);
+
+#endif
+
+
+#endif  // #ifndef sunclock_rle_mask_h__
@@ -5,6 +5,11 @@
 #include "suncalc.h"
 #include "my_math.h"
 
+
+///  Days per batched trig call in calcSun_n().  Sized for the stack, not speed.
+#define CALC_SUN_CHUNK  8
+
+
 /** 
  *  Given a date and geographical location (lat/long), calculate
  *  rise or set time. Nominally of sun, but may be adjusted to
@@ -143,6 +148,179 @@ float calcSun(int year, int month, int day,
 
 }  /* end of calcSun */
 
+
+/**
+ *  Batched calcSun(), for many days at a time (year tables, validation
+ *  grids): see suncalc.h.  Same steps as calcSun(), with the location and
+ *  zenith terms worked out once, and each trig step run over a chunk of
+ *  days through my_sin_n() / my_cos_n(), which host builds vectorize.  The
+ *  watch only ever needs one day, through calcSun(), and does not call
+ *  this.
+ *
+ *  @param nDays Number of consecutive days, starting at year/month/day, to
+ *                calculate.  Days past the end of the month simply run on
+ *                into the following month(s).
+ *  @param pTimes Receives nDays requested times, each given as UTC hour and
+ *                fraction.  Or NO_RISE_SET_TIME if there is no rise/set for
+ *                this location on that date (i.e., near a pole).
+ *
+ *  Other parameters as for calcSun().
+ */
+void calcSun_n(int year, int month, int day, int nDays,
+               float latitude, float longitude, int sunset, float zenith,
+               float *pTimes)
+{
+
+
+   // 1. first calculate the day of the year
+
+   int N1 = my_floor(275 * month / 9);
+   int N2 = my_floor((month + 9) / 12);  // 1 = after Feb, 0 = not.
+   int N3 = (1 + my_floor((year - 4 * my_floor(year / 4) + 2) / 3));
+   int N = N1 - (N2 * N3) + day - 30;
+
+   // 2. convert the longitude to hour value and calculate an approximate time
+
+   float lngHour = longitude / 15;
+
+   //  Terms of step 7a which depend only on location and zenith, not on date.
+   float cosZenith = my_cos((M_PI / 180.0f) * zenith);
+   float sinLat    = my_sin((M_PI / 180.0f) * latitude);
+   float cosLat    = my_cos((M_PI / 180.0f) * latitude);
+
+   //  Work through the days a chunk at a time, so that each trig step runs
+   //  as one batched call over the chunk.
+   float t[CALC_SUN_CHUNK];
+   float M[CALC_SUN_CHUNK];
+   float L[CALC_SUN_CHUNK];
+   float a[CALC_SUN_CHUNK];
+   float b[CALC_SUN_CHUNK];
+
+   for (int iFirst = 0;  iFirst < nDays;  iFirst += CALC_SUN_CHUNK)
+   {
+      int n = nDays - iFirst;
+      if (n > CALC_SUN_CHUNK)
+      {
+         n = CALC_SUN_CHUNK;
+      }
+
+      int i;
+
+      for (i = 0;  i < n;  i++)
+      {
+         if (!sunset)
+         {
+            //if rising time is desired:
+            t[i] = (N + iFirst + i) + ((6 - lngHour) / 24);
+         }
+         else
+         {
+            //if setting time is desired:
+            t[i] = (N + iFirst + i) + ((18 - lngHour) / 24);
+         }
+
+         // 3. calculate the Sun's mean anomaly
+         M[i] = (0.9856 * t[i]) - 3.289;
+
+         a[i] = (M_PI / 180.0f) * M[i];
+         b[i] = (M_PI / 180.0f) * 2 * M[i];
+      }
+
+      // 4. calculate the Sun's true longitude
+
+      //L = M + (1.916 * sin(M)) + (0.020 * sin(2 * M)) + 282.634
+      my_sin_n(a, a, n);
+      my_sin_n(b, b, n);
+
+      for (i = 0;  i < n;  i++)
+      {
+         L[i] = M[i] + (1.916 * a[i]) + (0.020 * b[i]) + 282.634;
+         if (L[i] < 0) L[i] += 360.0f;
+         if (L[i] > 360) L[i] -= 360.0f;
+
+         a[i] = (M_PI / 180.0f) * L[i];
+      }
+
+      //  sin(L) feeds both the right ascension and the declination.
+      my_cos_n(a, b, n);
+      my_sin_n(a, a, n);
+
+      for (i = 0;  i < n;  i++)
+      {
+         //5a. calculate the Sun's right ascension
+
+         //RA = atan(0.91764 * tan(L))
+         float RA = (180.0f / M_PI) * my_atan(0.91764 * (a[i] / b[i]));
+         if (RA < 0) RA += 360;
+         if (RA > 360) RA -= 360;
+
+         //5b. right ascension value needs to be in the same quadrant as L
+
+         float Lquadrant  = (my_floor(L[i] / 90)) * 90;
+         float RAquadrant = (my_floor(RA / 90)) * 90;
+         RA = RA + (Lquadrant - RAquadrant);
+
+         //5c. right ascension value needs to be converted into hours
+         //    (stashed in L, which we no longer need)
+         L[i] = RA / 15;
+
+         //6. calculate the Sun's declination
+
+         a[i] = 0.39782 * a[i];                  // sinDec
+         b[i] = my_asin(a[i]);
+      }
+
+      my_cos_n(b, b, n);                         // cosDec
+
+      for (i = 0;  i < n;  i++)
+      {
+         //7a. calculate the Sun's local hour angle
+
+         //cosH = (cos(zenith) - (sinDec * sin(latitude))) / (cosDec * cos(latitude))
+         float cosH = (cosZenith - (a[i] * sinLat)) / (b[i] * cosLat);
+
+         if ((cosH > 1) || (cosH < -1))
+         {
+            pTimes[iFirst + i] = NO_RISE_SET_TIME;
+            continue;
+         }
+
+         //7b. finish calculating H and convert into hours
+
+         float H;
+         if (!sunset)
+         {
+            //if rising time is desired:
+            H = 360 - (180.0f / M_PI) * my_acos(cosH);
+         }
+         else
+         {
+            //if setting time is desired:
+            H = (180.0f / M_PI) * my_acos(cosH);
+         }
+
+         H = H / 15;
+
+         //8. calculate local mean time of rising/setting
+         float T = H + L[i] - (0.06571 * t[i]) - 6.622;
+
+         //9. adjust back to UTC
+         float UT = T - lngHour;
+         if (UT < 0)
+         {
+            UT += 24;
+         }
+         if (UT > 24)
+         {
+            UT -= 24;
+         }
+
+         pTimes[iFirst + i] = UT;
+      }
+   }
+
+}  /* end of calcSun_n */
+
 float calcSunRise(int year, int month, int day, float latitude, float longitude, float zenith)
 {
    return calcSun(year, month, day, latitude, longitude, 0, zenith);
@@ -25,5 +25,18 @@
  */
 #define NO_RISE_SET_TIME  ((float) 100.0)  /* (legal values are hours in a day) */
 
+float calcSun(int year, int month, int day,
+              float latitude, float longitude, int sunset, float zenith);
+
+/**
+ *  Batched calcSun(): rise or set times for nDays consecutive days starting
+ *  at year/month/day, written to pTimes[0 .. nDays-1].  Location and zenith
+ *  terms are computed once for the whole run.  Results are calcSun()'s
+ *  exactly; for host tools, as the watch needs only one day at a time.
+ */
+void calcSun_n(int year, int month, int day, int nDays,
+               float latitude, float longitude, int sunset, float zenith,
+               float *pTimes);
+
 float calcSunRise(int year, int month, int day, float latitude, float longitude, float zenith);
 float calcSunSet(int year, int month, int day, float latitude, float longitude, float zenith);
\ No newline at end of file
@@ -12,9 +12,15 @@
 
 #include "pebble.h"
 
+#include "angle_map.h"
+#include "arena.h"
 #include "config.h"
 #include "ConfigData.h"
 #include "dial_mask_path.h"
+#include "DayPlan.h"
+#include "dial_cache.h"
+#include "dial_spans.h"
+#include "face_overlay.h"
 #include "geometry.h"
 #include "helpers.h"
 #include "hour_hand.h"
@@ -22,10 +28,15 @@
 #include "messaging.h"
 #include "my_math.h"
 #include "platform.h"
+#include "profiling.h"
+#include "quality_tier.h"
 #include "suncalc.h"
-#include "TransBitmap.h"
+#include "testing.h"
+#include "tick_scheduler.h"
 #include "TransRotBmp.h"
 #include "TwilightPath.h"
+#include "watchface_rle.h"
+#include "widget_pipeline.h"
 
 
 /// Test whether using a built-in font is smaller than using a (subsetted) resource.
@@ -40,6 +51,44 @@ bool  s_fHeapFailure = false;
 ///  Is watchface's message pump running?  Not true until our first window proc callback.
 bool fMessagePumpRunning = false;
 
+///  Was the active DayPlan restored from flash, and not yet checked by recomputing it?
+static bool  s_fVerifyRestoredPlan = false;
+
+///  Stages of start up after sunclock_window_load(): see handle_startup_timer().
+typedef enum {
+   STARTUP_STAGE_FONTS,
+   STARTUP_STAGE_TEXT,
+   STARTUP_STAGE_DONE
+} StartupStage;
+
+///  Next start up stage to run.
+static StartupStage  s_eStartupStage = STARTUP_STAGE_DONE;
+
+///  Timer running the next start up stage, if one is scheduled.
+static AppTimer *  s_pStartupTimer = NULL;
+
+/**
+ *  Arena for the face's own structures.  With the band fills dithered and
+ *  the hour hand pre-rendered, that is only the four TwilightPaths (48
+ *  bytes on aplite); aplite's hour hand TransRotBmp is back only when
+ *  HOUR_HAND_SPRITE_STEPS is 0.
+ */
+#if defined(PBL_PLATFORM_APLITE) && ! HOUR_HAND_SPRITE_STEPS
+# define SUNCLOCK_ARENA_BYTES  (TWI_PATH_COUNT * ARENA_SIZEOF(TwilightPath) +   \
+                                ARENA_SIZEOF(TransRotBmp))
+#else
+# define SUNCLOCK_ARENA_BYTES  (TWI_PATH_COUNT * ARENA_SIZEOF(TwilightPath))
+#endif
+
+///  Were the custom text fonts loaded (rather than system ones)?
+static bool  s_fCustomTextFonts = false;
+
+#if TESTING_ENABLE_PROFILING
+///  When we started, for timing the first frame showing a day plan.
+static uint32_t  s_startMs = 0;
+static bool      s_fFirstPlanFrameLogged = false;
+#endif
+
 #if HOUR_VIBRATION
 const VibePattern hour_pattern = {
    .durations = (uint32_t[]){ 200, 100, 200, 100, 200 },
@@ -53,14 +102,8 @@ const VibePattern hour_pattern = {
 ///  We use more than one since sometimes the first is lost.
 unsigned cInitialLatLongRequestsRemaining = INITIAL_LAT_LONG_REQUESTS_MAX;
 
-TextLayer *pTextTimeLayer      = 0;
-#ifndef PBL_ROUND
-TextLayer *pTextSunriseLayer   = 0;
-TextLayer *pTextSunsetLayer    = 0;
-TextLayer *pDayOfWeekLayer     = 0;
-#endif
-TextLayer *pMonthLayer         = 0;
-TextLayer *pMoonLayer          = 0;   // moon phase
+///  While showing a provisional location, minutes between further requests.
+#define PROVISIONAL_LAT_LONG_REQUEST_MINUTES  10
 
 ///  Not a real layer, but the layer of the base window.
 ///  This is where our watch "dial" (twilight bands, etc.) is drawn.
@@ -68,7 +111,6 @@ Layer     *pGraphicsNightLayer = 0;
 
 //Make fonts global so we can deinit later
 GFont pFontCurTime  = 0;
-GFont pFontMoon     = 0;
 
 ///  Roboto Condensed 19: "[a-zA-Z, :0-9]" chars only.  Used for face's date text.
 GFont pFontMediumText = 0;
@@ -77,16 +119,6 @@ GFont pFontMediumText = 0;
 GFont pFontSmallText = 0;
 
 
-#ifdef PBL_PLATFORM_APLITE
-/**
- *  Watchface dial: a transparent png which supplies hour marks, a face
- *  outline, and masks everything outside the face to black.  Aside from
- *  the hour marks, the interior of the face is transparent to allow
- *  twilight bands to show through.
- */
-TransBitmap* pTransBmpWatchface = 0;
-#endif
-
 ///  Boundary between night and astronomical twilight.
 TwilightPath* pTwiPathNight = 0;
 
@@ -118,20 +150,131 @@ TwilightPath* pTwiPathCivil = 0;
 bool  is_dark_time(int localHour, int localMinute)
 {
 
-   float localTickTime = (float) localHour + localMinute / 60.0;
+   const DayPlan * pPlan = day_plan_get_active();
 
-   return ((localTickTime < pTwiPathAstro->fDawnTime) ||
-           (localTickTime > pTwiPathAstro->fDuskTime));
+   if (pPlan == NULL)
+   {
+      //  nothing computed yet: dial is all night
+      return true;
+   }
+
+   return day_plan_is_dark_minute(pPlan, localHour * 60 + localMinute);
 
 }  /* end of is_dark_time() */
 
 
+static void  verify_restored_day_plan(void);
+static void  handle_startup_timer(void *pData);
+void updateDayAndNightInfo(bool update_everything);
+
+
+/**
+ *  Render the dial from scratch: twilight bands, then the mask and hour
+ *  marks over them.
+ *
+ *  @param ctx Base layer's graphics context.
+ *  @param layerFrame Base layer's frame.
+ *  @param pPlan Active day plan, or NULL if none yet (dial is all night).
+ */
+static void  draw_dial(GContext *ctx, GRect layerFrame, const DayPlan *pPlan)
+{
+
+   //  With basalt added, this is now even more confusing than before.
+   //  For aplite, the first render carves (fills black) night region
+   //  out of a white screen.
+   //  For basalt, the first render carves (fills astro) astro region
+   //  out of a night-colored screen.
+   //  This difference is because aplite needs to support bitmap draws
+   //  via OR, and relies on the bitmap draws to add twilight "color".
+
+   PROFILE_START(bands);
+
+#ifdef PBL_COLOR
+   graphics_context_set_antialiased(ctx, quality_has_antialiasing());
+#endif
+
+#if ANGLE_MAP_RENDER
+   if ((pPlan != NULL) && angle_map_exists())
+   {
+      //  one table lookup per pixel, straight into the frame buffer
+      angle_map_render(ctx);
+   }
+   else
+#endif
+   {
+#ifdef PBL_ROUND
+      //  bands are dial sectors, so only the dial itself needs a night base
+      graphics_context_set_fill_color(ctx, TWI_COLOR_NIGHT);
+      graphics_fill_radial(ctx, twilight_path_dial_rect(layerFrame), GOvalScaleModeFitCircle,
+                           USABLE_FACE_RADIUS, 0, TRIG_MAX_ANGLE);
+#elif defined(PBL_COLOR)
+      graphics_context_set_fill_color(ctx, TWI_COLOR_NIGHT);
+      graphics_fill_rect(ctx, layerFrame, 1, 0);
+#endif
+
+      //  (with no plan yet, e.g. no location, the dial is left as night)
+      if (pPlan != NULL)
+      {
+         //  aplite: start out with white screen, draw full-night black to bottom part
+         //  basalt: start out with night screen, fill all above night with astro
+         //          (or, at the lowest quality tier, with day: no bands follow).
+#ifdef PBL_COLOR
+         GColor colorAboveNight = quality_has_twilight_bands() ? TWI_COLOR_ASTRO
+                                                               : TWI_COLOR_DAYTIME;
+#else
+         GColor colorAboveNight = TWI_COLOR_ASTRO;
+#endif
+         twilight_path_render(pTwiPathNight, &pPlan->aBands[TWI_PATH_NIGHT], ctx,
+                              colorAboveNight, layerFrame);
+      }
+
+      if ((pPlan != NULL) && quality_has_twilight_bands())
+      {
+         //  turn all of white remainder (upper part of screen) into dark grey & then
+         //  turn upper part of screen above astro twilight band back into white
+         twilight_path_render(pTwiPathAstro, &pPlan->aBands[TWI_PATH_ASTRO], ctx,
+                              TWI_COLOR_NAUTICAL, layerFrame);
+
+         //  turn all of white remainder (upper part of screen) into medium grey &
+         //  turn upper part of screen above nautical twilight band back into white
+         twilight_path_render(pTwiPathNautical, &pPlan->aBands[TWI_PATH_NAUTICAL], ctx,
+                              TWI_COLOR_CIVIL, layerFrame);
+
+         //  turn all of white remainder (upper part of screen) into light grey &
+         //  turn upper part of screen above civil twilight band back into white
+         twilight_path_render(pTwiPathCivil, &pPlan->aBands[TWI_PATH_CIVIL], ctx,
+                              TWI_COLOR_DAYTIME, layerFrame);
+      }
+   }
+
+   PROFILE_END(bands, "twilight bands");
+
+   // ------------------------------------------------
+
+   PROFILE_START(mask);
+
+#ifdef PBL_PLATFORM_APLITE
+   //  place tidy watchface frame over accumulated render of twilight bands.
+   //  watchface.png supplies hour marks, a face outline, and masks everything
+   //  outside the face to black; the rest of the face is transparent to let
+   //  the bands show through, so only its opaque runs are drawn.
+   rle_mask_draw(&watchfaceRleMask, ctx, layerFrame.origin);
+#else
+   //  post-aplite we have necessary path primitives to actively mask
+   //  & decorate watchface.  This also supports alternate resolutions.
+   draw_watchface_mask(ctx, layerFrame);
+#endif
+
+   PROFILE_END(mask, "dial mask");
+
+}  /* end of draw_dial() */
+
+
 /**
  *  Handler called when the "night layer" needs redrawing.
  *  
- *  Note that the heavy calculation has been done ahead of time by
- *  \href updateDayAndNightInfo(), so this callback should be a bit
- *  zippier than it otherwise might be.  (Not to say "fast"..)
+ *  All per-day calculation has been done ahead of time into the active
+ *  DayPlan (see \href updateDayAndNightInfo()); we only read from it.
  * 
  * @param me Night layer being updated.
  * @param ctx System-supplied context, presumably already set to defaults
@@ -164,6 +307,8 @@ void graphics_night_layer_update_callback(Layer *me, GContext *ctx)
    if (! config_data_location_avail())
    {
       //  Probably initial program run: no config data persisted yet.
+      //  (Only on SDK 2: later SDKs start from a provisional location
+      //  estimated from the watch's timezone, so go straight to the dial.)
       //  Put up a special window informing the user of this.
       message_window_show_status ("Getting Location",
                                   "Obtaining initial location data.");
@@ -184,51 +329,55 @@ void graphics_night_layer_update_callback(Layer *me, GContext *ctx)
    //  GRect(0, 0, 144, 168)
    //not equal to layerFrame?
 
-   // ------------------------------------------------
+   const DayPlan * pPlan = day_plan_get_active();
 
-   //  With basalt added, this is now even more confusing than before.
-   //  For aplite, the first render carves (fills black) night region
-   //  out of a white screen.
-   //  For basalt, the first render carves (fills astro) astro region
-   //  out of a night-colored screen.
-   //  This difference is because aplite needs to support bitmap draws
-   //  via OR, and relies on the bitmap draws to add twilight "color".
-
-#ifdef PBL_COLOR
-   graphics_context_set_fill_color(ctx, TWI_COLOR_NIGHT);
-   graphics_fill_rect(ctx, layerFrame, 1, 0);
+#if DIAL_CACHE_RENDER
+   PROFILE_START(cache);
+   //  (never captured below the tier keeping it, so never drawn either)
+   if ((pPlan != NULL) && dial_cache_draw(ctx))
+   {
+      PROFILE_END(cache, "dial cache blit");
+   }
+   else
 #endif
+   {
+      draw_dial(ctx, layerFrame, pPlan);
 
-   //  aplite: start out with white screen, draw full-night black to bottom part
-   //  basalt: start out with night screen, fill all above night with astro.
-   twilight_path_render(pTwiPathNight, ctx, TWI_COLOR_ASTRO, layerFrame);
-
-   //  turn all of white remainder (upper part of screen) into dark grey & then
-   //  turn upper part of screen above astro twilight band back into white
-   twilight_path_render(pTwiPathAstro, ctx, TWI_COLOR_NAUTICAL, layerFrame);
-
-   //  turn all of white remainder (upper part of screen) into medium grey &
-   //  turn upper part of screen above nautical twilight band back into white
-   twilight_path_render(pTwiPathNautical, ctx, TWI_COLOR_CIVIL, layerFrame);
-
-   //  turn all of white remainder (upper part of screen) into light grey &
-   //  turn upper part of screen above civil twilight band back into white
-   twilight_path_render(pTwiPathCivil, ctx, TWI_COLOR_DAYTIME, layerFrame);
-
-   // ------------------------------------------------
-
-#ifdef PBL_PLATFORM_APLITE
-   //  place tidy watchface frame over accumulated render of twilight bands:
-   transbitmap_draw_in_rect(pTransBmpWatchface, ctx, layerFrame);
-#else
-   //  post-aplite we have necessary path primitives to actively mask
-   //  & decorate watchface.  This also supports alternate resolutions.
-   draw_watchface_mask(ctx, layerFrame);
+#if DIAL_CACHE_RENDER
+      //  (nothing worth keeping until there's a plan)
+      if ((pPlan != NULL) && quality_has_dial_cache())
+      {
+         dial_cache_capture(ctx);
+      }
 #endif
+   }
 
    //  not clear why this is done: perhaps the system needs it?
    graphics_context_set_compositing_mode(ctx, GCompOpAssign);
 
+#if TESTING_ENABLE_PROFILING
+   if ((pPlan != NULL) && ! s_fFirstPlanFrameLogged)
+   {
+      s_fFirstPlanFrameLogged = true;
+      MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "first correct frame: %lu ms from init (%s start)",
+                 (unsigned long) (profile_now_ms() - s_startMs),
+                 s_fVerifyRestoredPlan ? "warm" : "cold");
+   }
+#endif
+
+   if ((s_eStartupStage < STARTUP_STAGE_DONE) && (s_pStartupTimer == NULL))
+   {
+      //  face is up: on with the rest of start up
+      s_pStartupTimer = app_timer_register(0, handle_startup_timer, NULL);
+   }
+
+   if (s_fVerifyRestoredPlan)
+   {
+      //  face is up: now check the restored plan, in the background
+      s_fVerifyRestoredPlan = false;
+      verify_restored_day_plan();
+   }
+
    return;
 
 }  /* end of graphics_night_layer_update_callback() */
@@ -238,164 +387,391 @@ float get24HourAngle(int hours, int minutes)
    return (12.0f + hours + (minutes / 60.0f)) / 24.0f;
 }
 
-/** 
- *  Given a presumably UTC time, return the astronomical julian day.
- *  This is not day-of-year, but a much larger value.
- * 
- *  @param timeUTC UTC time, unpacked.
- */ 
-int tm2jd(struct tm *timeUTC)
+/**
+ *  A new DayPlan is active: have everything computed from it updated.
+ */
+static void  show_active_day_plan(void)
 {
-   int y, m, d, a, b, c, e, f;
-   y = timeUTC->tm_year + 1900;
-   m = timeUTC->tm_mon + 1;
-   d = timeUTC->tm_mday;
-   if (m < 3)
-   {
-      m += 12;
-      y -= 1;
-   }
-   a = y / 100;
-   b = a / 4;
-   c = 2 - a + b;
-   e = 365.25 * (y + 4716);
-   f = 30.6001 * (m + 1);
-   return c + d + e + f - 1524;
-}
 
+   //  band boundaries have moved, so the hour hand's next day / night change has too
+   tick_scheduler_invalidate(TICK_EVENT_BIT(TICK_EVENT_BAND_CHANGE));
 
-int moon_phase(int jdn)
-{
-   double jd;
-   jd = jdn - 2451550.1;
-   jd /= 29.530588853;
-   jd -= (int)jd;
-   return (int)(jd * 27 + 0.5); // scale fraction from 0-27 and round by adding 0.5
-}
+   time_t timeNow = time(NULL);
+   widget_pipeline_inputs_changed(WIDGET_INPUT_BIT(WIDGET_INPUT_PLAN), localtime(&timeNow));
+
+}  /* end of show_active_day_plan() */
 
 
 /**
- *  Update lunar phase.  Intended to be called once per day.
+ *  Spare DayPlan, built for today, is ready: put it on screen.
  */
-void DisplayCurrentLunarPhase()
+static void  handle_day_plan_ready(void)
 {
 
-   static char moon[] = "m";
-   int moonphase_number = 0;
+   day_plan_swap();
 
-   // moon
-   time_t timeNow;
-   timeNow = time(NULL);
-   moonphase_number = moon_phase(tm2jd(gmtime(&timeNow)));
-   // correct for southern hemisphere
-   if ((moonphase_number > 0) && (config_data_get_latitude() < 0))
-      moonphase_number = 28 - moonphase_number;
+   show_active_day_plan();
 
-   // select correct font char
-   if (moonphase_number == 14)
-   {
-      moon[0] = (unsigned char)(48);
-   } else if (moonphase_number == 0)
-   {
-      moon[0] = (unsigned char)(49);
-   } else if (moonphase_number < 14)
+   //  so that a restart today can show it straight away
+   day_plan_save_active();
+
+}  /* end of handle_day_plan_ready() */
+
+
+/**
+ *  Recomputed today's plan, to check the one restored from flash: only if
+ *  they differ does the new one need showing.
+ */
+static void  handle_restored_plan_checked(void)
+{
+
+   if (day_plan_spare_matches_active())
    {
-      moon[0] = (unsigned char)(moonphase_number + 96);
-   } else
+      MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "restored day plan verified");
+      day_plan_discard_spare();
+   }
+   else
    {
-      moon[0] = (unsigned char)(moonphase_number + 95);
+      MY_APP_LOG(APP_LOG_LEVEL_WARNING, "restored day plan differs, replacing");
+      handle_day_plan_ready();
    }
-//    moon[0] = (unsigned char)(moonphase_number);
 
-   text_layer_set_text(pMoonLayer, moon);
+   //  the check took the spare, and any build of tomorrow's plan with it:
+   //  start that again if it's late enough
+   updateDayAndNightInfo(false);
+
+}  /* end of handle_restored_plan_checked() */
+
+
+/**
+ *  Start recomputing the active plan, restored from flash, in the
+ *  background, unless something else is already replacing it.  This
+ *  abandons a build of tomorrow's plan already under way (the load tick
+ *  starts one after DAY_PLAN_PREPARE_MINUTE), which
+ *  handle_restored_plan_checked() then starts again.
+ */
+static void  verify_restored_day_plan(void)
+{
+
+   time_t timeNow = time(NULL);
+   struct tm tmNowLocal = *(localtime(&timeNow));
 
-}  /* end of DisplayCurrentLunarPhase */
+   if (day_plan_is_for(day_plan_get_active(), &tmNowLocal) &&
+       ! day_plan_build_pending_for(&tmNowLocal))
+   {
+      day_plan_build_spare_async(&tmNowLocal, handle_restored_plan_checked);
+   }
+
+}  /* end of verify_restored_day_plan() */
 
 
 /**
- *  Calculate sunrise, sunset, and all corresponding twilight
- *  times for current day.
+ *  Keep the active DayPlan current: sunrise, sunset, all corresponding
+ *  twilight times, and the rest of the per-day display.
  *  
- *  This only needs to be called once a day (aside from startup time).
+ *  Plans are built a slice at a time from timer callbacks, so this returns
+ *  quickly and the screen keeps showing the previous plan until the new one
+ *  is complete.  Only when there is no plan at all yet is one built on the
+ *  spot.  Late each evening the next day's plan is built into the spare
+ *  buffer, so that at midnight we need only swap it in.  Otherwise this does
+ *  nothing unless the day has changed or update_everything is set.
  * 
- * @param update_everything True to update everything. False to
- *                          only update when the day has
- *                          changed.
+ * @param update_everything True to rebuild today's plan, e.g. because
+ *                          location or time zone changed. False to only
+ *                          update when the day has changed.
  */
 void updateDayAndNightInfo(bool update_everything)
 {
-#ifndef PBL_ROUND
-   static char sunrise_text[] = "00:00";
-   static char sunset_text[] = "00:00";
-#endif
-
-   ///  Localtime mday of most recent completed day/night update.
-   ///  This means we normally update just after midnight, which
-   ///  seems a good time.
-   static short lastUpdateDay = -1;
-
 
    time_t timeNow;
    timeNow = time(NULL);
    struct tm tmNowLocal = *(localtime(&timeNow));
 
-   if ((lastUpdateDay == tmNowLocal.tm_mday) && !update_everything)
+   if (update_everything)
    {
+      //  any plan prepared (or being prepared) used stale location / tz data
+      day_plan_discard_spare();
+   }
+   else if (day_plan_is_for(day_plan_get_active(), &tmNowLocal))
+   {
+      //  today's plan is in place: prepare tomorrow's, if it's late enough
+      if (tmNowLocal.tm_hour * 60 + tmNowLocal.tm_min >= DAY_PLAN_PREPARE_MINUTE)
+      {
+         time_t timeTomorrow = timeNow + SECONDS_PER_DAY;
+         struct tm tmTomorrowLocal = *(localtime(&timeTomorrow));
+
+         //  (but not at the expense of a rebuild of today's, e.g. for a new location)
+         if ((! day_plan_spare_is_for(&tmTomorrowLocal)) &&
+             (! day_plan_build_pending_for(&tmTomorrowLocal)) &&
+             (! day_plan_build_pending_for(&tmNowLocal)))
+         {
+            day_plan_build_spare_async(&tmTomorrowLocal, NULL);
+         }
+      }
       return;
    }
 
-   twilight_path_compute_current(pTwiPathNight,    &tmNowLocal);
-   twilight_path_compute_current(pTwiPathAstro,    &tmNowLocal);
-   twilight_path_compute_current(pTwiPathNautical, &tmNowLocal);
-   twilight_path_compute_current(pTwiPathCivil,    &tmNowLocal);
+   if (day_plan_spare_is_for(&tmNowLocal))
+   {
+      //  new day, and we prepared for it
+      handle_day_plan_ready();
+   }
+   else if (day_plan_get_active() == NULL)
+   {
+      //  nothing to show meanwhile, so don't keep the user waiting
+      day_plan_build_spare(&tmNowLocal);
+      handle_day_plan_ready();
+   }
+   else if (! day_plan_build_pending_for(&tmNowLocal))
+   {
+      day_plan_build_spare_async(&tmNowLocal, handle_day_plan_ready);
+   }
+
+}  /* end of updateDayAndNightInfo() */
+
+
+// ------------------------------------------------
+//  Widgets: each recomputes one thing on screen, when its inputs change.
+
+///  Day plan: not drawn itself, but produces WIDGET_INPUT_PLAN.
+static void  update_day_plan_widget(WidgetInputMask changed, const struct tm *pLocalTime)
+{
+
+   (void) pLocalTime;
+
+   updateDayAndNightInfo((changed & (WIDGET_INPUT_BIT(WIDGET_INPUT_LOCATION) |
+                                     WIDGET_INPUT_BIT(WIDGET_INPUT_TZ) |
+                                     WIDGET_INPUT_BIT(WIDGET_INPUT_HEMISPHERE))) != 0);
+
+}  /* end of update_day_plan_widget() */
+
+
+static void  update_time_widget(WidgetInputMask changed, const struct tm *pLocalTime)
+{
+
+   char time_text[] = "00:00";
+
+   (void) changed;
+   (void) pLocalTime;
+
+   clock_copy_time_string(time_text, sizeof(time_text));
+   if (!clock_is_24h_style() && (time_text[0] == '0'))
+   {
+      memmove(time_text, &time_text[1], sizeof(time_text) - 1);
+   }
+
+   face_overlay_set_text(OVERLAY_TIME, time_text);
+
+}  /* end of update_time_widget() */
+
 
 #ifndef PBL_ROUND
+static void  update_day_of_week_widget(WidgetInputMask changed, const struct tm *pLocalTime)
+{
+
+   char dow_text[] = "xxx";
 
-   //  Want the user's default time format, but not for the current time.
-   //  We can't use clock_copy_time_string(), so make an equivalent format:
-   char *time_format;
+   (void) changed;
+
+   strftime(dow_text, sizeof(dow_text), "%a", pLocalTime);
+   face_overlay_set_text(OVERLAY_WEEKDAY, dow_text);
+
+}  /* end of update_day_of_week_widget() */
+#endif
 
-   if (clock_is_24h_style())
+
+static void  update_date_widget(WidgetInputMask changed, const struct tm *pLocalTime)
+{
+
+   char mon_text[OVERLAY_TEXT_SIZE];
+
+   (void) changed;
+
+   //  a leading '~' marks a dial drawn for an estimated location
+   if (config_data_location_is_provisional())
    {
-      time_format = "%R";
-   } else
+      mon_text[0] = '~';
+      strftime(mon_text + 1, sizeof(mon_text) - 1, "%b %e, %Y", pLocalTime);
+   }
+   else
    {
-      time_format = "%l:%M";
+      strftime(mon_text, sizeof(mon_text), "%b %e, %Y", pLocalTime);
    }
+   face_overlay_set_text(OVERLAY_DATE, mon_text);
 
-   float sunriseTime = pTwiPathCivil->fDawnTime;
-   float sunsetTime  = pTwiPathCivil->fDuskTime;
+}  /* end of update_date_widget() */
 
-   //BUGBUG - need to round this
-   tmNowLocal.tm_min = (int)(60 * (sunriseTime - ((int)(sunriseTime))));
-   tmNowLocal.tm_hour = (int)sunriseTime;
-   strftime(sunrise_text, sizeof(sunrise_text), time_format, &tmNowLocal);
-   text_layer_set_text(pTextSunriseLayer, sunrise_text);
 
-   tmNowLocal.tm_min = (int)(60 * (sunsetTime - ((int)(sunsetTime))));
-   tmNowLocal.tm_hour = (int)sunsetTime;
-   strftime(sunset_text, sizeof(sunset_text), time_format, &tmNowLocal);
-   text_layer_set_text(pTextSunsetLayer, sunset_text);
-   text_layer_set_text_alignment(pTextSunsetLayer, GTextAlignmentRight);
+static void  update_moon_widget(WidgetInputMask changed, const struct tm *pLocalTime)
+{
+
+   (void) changed;
+   (void) pLocalTime;
+
+   //  (the overlay draws it straight from the new plan)
+   face_overlay_mark_dirty(OVERLAY_MOON);
+
+}  /* end of update_moon_widget() */
+
+
+#ifndef PBL_ROUND
+static void  update_sun_times_widget(WidgetInputMask changed, const struct tm *pLocalTime)
+{
+
+   const DayPlan * pPlan = day_plan_get_active();
+
+   (void) changed;
+   (void) pLocalTime;
+
+   if (pPlan == NULL)
+   {
+      return;
+   }
+
+   face_overlay_set_text(OVERLAY_SUNRISE, pPlan->szSunrise);
+   face_overlay_set_text(OVERLAY_SUNSET, pPlan->szSunset);
 
-#endif  // #ifndef PBL_ROUND
+}  /* end of update_sun_times_widget() */
+#endif
 
-   DisplayCurrentLunarPhase();
 
-   lastUpdateDay = tmNowLocal.tm_mday;
+static void  update_hour_hand_widget(WidgetInputMask changed, const struct tm *pLocalTime)
+{
 
-   //  other layers should take care of themselves, but make sure our base
+   (void) changed;
+
+   int32_t hour_angle = TRIG_MAX_ANGLE * get24HourAngle(pLocalTime->tm_hour,
+                                                        pLocalTime->tm_min);
+
+   if (hour_hand_set_angle(hour_angle))
+   {
+      face_overlay_mark_dirty(OVERLAY_HAND);
+   }
+
+}  /* end of update_hour_hand_widget() */
+
+
+#if HOUR_HAND_USE_PATH
+static void  update_hand_shade_widget(WidgetInputMask changed, const struct tm *pLocalTime)
+{
+
+   (void) changed;
+
+   //  set hour hand's appearance based on whether it is over the night
+   //  part of the background
+   if (hour_hand_set_is_night(is_dark_time(pLocalTime->tm_hour, pLocalTime->tm_min)))
+   {
+      face_overlay_mark_dirty(OVERLAY_HAND);
+   }
+
+}  /* end of update_hand_shade_widget() */
+
+
+static void  update_hub_widget(WidgetInputMask changed, const struct tm *pLocalTime)
+{
+
+   (void) changed;
+   (void) pLocalTime;
+
+   if (hour_hand_set_battery(battery_state_service_peek()))
+   {
+      face_overlay_mark_dirty(OVERLAY_HAND);
+   }
+
+}  /* end of update_hub_widget() */
+#endif
+
+
+static void  update_dial_widget(WidgetInputMask changed, const struct tm *pLocalTime)
+{
+
+   (void) changed;
+   (void) pLocalTime;
+
+#if ANGLE_MAP_RENDER
+   {
+      const DayPlan * pPlan = day_plan_get_active();
+
+      //  same paths, colors, and order as graphics_night_layer_update_callback()
+      TwilightPath * const apPaths[] = { pTwiPathNight, pTwiPathAstro,
+                                         pTwiPathNautical, pTwiPathCivil };
+      const GColor aColors[] = { TWI_COLOR_ASTRO, TWI_COLOR_NAUTICAL,
+                                 TWI_COLOR_CIVIL, TWI_COLOR_DAYTIME };
+#ifdef PBL_COLOR
+      angle_map_set_bands(apPaths, pPlan->aBands, aColors, TWI_PATH_COUNT, TWI_COLOR_NIGHT);
+#else
+      angle_map_set_bands(apPaths, pPlan->aBands, aColors, TWI_PATH_COUNT, GColorWhite);
+#endif
+   }
+#endif
+
+#if DIAL_CACHE_RENDER
+   //  re-rendered (and re-cached) at the next redraw
+   dial_cache_invalidate();
+#endif
+
+   //  other layers take care of themselves, but make sure our base
    //  "dial" bitmap is updated.
    layer_mark_dirty(pGraphicsNightLayer);
 
-}  /* end of updateDayAndNightInfo() */
+}  /* end of update_dial_widget() */
+
 
+#define  INPUT(name)  WIDGET_INPUT_BIT(WIDGET_INPUT_##name)
 
 /**
- *  Once a minute, update textual time displays, and analog hour hand.
- *  
- *  Also calls out to daily updater, which limits itself to acting
- *  only when due.
+ *  Everything kept up to date by the widget pipeline, with its inputs.
+ *  The day plan comes first, so that widgets sharing an input with it see
+ *  the new plan when it can be built on the spot.
+ */
+static const WidgetDef  aSunclockWidgets[] = {
+   { "plan",     INPUT(DAY) | INPUT(LOCATION) | INPUT(TZ) | INPUT(HEMISPHERE),
+                                                   update_day_plan_widget },
+   { "time",     INPUT(MINUTE) | INPUT(TZ) | INPUT(TEXT_FONTS),
+                                                   update_time_widget },
+#ifndef PBL_ROUND
+   { "weekday",  INPUT(DAY) | INPUT(TZ) | INPUT(TEXT_FONTS),
+                                                   update_day_of_week_widget },
+#endif
+   { "date",     INPUT(DAY) | INPUT(TZ) | INPUT(LOCATION) | INPUT(TEXT_FONTS),
+                                                   update_date_widget },
+   { "moon",     INPUT(PLAN),                      update_moon_widget },
+#ifndef PBL_ROUND
+   { "sun",      INPUT(PLAN) | INPUT(TEXT_FONTS),  update_sun_times_widget },
+#endif
+   { "hand",     INPUT(HAND_POS) | INPUT(TZ),      update_hour_hand_widget },
+#if HOUR_HAND_USE_PATH
+   { "shade",    INPUT(DARKNESS) | INPUT(PLAN) | INPUT(TZ),
+                                                   update_hand_shade_widget },
+   { "hub",      INPUT(BATTERY),                   update_hub_widget },
+#endif
+   { "dial",     INPUT(PLAN),                      update_dial_widget },
+};
+
+#undef INPUT
+
+//  (the pipeline would otherwise drop the widgets past its limit, the dial first)
+_Static_assert(ARRAY_LENGTH(aSunclockWidgets) <= WIDGET_PIPELINE_MAX,
+               "more widgets than WIDGET_PIPELINE_MAX");
+
+
+#if HOUR_HAND_USE_PATH
+static void  handle_battery_state(BatteryChargeState charge)
+{
+
+   (void) charge;
+
+   time_t timeNow = time(NULL);
+   widget_pipeline_inputs_changed(WIDGET_INPUT_BIT(WIDGET_INPUT_BATTERY), localtime(&timeNow));
+
+}  /* end of handle_battery_state() */
+#endif
+
+
+/**
+ *  Once a minute, report whichever widget inputs have changed (see
+ *  tick_scheduler.h): minute, day, hour hand position, hand over dark or
+ *  light dial, and time zone.  Also starts the next day's plan when due.
  * 
  *  @param tick_time The time at which the tick event was triggered.
  *                At least in PebbleOS versions 2 and earlier, this
@@ -415,7 +791,17 @@ static void handle_minute_tick(struct tm *tick_time, TimeUnits units_changed)
       return;
    }
 
+   TickEventMask   due     = tick_scheduler_poll(tick_time);
+   WidgetInputMask changed = 0;
+
 #ifndef PBL_SDK_2
+   if (due & TICK_EVENT_BIT(TICK_EVENT_MIDNIGHT))
+   {
+      //  once a day, really look at the offset rather than trust the prediction
+      config_tz_verify_soon();
+   }
+
+   //  (just a compare, until the predicted DST switch)
    if (config_has_tz_offset_changed())
    {
       // in case change is due to physical relocation (e.g., just landed
@@ -424,12 +810,14 @@ static void handle_minute_tick(struct tm *tick_time, TimeUnits units_changed)
       if (fMessagePumpRunning)
       {
          //  cause graphics_night_layer_update_callback(), whose invocation
-         //  we trigger via updateDayAndNightInfo(), to ask phone for updated
+         //  we trigger via the day plan widget, to ask phone for updated
          //  location info
          cInitialLatLongRequestsRemaining = INITIAL_LAT_LONG_REQUESTS_MAX;
       }
 
-      updateDayAndNightInfo(true /* update_everything */);
+      //  local time of day (maybe even date) has moved: reschedule the lot
+      tick_scheduler_invalidate(TICK_EVENTS_ALL);
+      changed |= WIDGET_INPUT_BIT(WIDGET_INPUT_TZ);
    }
    else if (cInitialLatLongRequestsRemaining > 0)
    {
@@ -438,46 +826,32 @@ static void handle_minute_tick(struct tm *tick_time, TimeUnits units_changed)
       cInitialLatLongRequestsRemaining --;
       app_msg_RequestLatLong();
    }
-#endif
-
-   // Need to be static because they're used by the system later.
-   static char time_text[] = "00:00";
-   static char dow_text[] = "xxx";
-   static char mon_text[14];
-
-   strftime(dow_text, sizeof(dow_text), "%a", tick_time);
-   strftime(mon_text, sizeof(mon_text), "%b %e, %Y", tick_time);
-
-   clock_copy_time_string(time_text, sizeof(time_text));
-   if (!clock_is_24h_style() && (time_text[0] == '0'))
+   else if (config_data_location_is_provisional() &&
+            ((tick_time->tm_min % PROVISIONAL_LAT_LONG_REQUEST_MINUTES) == 0))
    {
-      memmove(time_text, &time_text[1], sizeof(time_text) - 1);
+      //  still on an estimate: keep asking, quietly, now and then
+      app_msg_RequestLatLong();
    }
-
-#ifndef PBL_ROUND
-   text_layer_set_text(pDayOfWeekLayer, dow_text);
 #endif
-   text_layer_set_text(pMonthLayer, mon_text);
-
-   text_layer_set_background_color(pTextTimeLayer, GColorClear);
-   text_layer_set_text(pTextTimeLayer, time_text);
-   text_layer_set_text_alignment(pTextTimeLayer, GTextAlignmentCenter);
-
-   //  update hour hand position
-   int32_t hour_angle = TRIG_MAX_ANGLE * get24HourAngle(tick_time->tm_hour,
-                                                        tick_time->tm_min);
 
-   hour_hand_set_angle(hour_angle);
-
-#if HOUR_HAND_USE_PATH
-   //  set hour hand's appearance based on whether it is over the night
-   //  part of the background
-   hour_hand_set_is_night(is_dark_time(tick_time->tm_hour, tick_time->tm_min));
-#endif
+   if (due & TICK_EVENT_BIT(TICK_EVENT_MIDNIGHT))
+   {
+      changed |= WIDGET_INPUT_BIT(WIDGET_INPUT_DAY);
+   }
+   if (due & TICK_EVENT_BIT(TICK_EVENT_TEXT_MINUTE))
+   {
+      changed |= WIDGET_INPUT_BIT(WIDGET_INPUT_MINUTE);
+   }
+   if (due & TICK_EVENT_BIT(TICK_EVENT_HAND_PIXEL))
+   {
+      changed |= WIDGET_INPUT_BIT(WIDGET_INPUT_HAND_POS);
+   }
+   if (due & TICK_EVENT_BIT(TICK_EVENT_BAND_CHANGE))
+   {
+      changed |= WIDGET_INPUT_BIT(WIDGET_INPUT_DARKNESS);
+   }
 
-   //  oddly we seem to need to explicitly mark our base window layer dirty,
-   //  or else old time values will stack on top each other
-   layer_mark_dirty(pGraphicsNightLayer);
+   widget_pipeline_inputs_changed(changed, tick_time);
 
 // Vibrate Every Hour
 #if HOUR_VIBRATION
@@ -488,7 +862,25 @@ static void handle_minute_tick(struct tm *tick_time, TimeUnits units_changed)
    }
 #endif
 
-   updateDayAndNightInfo(false);
+   if ((due & TICK_EVENT_BIT(TICK_EVENT_PLAN_PREPARE)) &&
+       ! (changed & WIDGET_INPUT_BIT(WIDGET_INPUT_DAY)))
+   {
+      //  (the day plan widget has already run, if the day changed)
+      updateDayAndNightInfo(false);
+   }
+
+#if TESTING_ENABLE_PROFILING
+   if (due & TICK_EVENT_BIT(TICK_EVENT_MIDNIGHT))
+   {
+      MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "ticks %lu: text %lu, hand %lu, band %lu",
+                 (unsigned long) tick_scheduler_get_tick_count(),
+                 (unsigned long) tick_scheduler_get_count(TICK_EVENT_TEXT_MINUTE),
+                 (unsigned long) tick_scheduler_get_count(TICK_EVENT_HAND_PIXEL),
+                 (unsigned long) tick_scheduler_get_count(TICK_EVENT_BAND_CHANGE));
+      widget_pipeline_log_counts();
+      face_overlay_log_counts();
+   }
+#endif
 
 }  /* end of handle_minute_tick() */
 
@@ -496,26 +888,22 @@ static void handle_minute_tick(struct tm *tick_time, TimeUnits units_changed)
 static void  sunclock_window_free_all_memory()
 {
 
+   if (s_pStartupTimer != NULL)
+   {
+      app_timer_cancel(s_pStartupTimer);
+      s_pStartupTimer = NULL;
+   }
 
    tick_timer_service_unsubscribe();
-
-#ifndef PBL_ROUND
-   SAFE_DESTROY(text_layer, pTextSunsetLayer);
-   SAFE_DESTROY(text_layer, pTextSunriseLayer);
-   SAFE_DESTROY(text_layer, pDayOfWeekLayer);
+#if HOUR_HAND_USE_PATH
+   battery_state_service_unsubscribe();
 #endif
-   SAFE_DESTROY(text_layer, pMonthLayer);
-   SAFE_DESTROY(text_layer, pMoonLayer);
-   SAFE_DESTROY(text_layer, pTextTimeLayer);
+
+   face_overlay_destroy();
 
    //  actually our main window's base layer, so don't nuke it.
 //   SAFE_DESTROY(layer,      pGraphicsNightLayer);
 
-#ifdef PBL_PLATFORM_APLITE
-   transbitmap_destroy(pTransBmpWatchface);
-   pTransBmpWatchface = 0;
-#endif
-
    hour_hand_deinit();
 
    SAFE_DESTROY(twilight_path, pTwiPathNight);
@@ -523,6 +911,19 @@ static void  sunclock_window_free_all_memory()
    SAFE_DESTROY(twilight_path, pTwiPathNautical);
    SAFE_DESTROY(twilight_path, pTwiPathCivil);
 
+   day_plan_cancel_build();
+
+#if ANGLE_MAP_RENDER
+   angle_map_destroy();
+#endif
+
+#if DIAL_CACHE_RENDER
+   dial_cache_destroy();
+#endif
+
+   //  (last: everything above that lived in it is gone)
+   arena_destroy();
+
 }  /* end of sunclock_window_free_all_memory() */
 
 
@@ -543,16 +944,20 @@ void  mark_heap_failure()
 }
 
 /**
- *  Do GUI layout for already-created window, and cache all needed resources.
- *  Also register a tick handler, initialize watch/phone messaging, and request
- *  current location data from the phone.
+ *  Load the custom fonts: a start up stage.
  */
-static void  sunclock_window_load(Window * pMyWindow) 
+static void  startup_load_fonts(void)
 {
 
-   window_set_background_color(pWindow, GColorWhite);
+   if (! quality_has_custom_fonts())
+   {
+      //  system fonts: nothing to load, or to unload
+      pFontCurTime    = fonts_get_system_font(FONT_KEY_BITHAM_42_MEDIUM_NUMBERS);
+      pFontMediumText = fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD);
+      return;
+   }
 
-   pFontMoon = fonts_load_custom_font(resource_get_handle(RESOURCE_ID_FONT_MOON_PHASES_SUBSET_30));
+   s_fCustomTextFonts = true;
 
 #if USE_FONT_RESOURCE
    pFontCurTime = fonts_load_custom_font(resource_get_handle(RESOURCE_ID_FONT_ROBOTO_CONDENSED_42));
@@ -562,6 +967,103 @@ static void  sunclock_window_load(Window * pMyWindow)
 
    pFontMediumText = fonts_load_custom_font(resource_get_handle(RESOURCE_ID_FONT_ROBOTO_CONDENSED_19));
 
+}  /* end of startup_load_fonts() */
+
+
+/**
+ *  Give the overlay's text items their fonts: a start up stage, after
+ *  startup_load_fonts().
+ */
+static void  startup_set_text_fonts(void)
+{
+
+   face_overlay_set_font(OVERLAY_TIME, pFontCurTime);
+#ifndef PBL_ROUND
+   face_overlay_set_font(OVERLAY_WEEKDAY, pFontMediumText);
+   face_overlay_set_font(OVERLAY_SUNRISE, pFontSmallText);
+   face_overlay_set_font(OVERLAY_SUNSET,  pFontSmallText);
+#endif
+   face_overlay_set_font(OVERLAY_DATE, pFontMediumText);
+
+}  /* end of startup_set_text_fonts() */
+
+
+/**
+ *  Run the next stage of start up, one per event loop turn, so the first
+ *  frame (dial and hand, set up by sunclock_window_load()) isn't held up
+ *  by fonts and text.  Started once that frame is drawn.
+ */
+static void  handle_startup_timer(void *pData)
+{
+
+   (void) pData;
+
+   s_pStartupTimer = NULL;
+
+   if (s_fHeapFailure)
+   {
+      return;
+   }
+
+   switch (s_eStartupStage)
+   {
+      case STARTUP_STAGE_FONTS:
+      {
+         PROFILE_STAGE_START(fonts);
+         startup_load_fonts();
+         PROFILE_STAGE_END(fonts, "fonts", s_startMs);
+         break;
+      }
+
+      case STARTUP_STAGE_TEXT:
+      {
+         PROFILE_STAGE_START(text);
+         startup_set_text_fonts();
+
+         time_t timeNow = time(NULL);
+         widget_pipeline_release(WIDGET_INPUT_BIT(WIDGET_INPUT_TEXT_FONTS), localtime(&timeNow));
+         PROFILE_STAGE_END(text, "text", s_startMs);
+         break;
+      }
+
+      default:
+         return;
+   }
+
+   s_eStartupStage = (StartupStage) (s_eStartupStage + 1);
+
+   if (s_eStartupStage < STARTUP_STAGE_DONE)
+   {
+      s_pStartupTimer = app_timer_register(0, handle_startup_timer, NULL);
+   }
+
+}  /* end of handle_startup_timer() */
+
+
+/**
+ *  Do GUI layout for already-created window, and cache the resources needed
+ *  for the first frame: dial and hour hand.  Fonts and text follow in later
+ *  stages (see handle_startup_timer()).  Also register a tick handler,
+ *  initialize watch/phone messaging, and request current location data from
+ *  the phone.
+ */
+static void  sunclock_window_load(Window * pMyWindow) 
+{
+
+   PROFILE_STAGE_START(dial);
+
+   //  before anything is allocated, decide how much of the face to build
+   quality_tier_choose(heap_bytes_free());
+
+   //  not a heap failure if this fails: allocations just come from the heap
+   if (! arena_create(SUNCLOCK_ARENA_BYTES))
+   {
+      MY_APP_LOG(APP_LOG_LEVEL_WARNING, "no heap for %u byte arena",
+                 (unsigned) SUNCLOCK_ARENA_BYTES);
+   }
+
+   window_set_background_color(pWindow, GColorWhite);
+
    //  used for main display on non-round watches, and message window on all watches:
    pFontSmallText = fonts_get_system_font(FONT_KEY_GOTHIC_18);
 
@@ -582,25 +1084,27 @@ static void  sunclock_window_load(Window * pMyWindow)
    layer_set_update_proc(pGraphicsNightLayer, graphics_night_layer_update_callback); 
 
 
-#ifdef PBL_PLATFORM_APLITE
-   pTransBmpWatchface = transbitmap_create_with_resource_prefix(RESOURCE_ID_IMAGE_WATCHFACE);
-   if (pTransBmpWatchface == NULL)
-   {
-      mark_heap_failure();
-      return;
-   }
+#ifndef PBL_PLATFORM_APLITE
+   dial_spans_init();
 #endif
 
    //  Yes, the apparent mismatch between ZENITH_ names and TwilightPath instance
    //  names is intended (if a bit unfortunate).
+   //  All four are kept at every quality tier, as the day plan's bands come
+   //  from them, but the lowest tier leaves out the (aplite) grey shades.
+   const bool fBands = quality_has_twilight_bands();
+
    pTwiPathNight    = twilight_path_create(ZENITH_ASTRONOMICAL, ENCLOSE_SCREEN_BOTTOM,
-                                           TWI_APLITE_RES_ONLY(INVALID_RESOURCE));
+                                           DITHER_NONE);
    pTwiPathAstro    = twilight_path_create(ZENITH_NAUTICAL,     ENCLOSE_SCREEN_TOP,
-                                           TWI_APLITE_RES_ONLY(RESOURCE_ID_IMAGE_DARK_GREY));
+                                           fBands ? TWI_APLITE_SHADE_ONLY(DITHER_DARK_GREY)
+                                                  : DITHER_NONE);
    pTwiPathNautical = twilight_path_create(ZENITH_CIVIL,        ENCLOSE_SCREEN_TOP,
-                                           TWI_APLITE_RES_ONLY(RESOURCE_ID_IMAGE_GREY));
+                                           fBands ? TWI_APLITE_SHADE_ONLY(DITHER_GREY)
+                                                  : DITHER_NONE);
    pTwiPathCivil    = twilight_path_create(ZENITH_OFFICIAL,     ENCLOSE_SCREEN_TOP,
-                                           TWI_APLITE_RES_ONLY(RESOURCE_ID_IMAGE_LIGHT_GREY));
+                                           fBands ? TWI_APLITE_SHADE_ONLY(DITHER_LIGHT_GREY)
+                                                  : DITHER_NONE);
    if ((pTwiPathNight == NULL) || (pTwiPathAstro == NULL) ||
        (pTwiPathNautical == NULL) || (pTwiPathCivil == NULL))
    {
@@ -608,127 +1112,83 @@ static void  sunclock_window_load(Window * pMyWindow)
       return;
    }
 
-   //  time of day text
-   pTextTimeLayer = text_layer_create(GRect(0, TEXT_TIME_Y, DISP_WIDTH, 42));
-   if (pTextTimeLayer == NULL)
    {
-      mark_heap_failure();
-      return;
+      TwilightPath * const apPaths[TWI_PATH_COUNT] = { pTwiPathNight, pTwiPathAstro,
+                                                       pTwiPathNautical, pTwiPathCivil };
+      day_plan_init(apPaths);
    }
-   text_layer_set_text_color(pTextTimeLayer, GColorBlack);
-   text_layer_set_background_color(pTextTimeLayer, GColorClear);
-   text_layer_set_font(pTextTimeLayer, pFontCurTime);
-   layer_add_child(window_get_root_layer(pWindow),
-                   text_layer_get_layer(pTextTimeLayer));
 
-   //  (text grows down, so just make window run all the way to the bottom)
-   pMoonLayer = text_layer_create(GRect(0, TEXT_MOON_Y, DISP_WIDTH, DISP_HEIGHT - TEXT_MOON_Y));
-   if (pMoonLayer == NULL)
+#if ANGLE_MAP_RENDER
+   //  optional, so not a heap failure if we can't have it; like the dial
+   //  cache, it trades heap for drawing time, so goes with that tier
+   if (! quality_has_dial_cache())
    {
-      mark_heap_failure();
-      return;
+      MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "angle map: not at this quality tier");
    }
-   text_layer_set_text_color(pMoonLayer, GColorWhite);
-   text_layer_set_background_color(pMoonLayer, GColorClear);
-   text_layer_set_font(pMoonLayer, pFontMoon);
-   text_layer_set_text_alignment(pMoonLayer, GTextAlignmentCenter);
-   layer_add_child(window_get_root_layer(pWindow),
-                   text_layer_get_layer(pMoonLayer));
-
-   //  Add hour hand after moon phase:  looks weird (wrong) to see phase
-   //  on top of the hour hand.
-   hour_hand_init (pWindow);
-
-   //  Same rectangle used for day of week and date text:
-   //  text alignment avoids conflicts in the two layers.
-   GRect DayDateTextRect;
-   DayDateTextRect = GRect(0, TEXT_DATE_Y, DISP_WIDTH, 127 + 26);
-
-#ifndef PBL_ROUND
-
-   //Day of Week text
-   pDayOfWeekLayer = text_layer_create(DayDateTextRect);
-   if (pDayOfWeekLayer == NULL)
+   else if (angle_map_create())
    {
-      mark_heap_failure();
-      return;
+      MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "angle map: %u bytes",
+                 (unsigned) angle_map_get_size());
    }
-   text_layer_set_text_color(pDayOfWeekLayer, GColorWhite);
-   text_layer_set_background_color(pDayOfWeekLayer, GColorClear);
-   text_layer_set_font(pDayOfWeekLayer, pFontMediumText);
-   text_layer_set_text_alignment(pDayOfWeekLayer, GTextAlignmentLeft);
-   text_layer_set_text(pDayOfWeekLayer, "xxx");
-   layer_add_child(window_get_root_layer(pWindow),
-                   text_layer_get_layer(pDayOfWeekLayer));
-
-#endif  // #ifndef PBL_ROUND
-
-   //Month Text
-   pMonthLayer = text_layer_create(DayDateTextRect);
-   if (pMonthLayer == NULL)
+   else
    {
-      mark_heap_failure();
-      return;
+      MY_APP_LOG(APP_LOG_LEVEL_WARNING, "angle map: no heap, filling band paths");
    }
-#ifndef PBL_ROUND
-   text_layer_set_text_color(pMonthLayer, GColorWhite);
-   text_layer_set_text_alignment(pMonthLayer, GTextAlignmentRight);
-#else
-   text_layer_set_text_color(pMonthLayer, GColorBlack);
-   //  no day-of-week, so center date
-   text_layer_set_text_alignment(pMonthLayer, GTextAlignmentCenter);
+   PROFILE_HEAP("angle map");
 #endif
-   text_layer_set_background_color(pMonthLayer, GColorClear);
-   text_layer_set_font(pMonthLayer, pFontMediumText);
-   text_layer_set_text(pMonthLayer, "xxx");
-   layer_add_child(window_get_root_layer(pWindow),
-                   text_layer_get_layer(pMonthLayer));
-
-#ifndef PBL_ROUND
 
-   //  Same rectangle used for sunrise / sunset text layers: updateDayAndNightInfo()
-   //  changes sunset text to right-aligned.
-   GRect SunRiseSetTextRect;
-   SunRiseSetTextRect = GRect(0, 147, DISP_WIDTH, 30);
+   //  Hand, and (once a later stage of start up has their fonts) text,
+   //  all in the one overlay layer.
+   hour_hand_init (pGraphicsNightLayer);
 
-   pTextSunriseLayer = text_layer_create(SunRiseSetTextRect);
-   if (pTextSunriseLayer == NULL)
+   if (! face_overlay_create(pGraphicsNightLayer))
    {
       mark_heap_failure();
       return;
    }
-   text_layer_set_text_color(pTextSunriseLayer, GColorWhite);
-   text_layer_set_background_color(pTextSunriseLayer, GColorClear);
-   text_layer_set_font(pTextSunriseLayer, pFontSmallText);
-   layer_add_child(window_get_root_layer(pWindow),
-                   text_layer_get_layer(pTextSunriseLayer));
+   PROFILE_HEAP("overlay");
 
-   pTextSunsetLayer = text_layer_create(SunRiseSetTextRect);
-   if (pTextSunsetLayer == NULL)
-   {
-      mark_heap_failure();
-      return;
-   }
-   text_layer_set_text_color(pTextSunsetLayer, GColorWhite);
-   text_layer_set_background_color(pTextSunsetLayer, GColorClear);
-   text_layer_set_font(pTextSunsetLayer, pFontSmallText);
-   layer_add_child(window_get_root_layer(pWindow),
-                   text_layer_get_layer(pTextSunsetLayer));
+   MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "arena: %u of %u bytes used, %u heap fallbacks",
+              (unsigned) arena_get_used(), (unsigned) arena_get_size(),
+              arena_get_fallback_count());
 
-#endif  // #ifndef PBL_ROUND
+   widget_pipeline_init(aSunclockWidgets, ARRAY_LENGTH(aSunclockWidgets));
+
+   //  text widgets wait for their fonts: see handle_startup_timer()
+   widget_pipeline_hold(WIDGET_INPUT_BIT(WIDGET_INPUT_TEXT_FONTS));
+   s_eStartupStage = STARTUP_STAGE_FONTS;
+
+   //  Run initial tick processing before our window displays, so that the
+   //  dial and hand are ready for the first frame.  (A fresh scheduler has
+   //  every update due.)
+   tick_scheduler_init();
 
-   //  Run initial tick processing before our window displays, so that all
-   //  text fields are populated initially.
    time_t timeNow = time(NULL);
    struct tm * pLocalTime = localtime(&timeNow);
 
+   //  Warm start: if we already worked out today's plan for this location,
+   //  show it on the first frame, and only check it once that's up.
+   if (config_data_location_avail() && day_plan_restore(pLocalTime))
+   {
+      s_fVerifyRestoredPlan = true;
+      show_active_day_plan();
+      pLocalTime = localtime(&timeNow);
+   }
+
    handle_minute_tick(pLocalTime, MINUTE_UNIT);
 
+#if HOUR_HAND_USE_PATH
+   widget_pipeline_inputs_changed(WIDGET_INPUT_BIT(WIDGET_INPUT_BATTERY), pLocalTime);
+   battery_state_service_subscribe(handle_battery_state);
+#endif
+
    //  [Don't do location data load until our message pump is running.]
 //   app_msg_RequestLatLong();
 
    tick_timer_service_subscribe(MINUTE_UNIT, handle_minute_tick);
 
+   PROFILE_STAGE_END(dial, "dial", s_startMs);
+
 }  /* end of sunclock_window_load */
 
 
@@ -756,16 +1216,32 @@ void sunclock_coords_recvd(float latitude, float longitude, int32_t utcOffset)
 
    if (config_data_is_different(latitude, longitude, utcOffset))
    {
+      WidgetInputMask changed = WIDGET_INPUT_BIT(WIDGET_INPUT_LOCATION);
+
+      if ((! config_data_location_avail()) ||
+          ((config_data_get_latitude() < 0) != (latitude < 0)))
+      {
+         changed |= WIDGET_INPUT_BIT(WIDGET_INPUT_HEMISPHERE);
+      }
+
       config_data_location_set(latitude, longitude, utcOffset); 
 
+#ifndef PBL_SDK_2
+      //  the phone may well have changed the watch's timezone too
+      config_tz_verify_soon();
+#endif
+
       time_t timeNow = time(NULL);
       struct tm * pLocalTime = localtime(&timeNow);
-      handle_minute_tick(pLocalTime, MINUTE_UNIT);
 
-      //  we likely also need force a full recompute, since handle_minute_tick()'s
-      //  tz check may well not have fired.  Battery, ouch.  But only on initial
-      //  config set from phone.
-      updateDayAndNightInfo(true /* update_everything */);
+      //  New location means a full recompute of the day plan, which the tick
+      //  below (tz check aside) wouldn't ask for.  Battery, ouch.  But only
+      //  on initial config set from phone, or after moving.
+      widget_pipeline_inputs_changed(changed, pLocalTime);
+
+      //  and if we had no location before, no widget has been shown yet
+      tick_scheduler_invalidate(TICK_EVENTS_ALL);
+      handle_minute_tick(pLocalTime, MINUTE_UNIT);
    }
 
 }  /* end of sunclock_coords_recvd */
@@ -778,6 +1254,9 @@ void sunclock_coords_recvd(float latitude, float longitude, int32_t utcOffset)
 void  sunclock_handle_init()
 {
 
+#if TESTING_ENABLE_PROFILING
+   s_startMs = profile_now_ms();
+#endif
 
    pWindow = window_create();
    if (pWindow == NULL)
@@ -826,11 +1305,15 @@ void sunclock_handle_deinit()
    //  Do these here since they're shared with another app window.
    //  The SDK hints that the window unload function might be called
    //  before window destruction, in future SDK releases.
-   fonts_unload_custom_font(pFontMediumText);
-   fonts_unload_custom_font(pFontMoon);
+   //  (not loaded if we exited before that stage of start up, or if the
+   //   quality tier meant system fonts)
+   if (s_fCustomTextFonts)
+   {
+      fonts_unload_custom_font(pFontMediumText);
 #if USE_FONT_RESOURCE
-   fonts_unload_custom_font(pFontCurTime);
+      fonts_unload_custom_font(pFontCurTime);
 #endif
+   }
 
 }  /* end of sunclock_handle_deinit */
 
@@ -17,6 +17,16 @@
 ///  Set to true to force display of low-battery hour hand hub.
 #define  TESTING_SHOW_LOW_BATTERY    0
 
+///  Set true to log timing of drawing and set-up stages (see profiling.h).
+#define  TESTING_ENABLE_PROFILING    0
+
+/**
+ *  Set to a byte count to choose the quality tier (see quality_tier.h) as
+ *  if that much heap were free at load, to try each tier's appearance.
+ *  Zero to use the real heap_bytes_free().
+ */
+#define  TESTING_HEAP_BUDGET         0
+
 ///  Use dummy coords for Mountain View, CA
 #define  TESTING_USE_DUMMY_COORDS_MV  0
 
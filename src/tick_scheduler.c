@@ -0,0 +1,199 @@
+/**
+ *  @file
+ *
+ *  Next-due bookkeeping for the minute tick's jobs.
+ */
+
+
+#include "pebble.h"
+
+#include "tick_scheduler.h"
+
+#include "DayPlan.h"
+#include "geometry.h"
+
+
+///  A minute of day no event is ever due at: "not again today".
+#define  NEVER_TODAY        MINUTES_PER_DAY
+
+///  Most minutes to look ahead for the hour hand tip's next pixel change.
+#define  HAND_SCAN_LIMIT    60
+
+
+///  Local minute of day at which each TickEvent is next due.
+static int16_t  aNextDue[TICK_EVENT_COUNT];
+
+///  Times each TickEvent has come due.
+static uint32_t  aDueCount[TICK_EVENT_COUNT];
+
+static uint32_t  cTicks = 0;
+
+///  Date and minute of day of the last tick polled; day -1 if none yet.
+static int16_t  sLastYear  = 0;
+static int16_t  sLastYday  = -1;
+static int16_t  sLastMinute = 0;
+
+
+void  tick_scheduler_init(void)
+{
+
+   for (int event = 0;  event < TICK_EVENT_COUNT;  event++)
+   {
+      aNextDue[event]  = 0;
+      aDueCount[event] = 0;
+   }
+
+   cTicks = 0;
+   sLastYday = -1;
+
+}  /* end of tick_scheduler_init() */
+
+
+void  tick_scheduler_invalidate(TickEventMask events)
+{
+
+   for (int event = 0;  event < TICK_EVENT_COUNT;  event++)
+   {
+      if (events & TICK_EVENT_BIT(event))
+      {
+         aNextDue[event] = 0;
+      }
+   }
+
+}  /* end of tick_scheduler_invalidate() */
+
+
+/**
+ *  Screen pixel of the hour hand's tip at a local minute of day, packed
+ *  into one int for comparing.  Matches get24HourAngle(): noon is up.
+ */
+static int  hand_tip_pixel(int minuteOfDay)
+{
+
+   int32_t angle = (int32_t) ((minuteOfDay + MINUTES_PER_DAY / 2) % MINUTES_PER_DAY) *
+                   TRIG_MAX_ANGLE / MINUTES_PER_DAY;
+
+   int x = FACE_CENTER_X + HOUR_HAND_L_RADIUS * sin_lookup(angle) / TRIG_MAX_RATIO;
+   int y = FACE_CENTER_Y - HOUR_HAND_L_RADIUS * cos_lookup(angle) / TRIG_MAX_RATIO;
+
+   return (y << 8) | x;
+
+}  /* end of hand_tip_pixel() */
+
+
+/**
+ *  Work out when an event, having just run, is next due.
+ *
+ *  @param event Event to schedule.
+ *  @param minuteOfDay Local minute of day it ran at.
+ *
+ *  @return Local minute of day, or NEVER_TODAY.
+ */
+static int  next_due_minute(TickEvent event, int minuteOfDay)
+{
+
+   switch (event)
+   {
+      case TICK_EVENT_MIDNIGHT:
+         //  (noticed as a change of date instead)
+         return NEVER_TODAY;
+
+      case TICK_EVENT_PLAN_PREPARE:
+         return (minuteOfDay < DAY_PLAN_PREPARE_MINUTE) ? DAY_PLAN_PREPARE_MINUTE
+                                                        : NEVER_TODAY;
+
+      case TICK_EVENT_TEXT_MINUTE:
+         return minuteOfDay + 1;
+
+      case TICK_EVENT_HAND_PIXEL:
+      {
+         //  a minute moves the tip about a quarter pixel, so this is a short scan
+         int tipNow = hand_tip_pixel(minuteOfDay);
+         int minute = minuteOfDay + 1;
+
+         while ((minute < MINUTES_PER_DAY) && (minute - minuteOfDay < HAND_SCAN_LIMIT) &&
+                (hand_tip_pixel(minute) == tipNow))
+         {
+            minute++;
+         }
+         return minute;
+      }
+
+      case TICK_EVENT_BAND_CHANGE:
+      {
+         const DayPlan * pPlan = day_plan_get_active();
+
+         if (pPlan == NULL)
+         {
+            //  no plan, no bands: invalidated when one arrives
+            return NEVER_TODAY;
+         }
+
+         //  dark turns to light at dawn, and back to dark the minute after dusk
+         const TwilightBand * pAstro = &pPlan->aBands[TWI_PATH_ASTRO];
+         int  aEdges[2] = { pAstro->sDawnMinute, pAstro->sDuskMinute + 1 };
+         int  next = NEVER_TODAY;
+
+         for (unsigned iEdge = 0;  iEdge < ARRAY_LENGTH(aEdges);  iEdge++)
+         {
+            if ((aEdges[iEdge] > minuteOfDay) && (aEdges[iEdge] < next))
+            {
+               next = aEdges[iEdge];
+            }
+         }
+         return next;
+      }
+
+      default:
+         return minuteOfDay + 1;
+   }
+
+}  /* end of next_due_minute() */
+
+
+TickEventMask  tick_scheduler_poll(const struct tm *pLocalTime)
+{
+
+   int  minuteOfDay = pLocalTime->tm_hour * 60 + pLocalTime->tm_min;
+
+   cTicks++;
+
+   if ((pLocalTime->tm_yday != sLastYday) || (pLocalTime->tm_year != sLastYear) ||
+       (minuteOfDay < sLastMinute))
+   {
+      //  new day, or time went backwards: schedules no longer mean anything
+      tick_scheduler_invalidate(TICK_EVENTS_ALL);
+
+      sLastYear = pLocalTime->tm_year;
+      sLastYday = pLocalTime->tm_yday;
+   }
+
+   sLastMinute = minuteOfDay;
+
+   TickEventMask  due = 0;
+
+   for (int event = 0;  event < TICK_EVENT_COUNT;  event++)
+   {
+      if (aNextDue[event] <= minuteOfDay)
+      {
+         due |= TICK_EVENT_BIT(event);
+         aDueCount[event]++;
+         aNextDue[event] = next_due_minute(event, minuteOfDay);
+      }
+   }
+
+   return due;
+
+}  /* end of tick_scheduler_poll() */
+
+
+uint32_t  tick_scheduler_get_count(TickEvent event)
+{
+   return aDueCount[event];
+}
+
+
+uint32_t  tick_scheduler_get_tick_count(void)
+{
+   return cTicks;
+}
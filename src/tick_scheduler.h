@@ -0,0 +1,69 @@
+/**
+ *  @file
+ *
+ *  Works out which of the watchface's periodic jobs are due at each minute
+ *  tick, so that the tick handler runs only those.
+ *
+ *  Each job (event) keeps the local minute of day at which it next needs to
+ *  run: the time text every minute, the hour hand whenever its tip would
+ *  land on a different pixel, the hand's night / day appearance when it
+ *  crosses the active DayPlan's dark / light boundary, and so on.  A tick
+ *  is then a handful of integer compares.  A change of date, or local time
+ *  going backwards (DST ending, clock set by the user), makes every event
+ *  due at once.
+ */
+
+
+#ifndef sunclock_tick_scheduler_h__
+#define sunclock_tick_scheduler_h__
+
+
+#include "pebble.h"
+
+
+typedef enum {
+   TICK_EVENT_MIDNIGHT,        ///< local date changed (or first tick): date text, day plan
+   TICK_EVENT_PLAN_PREPARE,    ///< time to build the next day's plan
+   TICK_EVENT_TEXT_MINUTE,     ///< time text shows a new minute
+   TICK_EVENT_HAND_PIXEL,      ///< hour hand tip moves to another pixel
+   TICK_EVENT_BAND_CHANGE,     ///< hour hand crosses the dark / light dial boundary
+   TICK_EVENT_COUNT
+} TickEvent;
+
+///  Set of TickEvent values, one bit each.
+typedef uint16_t  TickEventMask;
+
+#define  TICK_EVENT_BIT(event)   ((TickEventMask) (1u << (event)))
+
+#define  TICK_EVENTS_ALL         ((TickEventMask) ((1u << TICK_EVENT_COUNT) - 1))
+
+
+/**
+ *  Forget all schedules and counts: every event will be due at the next
+ *  tick.
+ */
+void  tick_scheduler_init(void);
+
+/**
+ *  Make some events due at the next tick regardless of their schedule,
+ *  e.g. because the active day plan (and so its band boundaries) changed.
+ */
+void  tick_scheduler_invalidate(TickEventMask events);
+
+/**
+ *  Find the events due at a minute tick, and schedule each one's next run.
+ *
+ *  @param pLocalTime Local time of the tick.
+ *
+ *  @return Events the caller should now run.
+ */
+TickEventMask  tick_scheduler_poll(const struct tm *pLocalTime);
+
+///  Number of times an event has come due since tick_scheduler_init().
+uint32_t  tick_scheduler_get_count(TickEvent event);
+
+///  Number of ticks polled since tick_scheduler_init().
+uint32_t  tick_scheduler_get_tick_count(void);
+
+
+#endif  // #ifndef sunclock_tick_scheduler_h__
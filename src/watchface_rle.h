@@ -0,0 +1,173 @@
+/**
+ *  @file
+ *
+ *  resources/images/watchface.png, run-length encoded as a 1-bit overlay
+ *  mask: see rle_mask.h.
+ *
+ *  GENERATED by tools/gen_rle_mask.py -- do not edit by hand.
+ *  Re-run the tool after changing the image.
+ *
+ *  144 x 168 pixels:
+ *     transparent    246 runs   14376 pixels
+ *     black          663 runs    8671 pixels
+ *     white          558 runs    1145 pixels
+ *
+ *  1662 bytes of runs, against 6720 bytes of pixels for the white and black
+ *  mask bitmaps of a "png-trans" resource.
+ */
+
+#pragma once
+
+#include "rle_mask.h"
+
+#ifdef PBL_PLATFORM_APLITE
+
+static const uint8_t  aWatchfaceRuns[1662] = {
+   0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F,
+   0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F,
+   0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F,
+   0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F,
+   0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F,
+   0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x7F, 0x4F, 0x7F, 0x90, 0x7E,
+   0x79, 0x9C, 0x78, 0x75, 0x89, 0x50, 0x89, 0x74, 0x71, 0x87, 0x45, 0x04,
+   0x80, 0x44, 0x80, 0x04, 0x45, 0x87, 0x70, 0x6F, 0x85, 0x43, 0x0A, 0x80,
+   0x44, 0x80, 0x0A, 0x43, 0x85, 0x6E, 0x6C, 0x85, 0x41, 0x81, 0x0D, 0x80,
+   0x44, 0x80, 0x0C, 0x81, 0x42, 0x85, 0x6B, 0x6A, 0x84, 0x42, 0x00, 0x80,
+   0x41, 0x80, 0x0C, 0x80, 0x44, 0x80, 0x0B, 0x80, 0x41, 0x80, 0x01, 0x42,
+   0x84, 0x69, 0x68, 0x83, 0x42, 0x02, 0x80, 0x43, 0x80, 0x0B, 0x80, 0x44,
+   0x80, 0x0A, 0x80, 0x43, 0x80, 0x03, 0x42, 0x83, 0x67, 0x66, 0x83, 0x41,
+   0x05, 0x80, 0x43, 0x80, 0x0B, 0x80, 0x44, 0x80, 0x0A, 0x80, 0x43, 0x80,
+   0x06, 0x41, 0x83, 0x65, 0x64, 0x83, 0x41, 0x08, 0x80, 0x41, 0x80, 0x0C,
+   0x80, 0x44, 0x80, 0x0B, 0x80, 0x41, 0x80, 0x09, 0x41, 0x83, 0x63, 0x62,
+   0x83, 0x41, 0x0B, 0x81, 0x0D, 0x80, 0x44, 0x80, 0x0C, 0x81, 0x0C, 0x41,
+   0x83, 0x61, 0x61, 0x82, 0x41, 0x1D, 0x80, 0x44, 0x80, 0x1D, 0x41, 0x82,
+   0x60, 0x5F, 0x83, 0x40, 0x1F, 0x80, 0x44, 0x80, 0x1D, 0x81, 0x40, 0x83,
+   0x5E, 0x5E, 0x82, 0x41, 0x81, 0x1E, 0x86, 0x1C, 0x80, 0x41, 0x80, 0x41,
+   0x82, 0x5D, 0x5D, 0x82, 0x40, 0x00, 0x80, 0x41, 0x80, 0x3F, 0x00, 0x80,
+   0x43, 0x80, 0x00, 0x40, 0x82, 0x5C, 0x5B, 0x82, 0x41, 0x00, 0x80, 0x43,
+   0x80, 0x3F, 0x80, 0x43, 0x80, 0x01, 0x41, 0x82, 0x5A, 0x5A, 0x82, 0x40,
+   0x02, 0x80, 0x43, 0x80, 0x3F, 0x00, 0x80, 0x41, 0x80, 0x04, 0x40, 0x82,
+   0x59, 0x59, 0x82, 0x40, 0x04, 0x80, 0x41, 0x80, 0x3F, 0x02, 0x81, 0x06,
+   0x40, 0x82, 0x58, 0x58, 0x81, 0x41, 0x06, 0x81, 0x3F, 0x0D, 0x41, 0x81,
+   0x57, 0x57, 0x81, 0x40, 0x3F, 0x1A, 0x40, 0x81, 0x56, 0x56, 0x81, 0x40,
+   0x3F, 0x1C, 0x40, 0x81, 0x55, 0x55, 0x81, 0x40, 0x3F, 0x1E, 0x40, 0x81,
+   0x54, 0x54, 0x81, 0x40, 0x80, 0x3F, 0x1E, 0x80, 0x40, 0x81, 0x53, 0x53,
+   0x81, 0x42, 0x80, 0x3F, 0x1C, 0x80, 0x42, 0x81, 0x52, 0x52, 0x81, 0x40,
+   0x80, 0x42, 0x80, 0x3F, 0x1A, 0x80, 0x42, 0x80, 0x40, 0x81, 0x51, 0x51,
+   0x81, 0x40, 0x01, 0x80, 0x42, 0x80, 0x3F, 0x18, 0x80, 0x42, 0x80, 0x01,
+   0x40, 0x81, 0x50, 0x50, 0x81, 0x40, 0x03, 0x80, 0x42, 0x80, 0x3F, 0x16,
+   0x80, 0x42, 0x80, 0x03, 0x40, 0x81, 0x4F, 0x4F, 0x81, 0x40, 0x05, 0x80,
+   0x42, 0x80, 0x3F, 0x14, 0x80, 0x42, 0x80, 0x05, 0x40, 0x81, 0x4E, 0x4E,
+   0x82, 0x40, 0x06, 0x80, 0x40, 0x80, 0x3F, 0x16, 0x80, 0x40, 0x80, 0x06,
+   0x40, 0x81, 0x4E, 0x4E, 0x81, 0x40, 0x08, 0x80, 0x3F, 0x18, 0x80, 0x08,
+   0x40, 0x81, 0x4D, 0x4D, 0x81, 0x40, 0x3F, 0x2E, 0x40, 0x81, 0x4C, 0x4C,
+   0x81, 0x40, 0x3F, 0x30, 0x40, 0x81, 0x4B, 0x4B, 0x82, 0x40, 0x3F, 0x30,
+   0x40, 0x81, 0x4B, 0x4B, 0x81, 0x40, 0x3F, 0x32, 0x40, 0x81, 0x4A, 0x4A,
+   0x81, 0x40, 0x3F, 0x34, 0x40, 0x81, 0x49, 0x49, 0x82, 0x40, 0x3F, 0x34,
+   0x40, 0x81, 0x49, 0x49, 0x81, 0x40, 0x82, 0x3F, 0x30, 0x82, 0x40, 0x81,
+   0x48, 0x48, 0x81, 0x40, 0x81, 0x41, 0x80, 0x3F, 0x2E, 0x80, 0x41, 0x81,
+   0x40, 0x80, 0x48, 0x48, 0x81, 0x40, 0x80, 0x43, 0x80, 0x3F, 0x2C, 0x80,
+   0x43, 0x80, 0x40, 0x81, 0x47, 0x47, 0x81, 0x40, 0x00, 0x80, 0x43, 0x80,
+   0x3F, 0x2C, 0x80, 0x43, 0x80, 0x00, 0x40, 0x80, 0x47, 0x47, 0x81, 0x40,
+   0x01, 0x80, 0x41, 0x80, 0x3F, 0x2E, 0x80, 0x41, 0x80, 0x01, 0x40, 0x81,
+   0x46, 0x46, 0x81, 0x40, 0x03, 0x81, 0x3F, 0x30, 0x81, 0x03, 0x40, 0x80,
+   0x46, 0x46, 0x81, 0x40, 0x3F, 0x3C, 0x40, 0x81, 0x45, 0x45, 0x81, 0x40,
+   0x3F, 0x3E, 0x40, 0x80, 0x45, 0x45, 0x81, 0x40, 0x3F, 0x3E, 0x40, 0x81,
+   0x44, 0x44, 0x81, 0x40, 0x3F, 0x3F, 0x00, 0x40, 0x80, 0x44, 0x44, 0x81,
+   0x40, 0x3F, 0x3F, 0x00, 0x40, 0x80, 0x44, 0x44, 0x81, 0x40, 0x3F, 0x3F,
+   0x00, 0x40, 0x81, 0x43, 0x43, 0x81, 0x40, 0x3F, 0x3F, 0x02, 0x40, 0x80,
+   0x43, 0x43, 0x81, 0x40, 0x3F, 0x3F, 0x02, 0x40, 0x81, 0x42, 0x42, 0x82,
+   0x40, 0x3F, 0x3F, 0x02, 0x40, 0x81, 0x42, 0x42, 0x81, 0x40, 0x3F, 0x3F,
+   0x04, 0x40, 0x80, 0x42, 0x42, 0x81, 0x40, 0x00, 0x81, 0x3F, 0x3E, 0x81,
+   0x00, 0x40, 0x80, 0x42, 0x42, 0x81, 0x40, 0x80, 0x41, 0x80, 0x3F, 0x3C,
+   0x80, 0x41, 0x80, 0x40, 0x81, 0x41, 0x41, 0x81, 0x40, 0x80, 0x43, 0x80,
+   0x3F, 0x3A, 0x80, 0x43, 0x80, 0x40, 0x80, 0x41, 0x41, 0x81, 0x40, 0x80,
+   0x43, 0x80, 0x3F, 0x3A, 0x80, 0x43, 0x80, 0x40, 0x80, 0x41, 0x41, 0x81,
+   0x40, 0x00, 0x80, 0x41, 0x80, 0x3F, 0x3C, 0x80, 0x41, 0x80, 0x00, 0x40,
+   0x80, 0x41, 0x41, 0x81, 0x40, 0x01, 0x81, 0x3F, 0x3E, 0x81, 0x01, 0x40,
+   0x81, 0x40, 0x40, 0x81, 0x40, 0x3F, 0x3F, 0x08, 0x40, 0x80, 0x40, 0x40,
+   0x81, 0x40, 0x3F, 0x3F, 0x08, 0x40, 0x80, 0x40, 0x40, 0x81, 0x40, 0x3F,
+   0x3F, 0x08, 0x40, 0x80, 0x40, 0x40, 0x81, 0x40, 0x3F, 0x3F, 0x08, 0x40,
+   0x80, 0x40, 0x40, 0x81, 0x40, 0x3F, 0x3F, 0x08, 0x40, 0x80, 0x40, 0x40,
+   0x81, 0x40, 0x3F, 0x3F, 0x08, 0x40, 0x81, 0x81, 0x40, 0x3F, 0x3F, 0x0A,
+   0x40, 0x80, 0x81, 0x40, 0x3F, 0x3F, 0x0A, 0x40, 0x80, 0x81, 0x40, 0x3F,
+   0x3F, 0x0A, 0x40, 0x80, 0x81, 0x40, 0x3F, 0x3F, 0x0A, 0x40, 0x80, 0x81,
+   0x40, 0x3F, 0x3F, 0x0A, 0x40, 0x80, 0x81, 0x40, 0x8A, 0x3F, 0x34, 0x8A,
+   0x40, 0x80, 0x81, 0x4A, 0x80, 0x3F, 0x34, 0x80, 0x4A, 0x80, 0x81, 0x4A,
+   0x80, 0x3F, 0x34, 0x80, 0x4A, 0x80, 0x81, 0x4A, 0x80, 0x3F, 0x34, 0x80,
+   0x4A, 0x80, 0x81, 0x4A, 0x80, 0x3F, 0x34, 0x80, 0x4A, 0x80, 0x81, 0x4A,
+   0x80, 0x3F, 0x34, 0x80, 0x4A, 0x80, 0x81, 0x40, 0x8A, 0x3F, 0x34, 0x8A,
+   0x40, 0x80, 0x81, 0x40, 0x3F, 0x3F, 0x0A, 0x40, 0x80, 0x81, 0x40, 0x3F,
+   0x3F, 0x0A, 0x40, 0x80, 0x81, 0x40, 0x3F, 0x3F, 0x0A, 0x40, 0x80, 0x81,
+   0x40, 0x3F, 0x3F, 0x0A, 0x40, 0x80, 0x81, 0x40, 0x3F, 0x3F, 0x0A, 0x40,
+   0x80, 0x40, 0x81, 0x40, 0x3F, 0x3F, 0x08, 0x40, 0x81, 0x40, 0x81, 0x40,
+   0x3F, 0x3F, 0x08, 0x40, 0x80, 0x40, 0x40, 0x81, 0x40, 0x3F, 0x3F, 0x08,
+   0x40, 0x80, 0x40, 0x40, 0x81, 0x40, 0x3F, 0x3F, 0x08, 0x40, 0x80, 0x40,
+   0x40, 0x81, 0x40, 0x3F, 0x3F, 0x08, 0x40, 0x80, 0x40, 0x40, 0x81, 0x40,
+   0x3F, 0x3F, 0x08, 0x40, 0x80, 0x40, 0x41, 0x81, 0x40, 0x01, 0x81, 0x3F,
+   0x3E, 0x81, 0x01, 0x40, 0x81, 0x40, 0x41, 0x81, 0x40, 0x00, 0x80, 0x41,
+   0x80, 0x3F, 0x3C, 0x80, 0x41, 0x80, 0x00, 0x40, 0x80, 0x41, 0x41, 0x81,
+   0x40, 0x80, 0x43, 0x80, 0x3F, 0x3A, 0x80, 0x43, 0x80, 0x40, 0x80, 0x41,
+   0x41, 0x81, 0x40, 0x80, 0x43, 0x80, 0x3F, 0x3A, 0x80, 0x43, 0x80, 0x40,
+   0x80, 0x41, 0x42, 0x81, 0x40, 0x80, 0x41, 0x80, 0x3F, 0x3C, 0x80, 0x41,
+   0x80, 0x40, 0x81, 0x41, 0x42, 0x81, 0x40, 0x00, 0x81, 0x3F, 0x3E, 0x81,
+   0x00, 0x40, 0x80, 0x42, 0x42, 0x81, 0x40, 0x3F, 0x3F, 0x04, 0x40, 0x80,
+   0x42, 0x42, 0x82, 0x40, 0x3F, 0x3F, 0x02, 0x40, 0x81, 0x42, 0x43, 0x81,
+   0x40, 0x3F, 0x3F, 0x02, 0x40, 0x81, 0x42, 0x43, 0x81, 0x40, 0x3F, 0x3F,
+   0x02, 0x40, 0x80, 0x43, 0x44, 0x81, 0x40, 0x3F, 0x3F, 0x00, 0x40, 0x81,
+   0x43, 0x44, 0x81, 0x40, 0x3F, 0x3F, 0x00, 0x40, 0x80, 0x44, 0x44, 0x81,
+   0x40, 0x3F, 0x3F, 0x00, 0x40, 0x80, 0x44, 0x45, 0x81, 0x40, 0x3F, 0x3E,
+   0x40, 0x81, 0x44, 0x45, 0x81, 0x40, 0x3F, 0x3E, 0x40, 0x80, 0x45, 0x46,
+   0x81, 0x40, 0x3F, 0x3C, 0x40, 0x81, 0x45, 0x46, 0x81, 0x40, 0x03, 0x81,
+   0x3F, 0x30, 0x81, 0x03, 0x40, 0x80, 0x46, 0x47, 0x81, 0x40, 0x01, 0x80,
+   0x41, 0x80, 0x3F, 0x2E, 0x80, 0x41, 0x80, 0x01, 0x40, 0x81, 0x46, 0x47,
+   0x81, 0x40, 0x00, 0x80, 0x43, 0x80, 0x3F, 0x2C, 0x80, 0x43, 0x80, 0x00,
+   0x40, 0x80, 0x47, 0x48, 0x81, 0x40, 0x80, 0x43, 0x80, 0x3F, 0x2C, 0x80,
+   0x43, 0x80, 0x40, 0x81, 0x47, 0x48, 0x81, 0x40, 0x81, 0x41, 0x80, 0x3F,
+   0x2E, 0x80, 0x41, 0x81, 0x40, 0x80, 0x48, 0x49, 0x81, 0x40, 0x82, 0x3F,
+   0x30, 0x82, 0x40, 0x81, 0x48, 0x49, 0x82, 0x40, 0x3F, 0x34, 0x40, 0x81,
+   0x49, 0x4A, 0x81, 0x40, 0x3F, 0x34, 0x40, 0x81, 0x49, 0x4B, 0x81, 0x40,
+   0x3F, 0x32, 0x40, 0x81, 0x4A, 0x4B, 0x82, 0x40, 0x3F, 0x30, 0x40, 0x81,
+   0x4B, 0x4C, 0x81, 0x40, 0x3F, 0x30, 0x40, 0x81, 0x4B, 0x4D, 0x81, 0x40,
+   0x0A, 0x80, 0x3F, 0x16, 0x80, 0x0A, 0x40, 0x81, 0x4C, 0x4E, 0x81, 0x40,
+   0x08, 0x80, 0x40, 0x80, 0x3F, 0x14, 0x80, 0x40, 0x80, 0x08, 0x40, 0x81,
+   0x4D, 0x4E, 0x82, 0x40, 0x06, 0x80, 0x42, 0x80, 0x3F, 0x12, 0x80, 0x42,
+   0x80, 0x06, 0x40, 0x81, 0x4E, 0x4F, 0x81, 0x40, 0x05, 0x80, 0x42, 0x80,
+   0x3F, 0x14, 0x80, 0x42, 0x80, 0x05, 0x40, 0x81, 0x4E, 0x50, 0x81, 0x40,
+   0x03, 0x80, 0x42, 0x80, 0x3F, 0x16, 0x80, 0x42, 0x80, 0x03, 0x40, 0x81,
+   0x4F, 0x51, 0x81, 0x40, 0x01, 0x80, 0x42, 0x80, 0x3F, 0x18, 0x80, 0x42,
+   0x80, 0x01, 0x40, 0x81, 0x50, 0x52, 0x81, 0x40, 0x80, 0x42, 0x80, 0x3F,
+   0x1A, 0x80, 0x42, 0x80, 0x40, 0x81, 0x51, 0x53, 0x81, 0x42, 0x80, 0x3F,
+   0x1C, 0x80, 0x42, 0x81, 0x52, 0x54, 0x81, 0x40, 0x80, 0x3F, 0x1E, 0x80,
+   0x40, 0x81, 0x53, 0x55, 0x81, 0x40, 0x3F, 0x1E, 0x40, 0x81, 0x54, 0x56,
+   0x81, 0x40, 0x3F, 0x1C, 0x40, 0x81, 0x55, 0x57, 0x81, 0x40, 0x3F, 0x1A,
+   0x40, 0x81, 0x56, 0x58, 0x81, 0x41, 0x07, 0x81, 0x3F, 0x0C, 0x41, 0x81,
+   0x57, 0x59, 0x82, 0x40, 0x05, 0x80, 0x41, 0x80, 0x3F, 0x00, 0x81, 0x07,
+   0x40, 0x82, 0x58, 0x5A, 0x82, 0x40, 0x03, 0x80, 0x43, 0x80, 0x3E, 0x80,
+   0x41, 0x80, 0x05, 0x40, 0x82, 0x59, 0x5B, 0x82, 0x41, 0x01, 0x80, 0x43,
+   0x80, 0x3D, 0x80, 0x43, 0x80, 0x02, 0x41, 0x82, 0x5A, 0x5D, 0x82, 0x40,
+   0x00, 0x81, 0x41, 0x80, 0x3E, 0x80, 0x43, 0x80, 0x01, 0x40, 0x82, 0x5C,
+   0x5E, 0x82, 0x41, 0x82, 0x1D, 0x86, 0x1B, 0x80, 0x41, 0x81, 0x41, 0x82,
+   0x5D, 0x5F, 0x83, 0x40, 0x1F, 0x80, 0x44, 0x80, 0x1C, 0x82, 0x40, 0x83,
+   0x5E, 0x61, 0x82, 0x41, 0x0D, 0x81, 0x0D, 0x80, 0x44, 0x80, 0x1D, 0x41,
+   0x82, 0x60, 0x62, 0x83, 0x41, 0x0A, 0x80, 0x41, 0x80, 0x0C, 0x80, 0x44,
+   0x80, 0x0C, 0x81, 0x0C, 0x41, 0x83, 0x61, 0x64, 0x83, 0x41, 0x07, 0x80,
+   0x43, 0x80, 0x0B, 0x80, 0x44, 0x80, 0x0B, 0x80, 0x41, 0x80, 0x09, 0x41,
+   0x83, 0x63, 0x66, 0x83, 0x41, 0x05, 0x80, 0x43, 0x80, 0x0B, 0x80, 0x44,
+   0x80, 0x0A, 0x80, 0x43, 0x80, 0x06, 0x41, 0x83, 0x65, 0x68, 0x83, 0x42,
+   0x03, 0x80, 0x41, 0x80, 0x0C, 0x80, 0x44, 0x80, 0x0A, 0x80, 0x43, 0x80,
+   0x03, 0x42, 0x83, 0x67, 0x6A, 0x84, 0x42, 0x01, 0x81, 0x0D, 0x80, 0x44,
+   0x80, 0x0B, 0x80, 0x41, 0x80, 0x01, 0x42, 0x84, 0x69, 0x6C, 0x85, 0x42,
+   0x0E, 0x80, 0x44, 0x80, 0x0C, 0x81, 0x42, 0x85, 0x6B, 0x6F, 0x85, 0x43,
+   0x0A, 0x80, 0x44, 0x80, 0x0A, 0x43, 0x85, 0x6E, 0x71, 0x87, 0x45, 0x04,
+   0x80, 0x44, 0x80, 0x04, 0x45, 0x87, 0x70, 0x75, 0x89, 0x50, 0x89, 0x74,
+   0x79, 0x9C, 0x78, 0x7F, 0x90, 0x7E,
+};
+
+static const RleMask  watchfaceRleMask = {
+   .width  = 144,
+   .height = 168,
+   .pRuns  = aWatchfaceRuns,
+};
+
+#endif  // #ifdef PBL_PLATFORM_APLITE
@@ -0,0 +1,118 @@
+/**
+ *  @file
+ *
+ *  Dispatches input changes to the widgets which depend on them.
+ */
+
+
+#include "pebble.h"
+
+#include "widget_pipeline.h"
+
+#include "platform.h"
+
+
+static const WidgetDef * aPipelineWidgets = NULL;
+
+static int  cPipelineWidgets = 0;
+
+///  Times each widget has been updated.
+static uint32_t  aUpdateCount[WIDGET_PIPELINE_MAX];
+
+///  Inputs whose widgets are held back.
+static WidgetInputMask  heldInputs = 0;
+
+///  Changes each held widget has missed.
+static WidgetInputMask  aMissedInputs[WIDGET_PIPELINE_MAX];
+
+
+void  widget_pipeline_init(const WidgetDef *aWidgets, int cWidgets)
+{
+
+   if (cWidgets > WIDGET_PIPELINE_MAX)
+   {
+      //  (callers check at compile time; this only keeps the arrays safe)
+      MY_APP_LOG(APP_LOG_LEVEL_ERROR, "widget pipeline: %d widgets, only %d kept",
+                 cWidgets, WIDGET_PIPELINE_MAX);
+      cWidgets = WIDGET_PIPELINE_MAX;
+   }
+
+   aPipelineWidgets = aWidgets;
+   cPipelineWidgets = cWidgets;
+
+   for (int iWidget = 0;  iWidget < WIDGET_PIPELINE_MAX;  iWidget++)
+   {
+      aUpdateCount[iWidget]  = 0;
+      aMissedInputs[iWidget] = 0;
+   }
+
+   heldInputs = 0;
+
+}  /* end of widget_pipeline_init() */
+
+
+void  widget_pipeline_inputs_changed(WidgetInputMask changed, const struct tm *pLocalTime)
+{
+
+   for (int iWidget = 0;  iWidget < cPipelineWidgets;  iWidget++)
+   {
+      const WidgetDef * pWidget = &aPipelineWidgets[iWidget];
+
+      if ((pWidget->inputs & changed) && (pWidget->inputs & heldInputs))
+      {
+         aMissedInputs[iWidget] |= pWidget->inputs & changed;
+      }
+      else if (pWidget->inputs & changed)
+      {
+         aUpdateCount[iWidget]++;
+         pWidget->update(changed, pLocalTime);
+      }
+   }
+
+}  /* end of widget_pipeline_inputs_changed() */
+
+
+void  widget_pipeline_hold(WidgetInputMask inputs)
+{
+   heldInputs |= inputs;
+}
+
+
+void  widget_pipeline_release(WidgetInputMask inputs, const struct tm *pLocalTime)
+{
+
+   heldInputs &= ~inputs;
+
+   for (int iWidget = 0;  iWidget < cPipelineWidgets;  iWidget++)
+   {
+      const WidgetDef * pWidget = &aPipelineWidgets[iWidget];
+
+      if ((pWidget->inputs & inputs) && ! (pWidget->inputs & heldInputs))
+      {
+         WidgetInputMask changed = aMissedInputs[iWidget] | (pWidget->inputs & inputs);
+
+         aMissedInputs[iWidget] = 0;
+         aUpdateCount[iWidget]++;
+         pWidget->update(changed, pLocalTime);
+      }
+   }
+
+}  /* end of widget_pipeline_release() */
+
+
+uint32_t  widget_pipeline_get_update_count(int iWidget)
+{
+   return ((iWidget >= 0) && (iWidget < cPipelineWidgets)) ? aUpdateCount[iWidget] : 0;
+}
+
+
+void  widget_pipeline_log_counts(void)
+{
+
+   for (int iWidget = 0;  iWidget < cPipelineWidgets;  iWidget++)
+   {
+      MY_APP_LOG(APP_LOG_LEVEL_DEBUG, "widget %s: %lu updates",
+                 aPipelineWidgets[iWidget].pszName, (unsigned long) aUpdateCount[iWidget]);
+   }
+
+}  /* end of widget_pipeline_log_counts() */
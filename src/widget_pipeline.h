@@ -0,0 +1,112 @@
+/**
+ *  @file
+ *
+ *  Change-driven updating of the watchface's on-screen elements ("widgets").
+ *
+ *  Each widget declares the inputs it is computed from: the time text
+ *  needs the minute, the date text the day, the hour hand's hub the battery
+ *  state, and so on.  Whoever notices an input change reports it, and only
+ *  the widgets depending on that input are recomputed (and so invalidated).
+ *  Widgets may themselves produce inputs: the day plan "widget" reports
+ *  WIDGET_INPUT_PLAN once a new plan is active.
+ *
+ *  Widgets can be held back while something they draw into doesn't exist
+ *  yet (see widget_pipeline_hold()); they catch up when released.
+ */
+
+
+#ifndef sunclock_widget_pipeline_h__
+#define sunclock_widget_pipeline_h__
+
+
+#include "pebble.h"
+
+
+///  Things widgets are computed from.
+typedef enum {
+   WIDGET_INPUT_MINUTE,        ///< time of day text shows a new minute
+   WIDGET_INPUT_DAY,           ///< local date
+   WIDGET_INPUT_HAND_POS,      ///< hour hand tip has moved a pixel
+   WIDGET_INPUT_DARKNESS,      ///< hour hand has crossed the dark / light boundary
+   WIDGET_INPUT_LOCATION,      ///< latitude / longitude
+   WIDGET_INPUT_TZ,            ///< watch's offset from UTC, including DST
+   WIDGET_INPUT_BATTERY,       ///< battery charge state
+   WIDGET_INPUT_HEMISPHERE,    ///< north / south of the equator
+   WIDGET_INPUT_PLAN,          ///< active DayPlan
+   WIDGET_INPUT_TEXT_FONTS,    ///< overlay text has its fonts (a later startup stage)
+   WIDGET_INPUT_COUNT
+} WidgetInput;
+
+///  Set of WidgetInput values, one bit each.
+typedef uint16_t  WidgetInputMask;
+
+#define  WIDGET_INPUT_BIT(input)   ((WidgetInputMask) (1u << (input)))
+
+#define  WIDGET_INPUTS_ALL         ((WidgetInputMask) ((1u << WIDGET_INPUT_COUNT) - 1))
+
+
+/**
+ *  Recompute a widget and invalidate whatever it draws into.
+ *
+ *  @param changed Inputs which changed; at least one is the widget's.
+ *  @param pLocalTime Current local time.
+ */
+typedef void (*WidgetUpdateHandler)(WidgetInputMask changed, const struct tm *pLocalTime);
+
+typedef struct {
+   const char *         pszName;    ///< for logging
+   WidgetInputMask      inputs;     ///< inputs the widget depends on
+   WidgetUpdateHandler  update;
+} WidgetDef;
+
+
+///  Most widgets widget_pipeline_init() accepts.
+#define  WIDGET_PIPELINE_MAX  12
+
+
+/**
+ *  Set the widgets to keep updated, and clear their update counts.
+ *
+ *  @param aWidgets Widget definitions, in update order.  Must outlive all
+ *                  use of this module.
+ *  @param cWidgets Entries in aWidgets, at most WIDGET_PIPELINE_MAX (any
+ *                  more are dropped, with an error logged).
+ */
+void  widget_pipeline_init(const WidgetDef *aWidgets, int cWidgets);
+
+/**
+ *  Report changed inputs: every widget which depends on any of them is
+ *  updated, in definition order.  May be called from a widget's update
+ *  handler (to report inputs it produces).
+ *
+ *  @param changed Inputs which changed.
+ *  @param pLocalTime Current local time.
+ */
+void  widget_pipeline_inputs_changed(WidgetInputMask changed, const struct tm *pLocalTime);
+
+/**
+ *  Hold back every widget depending on any of some inputs: reported changes
+ *  skip them, but are remembered for widget_pipeline_release().
+ *
+ *  @param inputs Inputs whose widgets to hold.
+ */
+void  widget_pipeline_hold(WidgetInputMask inputs);
+
+/**
+ *  Stop holding back widgets depending on some inputs, and update each one
+ *  (not otherwise still held) with the changes it missed plus those inputs,
+ *  as if they had just changed.
+ *
+ *  @param inputs Inputs previously passed to widget_pipeline_hold().
+ *  @param pLocalTime Current local time.
+ */
+void  widget_pipeline_release(WidgetInputMask inputs, const struct tm *pLocalTime);
+
+///  Number of times widget iWidget has been updated since init.
+uint32_t  widget_pipeline_get_update_count(int iWidget);
+
+///  Log each widget's update count (debug builds only).
+void  widget_pipeline_log_counts(void);
+
+
+#endif  // #ifndef sunclock_widget_pipeline_h__
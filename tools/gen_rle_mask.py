@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+#
+#  Run-length encode a transparent png (e.g. resources/images/watchface.png)
+#  as a 1-bit overlay mask for src/rle_mask.c, and write it out as a C
+#  header of const data.
+#
+#  Each pixel is transparent (alpha below half), black or white (luminance
+#  below / above half).  Rows are encoded as runs of one byte each: the
+#  top two bits give the run's kind (RLE_RUN_* in src/rle_mask.h), the
+#  other six its length less one.  Runs never cross a row end, so longer
+#  stretches simply take several bytes.
+#
+#  Usage:
+#
+#     tools/gen_rle_mask.py [--name watchface] [--guard PBL_PLATFORM_APLITE]
+#                           [-o src/watchface_rle.h] resources/images/watchface.png
+#
+#  Pure python (png decoded with zlib), so it runs anywhere waf does.
+#
+
+import argparse
+import struct
+import sys
+import zlib
+
+
+RLE_RUN_SKIP = 0
+RLE_RUN_BLACK = 1
+RLE_RUN_WHITE = 2
+
+RLE_KIND_SHIFT = 6
+RLE_MAX_LENGTH = 1 << RLE_KIND_SHIFT
+
+KIND_NAMES = {RLE_RUN_SKIP: 'transparent', RLE_RUN_BLACK: 'black', RLE_RUN_WHITE: 'white'}
+
+#  Aplite's 1-bit bitmaps pad rows to a multiple of 4 bytes.
+BITMAP_ROW_ALIGN = 4
+
+
+# ----------------------------------------------------------------------------
+#  png decoding: non-interlaced, bit depth up to 8.
+
+CHANNELS = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path):
+    """Return (width, height, rows), rows being lists of (r, g, b, a)."""
+    data = open(path, 'rb').read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        sys.exit('%s: not a png' % path)
+
+    pos = 8
+    idat = b''
+    palette = []
+    trns = b''
+    while pos < len(data):
+        length, = struct.unpack('>I', data[pos:pos + 4])
+        kind = data[pos + 4:pos + 8]
+        body = data[pos + 8:pos + 8 + length]
+        if kind == b'IHDR':
+            width, height, depth, ctype, _, _, interlace = struct.unpack('>IIBBBBB', body)
+        elif kind == b'PLTE':
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b'tRNS':
+            trns = body
+        elif kind == b'IDAT':
+            idat += body
+        pos += 12 + length
+
+    if depth > 8 or interlace:
+        sys.exit('%s: 16 bit and interlaced pngs are not supported' % path)
+
+    bits_per_pixel = depth * CHANNELS[ctype]
+    stride = (width * bits_per_pixel + 7) // 8
+    step = max(1, bits_per_pixel // 8)
+    raw = zlib.decompress(idat)
+    prev = bytes(stride)
+    rows = []
+
+    for y in range(height):
+        base = y * (stride + 1)
+        filt = raw[base]
+        line = bytearray()
+        for i, x in enumerate(raw[base + 1:base + 1 + stride]):
+            a = line[i - step] if i >= step else 0
+            b = prev[i]
+            c = prev[i - step] if i >= step else 0
+            x = (x + (0, a, b, (a + b) // 2, paeth(a, b, c))[filt]) & 0xFF
+            line.append(x)
+        prev = bytes(line)
+
+        def sample(n):
+            bit = n * depth
+            return (line[bit // 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1)
+
+        scale = 255 // ((1 << depth) - 1)
+        pixels = []
+        for x in range(width):
+            s = [sample(x * CHANNELS[ctype] + k) for k in range(CHANNELS[ctype])]
+            if ctype == 3:
+                r, g, b = palette[s[0]]
+                a = trns[s[0]] if s[0] < len(trns) else 255
+            elif ctype == 0:
+                r = g = b = s[0] * scale
+                a = 0 if (len(trns) == 2 and s[0] == struct.unpack('>H', trns)[0]) else 255
+            elif ctype == 4:
+                r = g = b = s[0] * scale
+                a = s[1] * scale
+            elif ctype == 2:
+                r, g, b = (v * scale for v in s)
+                a = 255
+            else:
+                r, g, b, a = (v * scale for v in s)
+            pixels.append((r, g, b, a))
+        rows.append(pixels)
+
+    return width, height, rows
+
+
+# ----------------------------------------------------------------------------
+#  Encoding.
+
+def classify(pixel):
+    r, g, b, a = pixel
+    if a < 128:
+        return RLE_RUN_SKIP
+    return RLE_RUN_WHITE if (r * 299 + g * 587 + b * 114) >= 128 * 1000 else RLE_RUN_BLACK
+
+
+def encode(width, rows):
+    """Return (runs, stats)."""
+    out = bytearray()
+    stats = {kind: [0, 0] for kind in KIND_NAMES}      # kind: [runs, pixels]
+
+    for pixels in rows:
+        kinds = [classify(p) for p in pixels]
+        x = 0
+        while x < width:
+            kind = kinds[x]
+            n = 1
+            while x + n < width and kinds[x + n] == kind:
+                n += 1
+            stats[kind][0] += 1
+            stats[kind][1] += n
+            x += n
+            while n > 0:
+                length = min(n, RLE_MAX_LENGTH)
+                out.append((kind << RLE_KIND_SHIFT) | (length - 1))
+                n -= length
+
+    return bytes(out), stats
+
+
+def emit_header(out, args, width, height, runs, stats):
+    w = out.write
+    bitmap_row = (width + 8 * BITMAP_ROW_ALIGN - 1) // (8 * BITMAP_ROW_ALIGN) * BITMAP_ROW_ALIGN
+    bitmap_bytes = 2 * bitmap_row * height
+
+    w('/**\n')
+    w(' *  @file\n')
+    w(' *\n')
+    w(' *  %s, run-length encoded as a 1-bit overlay\n' % args.png)
+    w(' *  mask: see rle_mask.h.\n')
+    w(' *\n')
+    w(' *  GENERATED by tools/gen_rle_mask.py -- do not edit by hand.\n')
+    w(' *  Re-run the tool after changing the image.\n')
+    w(' *\n')
+    w(' *  %d x %d pixels:\n' % (width, height))
+    for kind, name in sorted(KIND_NAMES.items()):
+        w(' *     %-12s %5d runs  %6d pixels\n' % (name, stats[kind][0], stats[kind][1]))
+    w(' *\n')
+    w(' *  %d bytes of runs, against %d bytes of pixels for the white and black\n' %
+      (len(runs), bitmap_bytes))
+    w(' *  mask bitmaps of a "png-trans" resource.\n')
+    w(' */\n')
+    w('\n')
+    w('#pragma once\n')
+    w('\n')
+    w('#include "rle_mask.h"\n')
+    w('\n')
+    if args.guard:
+        w('#ifdef %s\n' % args.guard)
+        w('\n')
+    stem = args.name[:1].upper() + args.name[1:]
+    w('static const uint8_t  a%sRuns[%d] = {\n' % (stem, len(runs)))
+    for i in range(0, len(runs), 12):
+        w('   %s,\n' % ', '.join('0x%02X' % b for b in runs[i:i + 12]))
+    w('};\n')
+    w('\n')
+    w('static const RleMask  %sRleMask = {\n' % args.name)
+    w('   .width  = %d,\n' % width)
+    w('   .height = %d,\n' % height)
+    w('   .pRuns  = a%sRuns,\n' % stem)
+    w('};\n')
+    if args.guard:
+        w('\n')
+        w('#endif  // #ifdef %s\n' % args.guard)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('png', help='transparent png to encode')
+    ap.add_argument('--name', default='watchface',
+                    help='C identifier stem for the generated data')
+    ap.add_argument('--guard', default='PBL_PLATFORM_APLITE',
+                    help='preprocessor symbol the data is built under ("" for none)')
+    ap.add_argument('-o', '--output', default=None,
+                    help='header to write (default: stdout)')
+    args = ap.parse_args()
+
+    width, height, rows = read_png(args.png)
+    if width > 255 or height > 255:
+        sys.exit('%s: at most 255 x 255 pixels' % args.png)
+
+    runs, stats = encode(width, rows)
+
+    if args.output:
+        with open(args.output, 'w') as out:
+            emit_header(out, args, width, height, runs, stats)
+    else:
+        emit_header(sys.stdout, args, width, height, runs, stats)
+
+
+if __name__ == '__main__':
+    main()
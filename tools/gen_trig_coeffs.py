@@ -0,0 +1,298 @@
+#!/usr/bin/env python3
+#
+#  Fit minimax polynomial coefficients for the trig kernels in src/my_math.c
+#  (cos_core, sin_core, asin_core) and write them out as a C header of float
+#  constants.
+#
+#  The kernels run in IEEE single precision on the watch, so there is no
+#  point paying for terms whose contribution falls below float rounding, or
+#  below the accuracy that actually shows up on the dial.  For each kernel
+#  we fit every degree in a range, evaluate the fitted polynomial the way
+#  the watch will (float coefficients, float Horner steps), and pick the
+#  cheapest degree that meets the requested error target.
+#
+#  Usage:
+#
+#     tools/gen_trig_coeffs.py [--target-error 1e-6] [-o src/my_math_coeffs.h]
+#
+#  Pure python (no numpy), so it runs anywhere waf does.
+#
+
+import argparse
+import math
+import struct
+import sys
+
+
+#  Nominal soft-float costs, in cycles, for the Pebble's Cortex-M parts.
+#  These are estimates for libgcc's __aeabi_fmul / __aeabi_fadd, not
+#  measurements; override them on the command line if you have better ones.
+DEFAULT_FMUL_CYCLES = 40
+DEFAULT_FADD_CYCLES = 50
+
+
+def f32(x):
+    """Round a python float to the nearest IEEE single."""
+    return struct.unpack('<f', struct.pack('<f', x))[0]
+
+
+# ----------------------------------------------------------------------------
+#  Kernel definitions.
+#
+#  Every kernel is written as  f(x) = m(x) * P(x*x),  where m(x) is either 1
+#  (even functions) or x (odd functions), so the fit is always for P over
+#  u = x*x.  Relative error of f equals relative error of P.
+
+def _sinc(u):
+    if u == 0.0:
+        return 1.0
+    r = math.sqrt(u)
+    return math.sin(r) / r
+
+
+def _asinc(u):
+    if u == 0.0:
+        return 1.0
+    r = math.sqrt(u)
+    return math.asin(r) / r
+
+
+KERNELS = [
+    #  name        odd?   target P(u)                   x range
+    ('cos_core',  False, lambda u: math.cos(math.sqrt(u)), math.pi / 4),
+    ('sin_core',  True,  _sinc,                             math.pi / 4),
+    ('asin_core', True,  _asinc,                            0.5625),
+]
+
+
+# ----------------------------------------------------------------------------
+#  Remez exchange, weighted for relative error.
+
+def _solve(a, b):
+    """Gaussian elimination with partial pivoting; a is n x n, b is n."""
+    n = len(b)
+    m = [row[:] + [b[i]] for i, row in enumerate(a)]
+    for col in range(n):
+        piv = max(range(col, n), key=lambda r: abs(m[r][col]))
+        m[col], m[piv] = m[piv], m[col]
+        for r in range(col + 1, n):
+            f = m[r][col] / m[col][col]
+            for c in range(col, n + 1):
+                m[r][c] -= f * m[col][c]
+    x = [0.0] * n
+    for r in range(n - 1, -1, -1):
+        s = m[r][n] - sum(m[r][c] * x[c] for c in range(r + 1, n))
+        x[r] = s / m[r][r]
+    return x
+
+
+def _poly(c, u):
+    s = 0.0
+    for k in reversed(c):
+        s = s * u + k
+    return s
+
+
+def remez(g, lo, hi, degree, iterations=40, grid=4000):
+    """Minimax fit of P (given degree, in u) to g on [lo, hi], relative error."""
+
+    #  Fit in t = u / hi, which keeps the linear systems well conditioned,
+    #  then scale the coefficients back to u at the end.
+    def gt(t):
+        return g(t * hi)
+
+    n = degree + 2
+    #  Chebyshev extrema as the initial reference
+    ref = [(1 - math.cos(math.pi * i / (n - 1))) / 2 for i in range(n)]
+    samples = [(1 - math.cos(math.pi * i / grid)) / 2 for i in range(grid + 1)]
+    gs = [gt(t) for t in samples]
+
+    best = None
+    best_err = None
+    for _ in range(iterations):
+        a = []
+        b = []
+        for i, t in enumerate(ref):
+            gv = gt(t)
+            a.append([t ** k for k in range(degree + 1)] + [(-1) ** i * gv])
+            b.append(gv)
+        coeffs = _solve(a, b)[:degree + 1]
+
+        err = [(_poly(coeffs, t) - gv) / gv for t, gv in zip(samples, gs)]
+        worst = max(abs(e) for e in err)
+        if best_err is None or worst < best_err:
+            best, best_err = coeffs, worst
+
+        #  pick new reference: the n alternating local extrema of largest size
+        ext = []
+        for i in range(len(samples)):
+            e = err[i]
+            if ((i == 0 or abs(e) >= abs(err[i - 1])) and
+                    (i + 1 == len(samples) or abs(e) >= abs(err[i + 1]))):
+                if ext and (err[ext[-1]] > 0) == (e > 0):
+                    if abs(e) > abs(err[ext[-1]]):
+                        ext[-1] = i
+                else:
+                    ext.append(i)
+        while len(ext) > n:
+            #  drop the smaller end
+            if abs(err[ext[0]]) < abs(err[ext[-1]]):
+                ext.pop(0)
+            else:
+                ext.pop()
+        if len(ext) < n:
+            break
+        ref = [samples[i] for i in ext]
+
+    return [c / hi ** k for k, c in enumerate(best)]
+
+
+# ----------------------------------------------------------------------------
+#  Accuracy of the polynomial as the watch will evaluate it.
+
+def eval_float(coeffs, odd, x):
+    """Evaluate the kernel in float, mirroring the generated C."""
+    x = f32(x)
+    u = f32(x * x)
+    s = coeffs[-1]
+    for k in reversed(coeffs[:-1]):
+        s = f32(f32(s * u) + k)
+    if odd:
+        s = f32(s * x)
+    return s
+
+
+def max_rel_error(coeffs, odd, g, xmax, points=20000, float_eval=True):
+    worst = 0.0
+    for i in range(1, points + 1):
+        x = xmax * i / points
+        truth = g(x * x) * (x if odd else 1.0)
+        if float_eval:
+            got = eval_float(coeffs, odd, x)
+        else:
+            got = _poly(coeffs, x * x) * (x if odd else 1.0)
+        worst = max(worst, abs((got - truth) / truth))
+    return worst
+
+
+def op_counts(degree, odd):
+    """(fmul, fadd) for Horner in u, plus the u = x*x and odd-factor muls."""
+    return (degree + 1 + (1 if odd else 0), degree)
+
+
+# ----------------------------------------------------------------------------
+
+def fit_kernel(name, odd, g, xmax, degrees, fmul, fadd):
+    rows = []
+    for d in degrees:
+        c = remez(g, 0.0, xmax * xmax, d)
+        c32 = [f32(k) for k in c]
+        muls, adds = op_counts(d, odd)
+        rows.append({
+            'degree': d,
+            'coeffs': c32,
+            'fit_err': max_rel_error(c, odd, g, xmax, float_eval=False),
+            'float_err': max_rel_error(c32, odd, g, xmax),
+            'muls': muls,
+            'adds': adds,
+            'cycles': muls * fmul + adds * fadd,
+        })
+    return rows
+
+
+def choose(rows, target):
+    for r in rows:
+        if r['float_err'] <= target:
+            return r
+    return rows[-1]
+
+
+def format_table(name, rows, chosen):
+    lines = ['   %s' % name,
+             '      deg  terms  fmul fadd  ~cycles   fit err    float err',
+             ]
+    for r in rows:
+        mark = '  <==' if r is chosen else ''
+        lines.append('      %3d  %5d  %4d %4d  %7d   %.2e   %.2e%s' %
+                     (r['degree'], r['degree'] + 1, r['muls'], r['adds'],
+                      r['cycles'], r['fit_err'], r['float_err'], mark))
+    return lines
+
+
+def emit_header(out, results, target, fmul, fadd):
+    w = out.write
+    w('/**\n')
+    w(' *  @file\n')
+    w(' *  \n')
+    w(' *  Minimax polynomial coefficients for the trig kernels in my_math.c.\n')
+    w(' *  \n')
+    w(' *  GENERATED by tools/gen_trig_coeffs.py -- do not edit by hand.\n')
+    w(' *  Re-run the tool to change the accuracy target or kernel degrees.\n')
+    w(' *  \n')
+    w(' *  Each kernel is  f(x) = P(x*x)  (cos) or  x * P(x*x)  (sin, asin), with\n')
+    w(' *  P evaluated by Horner\'s rule in float.  Errors are max relative error\n')
+    w(' *  over the kernel\'s reduced range: "fit" for the ideal polynomial, "float"\n')
+    w(' *  for float coefficients and float arithmetic as run on the watch.\n')
+    w(' *  Each P is also given as a macro, which my_math.c\'s vector forms (host\n')
+    w(' *  builds only) evaluate four lanes at a time.\n')
+    w(' *  Cycle counts are estimates (fmul ~%d, fadd ~%d soft-float cycles).\n' % (fmul, fadd))
+    w(' *  \n')
+    w(' *  Target error: %.1e\n' % target)
+    w(' *  \n')
+    for name, rows, chosen in results:
+        for line in format_table(name, rows, chosen):
+            w(' *%s\n' % line)
+        w(' *  \n')
+    w(' */\n')
+    w('\n')
+    w('#pragma once\n')
+    w('\n')
+    for name, rows, chosen in results:
+        odd, xmax = [(k[1], k[3]) for k in KERNELS if k[0] == name][0]
+        c = chosen['coeffs']
+        #  odd kernels other than asin are used symmetrically about zero
+        lo = -xmax if name != 'asin_core' else 0.0
+        w('\n')
+        w('///  %s on [%.6g, %.6g]: degree %d in x*x, float rel. err. ~= %.1e\n' %
+          (name, lo, xmax, chosen['degree'], chosen['float_err']))
+        expr = '%.9ef' % c[-1]
+        for k in reversed(c[:-1]):
+            expr = '%.9ef + (u) * (%s)' % (k, expr)
+        w('#define %s_POLY(u)  (%s)\n' % (name.upper(), expr))
+        w('\n')
+        w('static inline float %s_poly (float u)\n' % name)
+        w('{\n')
+        w('  return %s_POLY (u);\n' % name.upper())
+        w('}\n')
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('--target-error', type=float, default=1e-6,
+                    help='max relative error (float evaluation) per kernel')
+    ap.add_argument('--max-degree', type=int, default=6,
+                    help='highest degree in x*x to try')
+    ap.add_argument('--fmul-cycles', type=int, default=DEFAULT_FMUL_CYCLES)
+    ap.add_argument('--fadd-cycles', type=int, default=DEFAULT_FADD_CYCLES)
+    ap.add_argument('-o', '--output', default=None,
+                    help='header to write (default: stdout)')
+    args = ap.parse_args()
+
+    results = []
+    for name, odd, g, xmax in KERNELS:
+        rows = fit_kernel(name, odd, g, xmax, range(1, args.max_degree + 1),
+                          args.fmul_cycles, args.fadd_cycles)
+        chosen = choose(rows, args.target_error)
+        results.append((name, rows, chosen))
+
+    if args.output:
+        with open(args.output, 'w') as out:
+            emit_header(out, results, args.target_error,
+                        args.fmul_cycles, args.fadd_cycles)
+    else:
+        emit_header(sys.stdout, results, args.target_error,
+                    args.fmul_cycles, args.fadd_cycles)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,305 @@
+/*
+ *  Check src/angle_map.c, which is off by default (ANGLE_MAP_RENDER) and so
+ *  built here only: over a grid of dawn / dusk times, including bands that
+ *  wrap past midnight and polar days whose outer bands have no dawn / dusk,
+ *  dials rendered from the map must match sunclock.c's path rendering
+ *  (TwilightPath.c, with aplite's dithered greys) wherever the dial shows.
+ *  That covers aplite's class pattern replay in angle_map_set_bands() and
+ *  the nibble packing in angle_map_render(), as well as the color tables.
+ *  (The grey shades all repeat every 4 pixels, so which half of a pattern
+ *  byte a tile takes can't show here; which tile goes in which half can.)
+ *
+ *  A pixel may differ only where the map's quantisation reaches: within a
+ *  step of arc (plus, on aplite, half a tile and one pixel for the path
+ *  fill's edge) of a band edge, or within HUB_RADIUS of the hub, where a
+ *  tile spans a wide angle and the hour hand covers the dial anyway.
+ *  Prints the share of dial pixels that differ, and how many of those are
+ *  near an edge or near the hub.
+ */
+
+#include <math.h>
+
+#include "host_sdk.h"
+
+#include "config.h"
+#include "DayPlan.h"
+#include "dial_spans.h"
+#include "geometry.h"
+#include "rle_mask.h"
+#include "suncalc.h"
+#include "watchface_rle.h"
+
+//  (included, with the map switched on, rather than linked)
+#undef  ANGLE_MAP_RENDER
+#define ANGLE_MAP_RENDER  1
+#include "angle_map.c"
+
+
+///  Radius around the hub within which any difference is allowed.
+#define  HUB_RADIUS   16
+
+///  Largest share of dial pixels allowed to differ, in percent.
+#define  MAX_DIFFERING_PERCENT  3.0
+
+
+float  config_data_get_latitude(void)    { return 0; }
+float  config_data_get_longitude(void)   { return 0; }
+float  config_data_get_tz_in_hours(void) { return 0; }
+
+
+///  The four paths, in drawing order, as sunclock.c creates and fills them.
+static const struct {
+   float                zenith;
+   ScreenPartToEnclose  toEnclose;
+   DitherShade          shade;
+   GColor               color;
+} aPaths[TWI_PATH_COUNT] = {
+   { ZENITH_ASTRONOMICAL, ENCLOSE_SCREEN_BOTTOM, DITHER_NONE,       TWI_COLOR_ASTRO    },
+   { ZENITH_NAUTICAL,     ENCLOSE_SCREEN_TOP,    DITHER_DARK_GREY,  TWI_COLOR_NAUTICAL },
+   { ZENITH_CIVIL,        ENCLOSE_SCREEN_TOP,    DITHER_GREY,       TWI_COLOR_CIVIL    },
+   { ZENITH_OFFICIAL,     ENCLOSE_SCREEN_TOP,    DITHER_LIGHT_GREY, TWI_COLOR_DAYTIME  },
+};
+
+///  Grid: sunrise, sunset, twilight band width, and how many outer bands have no dawn / dusk.
+static const int  aSunrise[]  = { 60, 240, 360, 480, 660 };
+static const int  aSunset[]   = { 780, 960, 1080, 1200, 1380 };
+static const int  aWidth[]    = { 20, 45 };
+#define  POLAR_CASES  3
+
+static const GRect  frame = { { 0, 0 }, { HOST_SCREEN_W, HOST_SCREEN_H } };
+
+
+///  The path renderer, as graphics_night_layer_update_callback() runs it.
+static void  render_paths(TwilightPath **apPaths, const TwilightBand *aBands)
+{
+
+#ifdef PBL_ROUND
+   graphics_context_set_fill_color(NULL, TWI_COLOR_NIGHT);
+   graphics_fill_radial(NULL, twilight_path_dial_rect(frame), GOvalScaleModeFitCircle,
+                        USABLE_FACE_RADIUS, 0, TRIG_MAX_ANGLE);
+#elif defined(PBL_COLOR)
+   graphics_context_set_fill_color(NULL, TWI_COLOR_NIGHT);
+   graphics_fill_rect(NULL, frame, 1, 0);
+#else
+   memset(host_frame_buffer.data, 0xFF, HOST_SCREEN_BYTES);
+#endif
+
+   for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+   {
+      twilight_path_render(apPaths[i], &aBands[i], NULL, aPaths[i].color, frame);
+   }
+
+}
+
+
+///  Is (x, y) part of the dial as it shows: inside the dial proper, or on aplite left by the mask?
+static bool  aafDial[HOST_SCREEN_H][HOST_SCREEN_W];
+
+static void  find_dial(void)
+{
+
+#ifdef PBL_PLATFORM_APLITE
+   static uint8_t  aOnWhite[HOST_SCREEN_BYTES];
+
+   memset(host_frame_buffer.data, 0xFF, HOST_SCREEN_BYTES);
+   rle_mask_draw(&watchfaceRleMask, NULL, GPoint(0, 0));
+   memcpy(aOnWhite, host_frame_buffer.data, HOST_SCREEN_BYTES);
+   memset(host_frame_buffer.data, 0x00, HOST_SCREEN_BYTES);
+   rle_mask_draw(&watchfaceRleMask, NULL, GPoint(0, 0));
+
+   for (int y = 0;  y < HOST_SCREEN_H;  y++)
+   {
+      for (int x = 0;  x < HOST_SCREEN_W;  x++)
+      {
+         int  iByte = y * HOST_SCREEN_ROW_BYTES + x / 8;
+
+         aafDial[y][x] = ((aOnWhite[iByte] >> (x & 7)) & 1) &&
+                         ! ((host_frame_buffer.data[iByte] >> (x & 7)) & 1);
+      }
+   }
+#else
+   for (int y = 0;  y < HOST_SCREEN_H;  y++)
+   {
+      int16_t  x0, x1;
+
+      if (dial_spans_get_row(y, &x0, &x1))
+      {
+         for (int x = x0;  x <= x1;  x++)
+         {
+            aafDial[y][x] = host_fb_on_screen(x, y);
+         }
+      }
+   }
+#endif
+
+}
+
+
+/**
+ *  Is (x, y) close enough to one of the painted bands' edges for the map's
+ *  quantisation to reach it?
+ */
+static bool  near_band_edge(int x, int y, const TwilightBand *aBands)
+{
+
+   int     dx = x - FACE_CENTER_X, dy = y - FACE_CENTER_Y;
+   double  r  = sqrt(dx * dx + dy * dy);
+   double  reach = r * 2 * M_PI / ANGLE_MAP_STEPS + ANGLE_MAP_TILE * M_SQRT1_2 + 1;
+
+   //  angle from midnight, clockwise, as the dial shows it
+   double  angle = atan2(dy, dx) - M_PI / 2;
+
+   for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+   {
+      if ((aBands[i].sDawnMinute == NO_RISE_SET_MINUTE) || (aBands[i].sDuskMinute == NO_RISE_SET_MINUTE))
+      {
+         continue;
+      }
+
+      int  aEdges[2] = { aBands[i].sDawnMinute, aBands[i].sDuskMinute };
+
+      for (int e = 0;  e < 2;  e++)
+      {
+         double  delta = angle - 2 * M_PI * aEdges[e] / MINUTES_PER_DAY;
+
+         //  distance from the edge's ray, on its side of the hub
+         if ((cos(delta) > 0) && (r * fabs(sin(delta)) <= reach))
+         {
+            return true;
+         }
+      }
+   }
+   return false;
+
+}
+
+
+int  main(void)
+{
+
+   static uint8_t  aPathsRendered[HOST_SCREEN_BYTES];
+
+#ifndef PBL_PLATFORM_APLITE
+   dial_spans_init();
+#endif
+   find_dial();
+
+   HOST_CHECK(angle_map_create(), "can't create the angle map");
+
+   TwilightPath * apPaths[TWI_PATH_COUNT];
+   GColor         aColors[TWI_PATH_COUNT];
+
+   for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+   {
+      apPaths[i] = twilight_path_create(aPaths[i].zenith, aPaths[i].toEnclose, aPaths[i].shade);
+      aColors[i] = aPaths[i].color;
+   }
+
+   long  cDialPixels = 0, cDiffering = 0, cNearEdge = 0, cNearHub = 0;
+   int   cDials = 0;
+
+   int  cCases = ARRAY_LENGTH(aSunrise) * ARRAY_LENGTH(aSunset) * ARRAY_LENGTH(aWidth) * POLAR_CASES;
+
+   for (int iCase = 0;  iCase < cCases;  iCase++)
+   {
+      int  cPolar = iCase % POLAR_CASES;
+      int  iWidth = iCase / POLAR_CASES % ARRAY_LENGTH(aWidth);
+      int  iSet   = iCase / POLAR_CASES / ARRAY_LENGTH(aWidth) % ARRAY_LENGTH(aSunset);
+      int  iRise  = iCase / POLAR_CASES / ARRAY_LENGTH(aWidth) / ARRAY_LENGTH(aSunset);
+
+      TwilightBand  aBands[TWI_PATH_COUNT];
+
+      //  outermost band first: each widens the one inside it by a band width
+      for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+      {
+         int  widen = (TWI_PATH_COUNT - 1 - i) * aWidth[iWidth];
+
+         if (i < cPolar)
+         {
+            aBands[i].sDawnMinute = aBands[i].sDuskMinute = NO_RISE_SET_MINUTE;
+         }
+         else
+         {
+            aBands[i].sDawnMinute = (aSunrise[iRise] - widen + MINUTES_PER_DAY) % MINUTES_PER_DAY;
+            aBands[i].sDuskMinute = (aSunset[iSet] + widen) % MINUTES_PER_DAY;
+         }
+      }
+
+      render_paths(apPaths, aBands);
+      memcpy(aPathsRendered, host_frame_buffer.data, HOST_SCREEN_BYTES);
+
+      host_fb_scramble(cDials);
+#ifdef PBL_COLOR
+      angle_map_set_bands(apPaths, aBands, aColors, TWI_PATH_COUNT, TWI_COLOR_NIGHT);
+#else
+      angle_map_set_bands(apPaths, aBands, aColors, TWI_PATH_COUNT, GColorWhite);
+#endif
+      angle_map_render(NULL);
+
+      int  cOther = 0;
+
+      for (int y = 0;  y < HOST_SCREEN_H;  y++)
+      {
+         for (int x = 0;  x < HOST_SCREEN_W;  x++)
+         {
+            if (! aafDial[y][x])
+            {
+               continue;
+            }
+            cDialPixels++;
+
+#ifdef PBL_COLOR
+            GColor  colorPaths = { .argb = aPathsRendered[y * HOST_SCREEN_ROW_BYTES + x] };
+#else
+            GColor  colorPaths = ((aPathsRendered[y * HOST_SCREEN_ROW_BYTES + x / 8] >> (x & 7)) & 1)
+                                    ? GColorWhite : GColorBlack;
+#endif
+            if (gcolor_equal(colorPaths, host_fb_get(x, y)))
+            {
+               continue;
+            }
+            cDiffering++;
+
+            int  dx = x - FACE_CENTER_X, dy = y - FACE_CENTER_Y;
+
+            if (dx * dx + dy * dy <= HUB_RADIUS * HUB_RADIUS)
+            {
+               cNearHub++;
+            }
+            else if (near_band_edge(x, y, aBands))
+            {
+               cNearEdge++;
+            }
+            else if (cOther++ == 0)
+            {
+               printf("  sunrise %d sunset %d width %d, %d polar: first pixel off an edge, (%d, %d)\n",
+                      aSunrise[iRise], aSunset[iSet], aWidth[iWidth], cPolar, x, y);
+            }
+         }
+      }
+
+      HOST_CHECK(cOther == 0, "sunrise %d sunset %d width %d, %d polar: %d pixels differ away from any edge",
+                 aSunrise[iRise], aSunset[iSet], aWidth[iWidth], cPolar, cOther);
+      cDials++;
+   }
+
+   double  percent = 100.0 * cDiffering / cDialPixels;
+
+   HOST_CHECK(percent <= MAX_DIFFERING_PERCENT, "%.2f%% of dial pixels differ, over %.1f%%",
+              percent, MAX_DIFFERING_PERCENT);
+
+   printf("  %d dials, map %u bytes: %.2f%% of dial pixels differ from the paths;\n"
+          "  of those %.0f%% near a band edge, %.0f%% within %d px of the hub\n",
+          cDials, (unsigned) angle_map_get_size(), percent,
+          cDiffering ? 100.0 * cNearEdge / cDiffering : 0.0,
+          cDiffering ? 100.0 * cNearHub  / cDiffering : 0.0, HUB_RADIUS);
+
+   for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+   {
+      twilight_path_destroy(apPaths[i]);
+   }
+   angle_map_destroy();
+
+   return host_failures != 0;
+
+}
@@ -0,0 +1,136 @@
+/*
+ *  Check src/DayPlan.c: a plan built in time slices matches one built on
+ *  the spot, and a saved plan round-trips through persistent storage but is
+ *  refused for a different day, location, time zone or time format, or if
+ *  the record is corrupt.  Prints the saved record's size.
+ *
+ *  Bands are computed by the real TwilightPath.c and suncalc.c, for a
+ *  fixed location (ConfigData.c's getters are stood in for below).
+ */
+
+#include "host_sdk.h"
+
+#include "arena.h"
+#include "DayPlan.h"
+#include "suncalc.h"
+
+
+///  As in DayPlan.c.
+#define  DAY_PLAN_PERSIST_KEY  2
+
+
+static float  fLatitude   = 40.0f;
+static float  fLongitude  = -105.0f;
+static float  fTzInHours  = -7.0f;
+
+float  config_data_get_latitude(void)    { return fLatitude;  }
+float  config_data_get_longitude(void)   { return fLongitude; }
+float  config_data_get_tz_in_hours(void) { return fTzInHours; }
+
+
+static int  cReady = 0;
+
+static void  on_ready(void)
+{
+   cReady++;
+}
+
+
+static struct tm  make_day(int year, int month, int mday)
+{
+
+   struct tm  day = { 0 };
+
+   day.tm_year = year - 1900;
+   day.tm_mon  = month - 1;
+   day.tm_mday = mday;
+   return day;
+
+}
+
+
+int  main(void)
+{
+
+   TwilightPath * apPaths[TWI_PATH_COUNT];
+
+   arena_create(1024);
+   apPaths[TWI_PATH_NIGHT]    = twilight_path_create(ZENITH_ASTRONOMICAL, ENCLOSE_SCREEN_BOTTOM, DITHER_NONE);
+   apPaths[TWI_PATH_ASTRO]    = twilight_path_create(ZENITH_NAUTICAL,     ENCLOSE_SCREEN_TOP,    DITHER_NONE);
+   apPaths[TWI_PATH_NAUTICAL] = twilight_path_create(ZENITH_CIVIL,        ENCLOSE_SCREEN_TOP,    DITHER_NONE);
+   apPaths[TWI_PATH_CIVIL]    = twilight_path_create(ZENITH_OFFICIAL,     ENCLOSE_SCREEN_TOP,    DITHER_NONE);
+
+   struct tm  today    = make_day(2026, 6, 21);
+   struct tm  tomorrow = make_day(2026, 6, 22);
+
+   //  built on the spot
+   day_plan_init(apPaths);
+   day_plan_build_spare(&tomorrow);
+   day_plan_swap();
+
+   DayPlan  direct = *day_plan_get_active();
+
+   HOST_CHECK(direct.fValid, "plan not valid");
+
+   //  built in time slices
+   day_plan_init(apPaths);
+   day_plan_build_spare_async(&tomorrow, on_ready);
+   HOST_CHECK(! day_plan_spare_is_for(&tomorrow), "spare finished before any slice ran");
+
+   int  cSlices = host_run_timers();
+
+   HOST_CHECK(cReady == 1, "ready handler called %d times", cReady);
+   HOST_CHECK(day_plan_spare_is_for(&tomorrow), "sliced build did not finish");
+   HOST_CHECK(day_plan_equal(&direct, day_plan_swap()), "sliced build differs from direct build");
+   printf("  sliced build: %d timer callbacks\n", cSlices);
+
+   //  save, and restore after a restart
+   day_plan_init(apPaths);
+   day_plan_build_spare(&today);
+   day_plan_swap();
+   day_plan_save_active();
+
+   DayPlan  saved = *day_plan_get_active();
+   size_t   cbRecord = 0;
+   uint8_t *pRecord = host_persist_data(DAY_PLAN_PERSIST_KEY, &cbRecord);
+
+   HOST_CHECK(pRecord != NULL, "nothing saved");
+   printf("  saved record: %u bytes (limit %u)\n", (unsigned) cbRecord, PERSIST_DATA_MAX_LENGTH);
+
+   day_plan_init(apPaths);
+   HOST_CHECK(day_plan_restore(&today), "restore refused");
+   HOST_CHECK((day_plan_get_active() != NULL) && day_plan_equal(&saved, day_plan_get_active()),
+              "restored plan differs from saved");
+
+   day_plan_build_spare(&today);
+   HOST_CHECK(day_plan_spare_matches_active(), "rebuilt plan differs from restored");
+
+   //  refusals
+   day_plan_init(apPaths);
+   HOST_CHECK(! day_plan_restore(&tomorrow), "restored for another day");
+
+   fLatitude += 1.0f;
+   HOST_CHECK(! day_plan_restore(&today), "restored for another latitude");
+   fLatitude -= 1.0f;
+
+   fTzInHours += 1.0f;
+   HOST_CHECK(! day_plan_restore(&today), "restored for another time zone");
+   fTzInHours -= 1.0f;
+
+   host_clock_24h = false;
+   HOST_CHECK(! day_plan_restore(&today), "restored for another time format");
+   host_clock_24h = true;
+
+   HOST_CHECK(day_plan_restore(&today), "restore refused once config was put back");
+
+   if (pRecord != NULL)
+   {
+      pRecord[cbRecord / 2] ^= 0x01;
+      day_plan_init(apPaths);
+      HOST_CHECK(! day_plan_restore(&today), "restored a corrupt record");
+      HOST_CHECK(day_plan_get_active() == NULL, "corrupt record left a plan active");
+   }
+
+   return host_failures != 0;
+
+}
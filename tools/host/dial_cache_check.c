@@ -0,0 +1,186 @@
+/*
+ *  Check src/dial_cache.c: a dial rendered as sunclock.c's draw_dial()
+ *  renders it (bands from a real DayPlan, then aplite's RLE watchface
+ *  mask or the color platforms' hour marks and dial mask) is encoded by
+ *  encode_frame_buffer(), captured, and drawn back over a scrambled frame
+ *  buffer by dial_cache_draw(), which must restore every on-screen pixel.
+ *  Each dial must encode within DIAL_CACHE_MAX_BYTES.  Prints, for sample
+ *  days from equinox to polar summer, the runs (one memset each per blit)
+ *  and their bytes, against the raw frame buffer bytes.
+ *
+ *  The host draws without anti-aliasing, which on the watch adds blended
+ *  pixels, and so runs, along band edges and hour marks on color
+ *  platforms: there these are lower bounds.
+ *
+ *  dial_cache.c is included, rather than linked, to get at
+ *  encode_frame_buffer().
+ */
+
+#include "host_sdk.h"
+
+#include "arena.h"
+#include "DayPlan.h"
+#include "dial_mask_path.h"
+#include "dial_spans.h"
+#include "rle_mask.h"
+#include "suncalc.h"
+#include "watchface_rle.h"
+
+#include "dial_cache.c"
+
+
+static float  fLatitude, fLongitude, fTzInHours;
+
+float  config_data_get_latitude(void)    { return fLatitude;  }
+float  config_data_get_longitude(void)   { return fLongitude; }
+float  config_data_get_tz_in_hours(void) { return fTzInHours; }
+
+
+static const struct {
+   const char * pszName;
+   float        latitude, longitude, tzInHours;
+   int          year, month, mday;
+} aDays[] = {
+   { "London, equinox",       51.5f,  -0.1f,  0, 2026,  3, 20 },
+   { "London, midwinter",     51.5f,  -0.1f,  0, 2026, 12, 21 },
+   { "London, midsummer",     51.5f,  -0.1f,  1, 2026,  6, 21 },
+   { "Helsinki, midsummer",   60.2f,  24.9f,  3, 2026,  6, 21 },
+   { "Tromso, polar summer",  69.6f,  18.9f,  2, 2026,  5, 10 },
+};
+
+///  Colors the bands are painted in, as graphics_night_layer_update_callback() paints them.
+static const GColor  aBandColors[TWI_PATH_COUNT] = {
+   TWI_COLOR_ASTRO, TWI_COLOR_NAUTICAL, TWI_COLOR_CIVIL, TWI_COLOR_DAYTIME
+};
+
+static const GRect  frame = { { 0, 0 }, { HOST_SCREEN_W, HOST_SCREEN_H } };
+
+
+///  The dial as draw_dial() renders it at the full quality tier.
+static void  render_dial(TwilightPath **apPaths, const DayPlan *pPlan)
+{
+
+#ifdef PBL_ROUND
+   graphics_context_set_fill_color(NULL, TWI_COLOR_NIGHT);
+   graphics_fill_radial(NULL, twilight_path_dial_rect(frame), GOvalScaleModeFitCircle,
+                        USABLE_FACE_RADIUS, 0, TRIG_MAX_ANGLE);
+#elif defined(PBL_COLOR)
+   graphics_context_set_fill_color(NULL, TWI_COLOR_NIGHT);
+   graphics_fill_rect(NULL, frame, 1, 0);
+#else
+   memset(host_frame_buffer.data, 0xFF, HOST_SCREEN_BYTES);
+#endif
+
+   for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+   {
+      twilight_path_render(apPaths[i], &pPlan->aBands[i], NULL, aBandColors[i], frame);
+   }
+
+#ifdef PBL_PLATFORM_APLITE
+   rle_mask_draw(&watchfaceRleMask, NULL, frame.origin);
+#else
+   draw_watchface_mask(NULL, frame);
+#endif
+
+}
+
+
+///  On-screen pixels which differ between the frame buffer and a copy of it.
+static int  pixels_differing(const uint8_t *pCopy)
+{
+
+   uint8_t * pScreen = host_frame_buffer.data;
+   int       cPixels = 0;
+
+   host_frame_buffer.data = (uint8_t *) pCopy;
+
+   for (int y = 0;  y < HOST_SCREEN_H;  y++)
+   {
+      for (int x = 0;  x < HOST_SCREEN_W;  x++)
+      {
+         if (host_fb_on_screen(x, y))
+         {
+            GColor  colorCopy = host_fb_get(x, y);
+
+            host_frame_buffer.data = pScreen;
+            cPixels += ! gcolor_equal(colorCopy, host_fb_get(x, y));
+            host_frame_buffer.data = (uint8_t *) pCopy;
+         }
+      }
+   }
+
+   host_frame_buffer.data = pScreen;
+   return cPixels;
+
+}
+
+
+int  main(void)
+{
+
+   static uint8_t  aRendered[HOST_SCREEN_BYTES];
+
+   TwilightPath * apPaths[TWI_PATH_COUNT];
+
+   arena_create(1024);
+   apPaths[TWI_PATH_NIGHT]    = twilight_path_create(ZENITH_ASTRONOMICAL, ENCLOSE_SCREEN_BOTTOM,
+                                                     DITHER_NONE);
+   apPaths[TWI_PATH_ASTRO]    = twilight_path_create(ZENITH_NAUTICAL,     ENCLOSE_SCREEN_TOP,
+                                                     TWI_APLITE_SHADE_ONLY(DITHER_DARK_GREY));
+   apPaths[TWI_PATH_NAUTICAL] = twilight_path_create(ZENITH_CIVIL,        ENCLOSE_SCREEN_TOP,
+                                                     TWI_APLITE_SHADE_ONLY(DITHER_GREY));
+   apPaths[TWI_PATH_CIVIL]    = twilight_path_create(ZENITH_OFFICIAL,     ENCLOSE_SCREEN_TOP,
+                                                     TWI_APLITE_SHADE_ONLY(DITHER_LIGHT_GREY));
+   day_plan_init(apPaths);
+
+#ifndef PBL_PLATFORM_APLITE
+   dial_spans_init();
+#endif
+
+   printf("  %-22s %8s %8s %8s\n", "", "runs", "bytes", "raw");
+
+   size_t  cbMost = 0;
+
+   for (unsigned iDay = 0;  iDay < ARRAY_LENGTH(aDays);  iDay++)
+   {
+      struct tm  tmDay = { .tm_year = aDays[iDay].year - 1900, .tm_mon = aDays[iDay].month - 1,
+                           .tm_mday = aDays[iDay].mday };
+
+      fLatitude  = aDays[iDay].latitude;
+      fLongitude = aDays[iDay].longitude;
+      fTzInHours = aDays[iDay].tzInHours;
+
+      day_plan_build_spare(&tmDay);
+      render_dial(apPaths, day_plan_swap());
+      memcpy(aRendered, host_frame_buffer.data, HOST_SCREEN_BYTES);
+
+      size_t  cbRaw;
+      size_t  cbRuns = encode_frame_buffer(&host_frame_buffer, NULL, &cbRaw);
+
+      cbMost = (cbRuns > cbMost) ? cbRuns : cbMost;
+
+      dial_cache_capture(NULL);
+      HOST_CHECK(dial_cache_get_size() == cbRuns, "%s: %u bytes of runs, %u cached, over %u",
+                 aDays[iDay].pszName, (unsigned) cbRuns, (unsigned) dial_cache_get_size(),
+                 (unsigned) DIAL_CACHE_MAX_BYTES);
+
+      host_fb_scramble(iDay);
+      HOST_CHECK(dial_cache_draw(NULL), "%s: nothing drawn from the cache", aDays[iDay].pszName);
+
+      int  cPixels = pixels_differing(aRendered);
+
+      HOST_CHECK(cPixels == 0, "%s: %d pixels not restored by dial_cache_draw()",
+                 aDays[iDay].pszName, cPixels);
+
+      printf("  %-22s %8u %8u %8u\n", aDays[iDay].pszName, (unsigned) cbRuns / 2,
+             (unsigned) cbRuns, (unsigned) cbRaw);
+   }
+
+   printf("  (runs restored exactly; most bytes of runs %u, against DIAL_CACHE_MAX_BYTES %u)\n",
+          (unsigned) cbMost, (unsigned) DIAL_CACHE_MAX_BYTES);
+
+   dial_cache_destroy();
+
+   return host_failures != 0;
+
+}
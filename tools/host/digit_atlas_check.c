@@ -0,0 +1,152 @@
+/*
+ *  Check src/digit_atlas.c with a synthetic font (below): building the
+ *  atlas must leave the frame buffer cell it borrows exactly as it was, and
+ *  drawing times from the atlas must give the same pixels as drawing them
+ *  with the font.  Prints the atlas's size and the host time of a blit.
+ */
+
+#include "host_sdk.h"
+
+#include "digit_atlas.h"
+
+
+///  Height of the box the time is drawn in, as face_overlay.c has it.
+#define  TIME_BOX_HEIGHT  42
+
+static GColor  textColor;
+
+
+void  graphics_context_set_text_color(GContext *ctx, GColor color)
+{
+   (void) ctx;
+   textColor = color;
+}
+
+
+//  The synthetic font: proportional, with a speckled ink pattern per glyph
+//  so that a glyph drawn from the wrong mask, or a pixel off, shows.
+
+static int  glyph_advance(char c)
+{
+   return (c == ':') ? 9 : 18 + (c % 3);
+}
+
+
+static bool  glyph_inked(char c, int x, int y)
+{
+
+   if (c == ':')
+   {
+      return (x >= 2) && (x <= 6) && (((y >= 14) && (y <= 19)) || ((y >= 30) && (y <= 35)));
+   }
+   return (x >= 1) && (x <= glyph_advance(c) - 2) && (y >= 7) && (y <= 37) &&
+          ((x * 7 + y * 3 + c) % 5 != 0);
+
+}
+
+
+GSize  graphics_text_layout_get_content_size(const char *pszText, GFont font, GRect box,
+                                             GTextOverflowMode overflow, GTextAlignment alignment)
+{
+
+   (void) font;
+   (void) box;
+   (void) overflow;
+   (void) alignment;
+
+   int  w = 0;
+
+   for (;  *pszText != '\0';  pszText++)
+   {
+      w += glyph_advance(*pszText);
+   }
+   return GSize(w, 38);
+
+}
+
+
+void  graphics_draw_text(GContext *ctx, const char *pszText, GFont font, GRect box,
+                         GTextOverflowMode overflow, GTextAlignment alignment,
+                         GTextAttributes *pAttributes)
+{
+
+   (void) pAttributes;
+
+   int  w  = graphics_text_layout_get_content_size(pszText, font, box, overflow, alignment).w;
+   int  x0 = (alignment == GTextAlignmentCenter) ? box.origin.x + (box.size.w - w) / 2 : box.origin.x;
+
+   (void) ctx;
+
+   for (;  *pszText != '\0';  pszText++)
+   {
+      for (int y = 0;  y < box.size.h;  y++)
+      {
+         for (int x = 0;  x < glyph_advance(*pszText);  x++)
+         {
+            int  sx = x0 + x;
+
+            //  (clipped to the box, as the firmware clips text)
+            if ((sx >= box.origin.x) && (sx < box.origin.x + box.size.w) && glyph_inked(*pszText, x, y))
+            {
+               host_fb_set(sx, box.origin.y + y, textColor);
+            }
+         }
+      }
+      x0 += glyph_advance(*pszText);
+   }
+
+}
+
+
+static const GRect  timeBox = { { 0, 36 }, { HOST_SCREEN_W, TIME_BOX_HEIGHT } };
+
+static void  time_blit(int i)
+{
+   (void) i;
+   digit_atlas_draw(NULL, "23:59", timeBox, GColorBlack);
+}
+
+
+int  main(void)
+{
+
+   static uint8_t  aBefore[HOST_SCREEN_BYTES];
+   static uint8_t  aExpected[HOST_SCREEN_BYTES];
+
+   GFont  font = (GFont) &textColor;
+
+   host_fb_scramble(1);
+   memcpy(aBefore, host_frame_buffer.data, HOST_SCREEN_BYTES);
+
+   HOST_CHECK(digit_atlas_build(NULL, font, TIME_BOX_HEIGHT), "atlas build failed");
+   HOST_CHECK(memcmp(aBefore, host_frame_buffer.data, HOST_SCREEN_BYTES) == 0,
+              "frame buffer not restored after the build");
+   printf("  atlas: %u bytes of heap\n", (unsigned) digit_atlas_get_size());
+
+   const char * const  apszTimes[] = { "0:00", "12:34", "23:59", "8:07", "10:11", "19:58" };
+
+   for (unsigned i = 0;  i < ARRAY_LENGTH(apszTimes);  i++)
+   {
+      memcpy(host_frame_buffer.data, aBefore, HOST_SCREEN_BYTES);
+      graphics_context_set_text_color(NULL, GColorBlack);
+      graphics_draw_text(NULL, apszTimes[i], font, timeBox, GTextOverflowModeWordWrap,
+                         GTextAlignmentCenter, NULL);
+      memcpy(aExpected, host_frame_buffer.data, HOST_SCREEN_BYTES);
+
+      memcpy(host_frame_buffer.data, aBefore, HOST_SCREEN_BYTES);
+      HOST_CHECK(digit_atlas_draw(NULL, apszTimes[i], timeBox, GColorBlack),
+                 "\"%s\": not drawn from the atlas", apszTimes[i]);
+      HOST_CHECK(memcmp(aExpected, host_frame_buffer.data, HOST_SCREEN_BYTES) == 0,
+                 "\"%s\": atlas pixels differ from the font's", apszTimes[i]);
+   }
+
+   HOST_CHECK(! digit_atlas_draw(NULL, "12:3a", timeBox, GColorBlack), "drew a character not in the atlas");
+
+   printf("  host us per \"23:59\" blit: %.2f\n", host_time_us(100000, time_blit));
+
+   digit_atlas_destroy();
+   HOST_CHECK(! digit_atlas_is_built() && (digit_atlas_get_size() == 0), "atlas not released");
+
+   return host_failures != 0;
+
+}
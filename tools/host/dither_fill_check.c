@@ -0,0 +1,232 @@
+/*
+ *  Check aplite's dithered band fills (src/dither_fill.c, as
+ *  TwilightPath.c uses them) against the rendering they replaced: for each
+ *  grey band, the grey tile bitmap AND-blitted over the whole screen, then
+ *  the band's path filled on top.  Dials are rendered both ways, in
+ *  sunclock.c's order, for a set of sample days from equinox to polar
+ *  summer.  They may differ only in pixels on a band's edge, where the two
+ *  fills' edge rules meet: at most MAX_EDGE_PIXELS per dial, counted both
+ *  over the whole screen and where the watchface mask leaves the dial
+ *  showing.  Prints those counts, and the frame buffer bytes the grey
+ *  shades write per dial, against the tile blits' 3 x 3024.
+ *
+ *  TwilightPath.c is included, rather than linked, to get at the polygons
+ *  it hands dither_fill_polygon().
+ */
+
+#include "host_sdk.h"
+
+#include "DayPlan.h"
+#include "rle_mask.h"
+#include "watchface_rle.h"
+
+
+///  Most pixels a dial may differ by from the tile rendering.
+#define  MAX_EDGE_PIXELS  64
+
+
+static float  fLatitude, fLongitude, fTzInHours;
+
+float  config_data_get_latitude(void)    { return fLatitude;  }
+float  config_data_get_longitude(void)   { return fLongitude; }
+float  config_data_get_tz_in_hours(void) { return fTzInHours; }
+
+
+#include "TwilightPath.c"
+
+
+/**
+ *  The grey tiles as they were (light_grey.png, grey.png, dark_grey.png,
+ *  32 x 4 each), '#' black: the reference, kept apart from dither_fill.c's
+ *  own pattern bytes.
+ */
+static const char * const  aapszTiles[DITHER_SHADE_COUNT][4] = {
+   [DITHER_LIGHT_GREY] = { "#...#...#...#...#...#...#...#...",
+                           ".#...#...#...#...#...#...#...#..",
+                           "...#...#...#...#...#...#...#...#",
+                           "..#...#...#...#...#...#...#...#." },
+   [DITHER_GREY]       = { "#.#.#.#.#.#.#.#.#.#.#.#.#.#.#.#.",
+                           ".#.#.#.#.#.#.#.#.#.#.#.#.#.#.#.#",
+                           "#..##..##..##..##..##..##..##..#",
+                           ".##..##..##..##..##..##..##..##." },
+   [DITHER_DARK_GREY]  = { "#.###.###.###.###.###.###.###.##",
+                           ".###.###.###.###.###.###.###.###",
+                           "##.###.###.###.###.###.###.###.#",
+                           "###.###.###.###.###.###.###.###." },
+};
+
+
+static const struct {
+   const char * pszName;
+   float        latitude, longitude, tzInHours;
+   int          year, month, mday;
+} aDays[] = {
+   { "London, equinox",       51.5f,  -0.1f,  0, 2026,  3, 20 },
+   { "London, midwinter",     51.5f,  -0.1f,  0, 2026, 12, 21 },
+   { "London, midsummer",     51.5f,  -0.1f,  1, 2026,  6, 21 },
+   { "Helsinki, midsummer",   60.2f,  24.9f,  3, 2026,  6, 21 },
+   { "Tromso, polar summer",  69.6f,  18.9f,  2, 2026,  5, 10 },
+};
+
+
+///  The four paths, in drawing order, as sunclock.c creates and fills them.
+static const struct {
+   float                zenith;
+   ScreenPartToEnclose  toEnclose;
+   DitherShade          shade;
+   GColor               color;
+} aPaths[TWI_PATH_COUNT] = {
+   { ZENITH_ASTRONOMICAL, ENCLOSE_SCREEN_BOTTOM, DITHER_NONE,       TWI_COLOR_ASTRO    },
+   { ZENITH_NAUTICAL,     ENCLOSE_SCREEN_TOP,    DITHER_DARK_GREY,  TWI_COLOR_NAUTICAL },
+   { ZENITH_CIVIL,        ENCLOSE_SCREEN_TOP,    DITHER_GREY,       TWI_COLOR_CIVIL    },
+   { ZENITH_OFFICIAL,     ENCLOSE_SCREEN_TOP,    DITHER_LIGHT_GREY, TWI_COLOR_DAYTIME  },
+};
+
+static const GRect  frame = { { 0, 0 }, { HOST_SCREEN_W, HOST_SCREEN_H } };
+
+
+///  The old grey: a tile AND-blitted over the whole screen.
+static void  and_tile(DitherShade shade)
+{
+
+   for (int y = 0;  y < HOST_SCREEN_H;  y++)
+   {
+      for (int x = 0;  x < HOST_SCREEN_W;  x++)
+      {
+         if (aapszTiles[shade][y % 4][x % 32] == '#')
+         {
+            host_fb_set(x, y, GColorBlack);
+         }
+      }
+   }
+
+}
+
+
+static void  render_dial(TwilightPath **apPaths, const TwilightBand *aBands, bool fTiles)
+{
+
+   memset(host_frame_buffer.data, 0xFF, HOST_SCREEN_BYTES);
+
+   for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+   {
+      //  (the old code returned before the blit for a band with no dawn / dusk)
+      if (fTiles && (aPaths[i].shade != DITHER_NONE) &&
+          (aBands[i].sDawnMinute != NO_RISE_SET_MINUTE) && (aBands[i].sDuskMinute != NO_RISE_SET_MINUTE))
+      {
+         and_tile(aPaths[i].shade);
+      }
+      twilight_path_render(apPaths[i], &aBands[i], NULL, aPaths[i].color, frame);
+   }
+
+}
+
+
+static int  pixels_differing(const uint8_t *pA, const uint8_t *pB)
+{
+
+   int  cPixels = 0;
+
+   for (int i = 0;  i < HOST_SCREEN_BYTES;  i++)
+   {
+      cPixels += __builtin_popcount(pA[i] ^ pB[i]);
+   }
+   return cPixels;
+
+}
+
+
+int  main(void)
+{
+
+   static uint8_t  aTiled[HOST_SCREEN_BYTES];
+
+   TwilightPath * apDithered[TWI_PATH_COUNT];
+   TwilightPath * apPlain[TWI_PATH_COUNT];
+
+   for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+   {
+      apDithered[i] = twilight_path_create(aPaths[i].zenith, aPaths[i].toEnclose, aPaths[i].shade);
+      apPlain[i]    = twilight_path_create(aPaths[i].zenith, aPaths[i].toEnclose, DITHER_NONE);
+   }
+
+   printf("  %-22s %8s %8s %8s\n", "", "pixels", "visible", "bytes");
+
+   for (unsigned iDay = 0;  iDay < ARRAY_LENGTH(aDays);  iDay++)
+   {
+      TwilightBand  aBands[TWI_PATH_COUNT];
+      struct tm     tmDay = { .tm_year = aDays[iDay].year - 1900, .tm_mon = aDays[iDay].month - 1,
+                              .tm_mday = aDays[iDay].mday };
+
+      fLatitude  = aDays[iDay].latitude;
+      fLongitude = aDays[iDay].longitude;
+      fTzInHours = aDays[iDay].tzInHours;
+
+      for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+      {
+         twilight_path_compute_current(apDithered[i], &tmDay, &aBands[i]);
+      }
+
+      //  both ways, bare and under the watchface mask
+      render_dial(apPlain, aBands, true);
+      memcpy(aTiled, host_frame_buffer.data, HOST_SCREEN_BYTES);
+      render_dial(apDithered, aBands, false);
+
+      int  cPixels = pixels_differing(aTiled, host_frame_buffer.data);
+
+      static uint8_t  aDithered[HOST_SCREEN_BYTES];
+      memcpy(aDithered, host_frame_buffer.data, HOST_SCREEN_BYTES);
+
+      memcpy(host_frame_buffer.data, aTiled, HOST_SCREEN_BYTES);
+      rle_mask_draw(&watchfaceRleMask, NULL, GPoint(0, 0));
+      memcpy(aTiled, host_frame_buffer.data, HOST_SCREEN_BYTES);
+      memcpy(host_frame_buffer.data, aDithered, HOST_SCREEN_BYTES);
+      rle_mask_draw(&watchfaceRleMask, NULL, GPoint(0, 0));
+
+      int  cVisible = pixels_differing(aTiled, host_frame_buffer.data);
+
+      HOST_CHECK((cPixels <= MAX_EDGE_PIXELS) && (cVisible <= MAX_EDGE_PIXELS),
+                 "%s: %d pixels unlike the tile rendering, %d of them visible",
+                 aDays[iDay].pszName, cPixels, cVisible);
+
+      //  bytes the grey shades write: every pattern byte has a black pixel,
+      //  so each one written over white changes
+      int  cbWritten = 0;
+
+      for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+      {
+         if ((aPaths[i].shade == DITHER_NONE) || (aBands[i].sDawnMinute == NO_RISE_SET_MINUTE) ||
+             (aBands[i].sDuskMinute == NO_RISE_SET_MINUTE))
+         {
+            continue;
+         }
+
+         ScreenPartToEnclose  other  = (aPaths[i].toEnclose == ENCLOSE_SCREEN_TOP) ? ENCLOSE_SCREEN_BOTTOM
+                                                                                   : ENCLOSE_SCREEN_TOP;
+         int                  cOther = build_band_points(&aBands[i], other, aScratchPoints);
+
+         memset(host_frame_buffer.data, 0xFF, HOST_SCREEN_BYTES);
+         dither_fill_polygon(NULL, aScratchPoints, cOther, GPoint(FACE_CENTER_X, FACE_CENTER_Y),
+                             aPaths[i].shade);
+         for (int b = 0;  b < HOST_SCREEN_BYTES;  b++)
+         {
+            cbWritten += (host_frame_buffer.data[b] != 0xFF);
+         }
+      }
+
+      printf("  %-22s %8d %8d %8d\n", aDays[iDay].pszName, cPixels, cVisible, cbWritten);
+   }
+
+   printf("  (pixels unlike the tile rendering, in all and where the watchface mask shows the\n"
+          "   dial, at most %d; grey shade bytes written, against %d for the tile blits)\n",
+          MAX_EDGE_PIXELS, 3 * HOST_SCREEN_H * HOST_SCREEN_W / 8);
+
+   for (int i = 0;  i < TWI_PATH_COUNT;  i++)
+   {
+      twilight_path_destroy(apDithered[i]);
+      twilight_path_destroy(apPlain[i]);
+   }
+
+   return host_failures != 0;
+
+}
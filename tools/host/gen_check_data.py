@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+#
+#  Write the reference data the host checks compare against, from the
+#  pngs in resources/images, as a C header (run_checks.sh writes it to its
+#  build directory; nothing generated here is checked in):
+#
+#   - watchface.png as a per-pixel RLE_RUN_* kind, for rle_mask_check.c;
+#   - hour.png as the white and black 1-bit masks a "png-trans" resource
+#     gives aplite (rows padded to 4 bytes), for hour_hand_check.c.
+#
+#  Pixels are classified as tools/gen_rle_mask.py classifies them.
+#
+#  Usage:
+#
+#     tools/host/gen_check_data.py -o check_data.h
+#
+
+import argparse
+import os
+import sys
+
+TOOLS_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+IMAGES_DIR = os.path.join(TOOLS_DIR, '..', 'resources', 'images')
+
+sys.path.insert(0, TOOLS_DIR)
+import gen_rle_mask  # noqa: E402
+
+
+def emit_array(w, decl, values, per_line=24):
+    w('%s __attribute__((unused)) = {\n' % decl)
+    for i in range(0, len(values), per_line):
+        w('   %s,\n' % ', '.join(str(v) for v in values[i:i + per_line]))
+    w('};\n\n')
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('-o', '--output', required=True, help='header to write')
+    args = ap.parse_args()
+
+    with open(args.output, 'w') as out:
+        w = out.write
+        w('//  GENERATED by tools/host/gen_check_data.py for the host checks.\n\n')
+        w('#pragma once\n\n')
+
+        width, height, rows = gen_rle_mask.read_png(os.path.join(IMAGES_DIR, 'watchface.png'))
+        kinds = [gen_rle_mask.classify(p) for row in rows for p in row]
+        w('#define  WATCHFACE_PNG_W  %d\n' % width)
+        w('#define  WATCHFACE_PNG_H  %d\n\n' % height)
+        emit_array(w, 'static const uint8_t  aWatchfaceKinds[WATCHFACE_PNG_H * WATCHFACE_PNG_W]', kinds)
+
+        width, height, rows = gen_rle_mask.read_png(os.path.join(IMAGES_DIR, 'hour.png'))
+        row_bytes = (width + 31) // 32 * 4
+        masks = {gen_rle_mask.RLE_RUN_WHITE: [], gen_rle_mask.RLE_RUN_BLACK: []}
+        for row in rows:
+            for kind, mask in masks.items():
+                line = [0] * row_bytes
+                for x, pixel in enumerate(row):
+                    if gen_rle_mask.classify(pixel) == kind:
+                        line[x // 8] |= 1 << (x % 8)
+                mask.extend(line)
+        w('#define  HOUR_PNG_W          %d\n' % width)
+        w('#define  HOUR_PNG_H          %d\n' % height)
+        w('#define  HOUR_PNG_ROW_BYTES  %d\n\n' % row_bytes)
+        emit_array(w, 'static uint8_t  aHourWhiteMask[HOUR_PNG_H * HOUR_PNG_ROW_BYTES]',
+                   masks[gen_rle_mask.RLE_RUN_WHITE])
+        emit_array(w, 'static uint8_t  aHourBlackMask[HOUR_PNG_H * HOUR_PNG_ROW_BYTES]',
+                   masks[gen_rle_mask.RLE_RUN_BLACK])
+
+
+if __name__ == '__main__':
+    main()
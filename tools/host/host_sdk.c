@@ -0,0 +1,746 @@
+/*
+ *  Host-side stand-ins for SDK calls: see host_sdk.h.
+ *
+ *  Drawing is plain pixel plotting into host_frame_buffer, good enough to
+ *  count and compare pixels, not a copy of the firmware's rasteriser.
+ */
+
+#include <math.h>
+#include <stdarg.h>
+
+#include "host_sdk.h"
+
+
+static uint8_t  aScreen[HOST_SCREEN_BYTES];
+
+GBitmap  host_frame_buffer = {
+   aScreen, HOST_SCREEN_ROW_BYTES, { { 0, 0 }, { HOST_SCREEN_W, HOST_SCREEN_H } },
+#ifdef PBL_COLOR
+   GBitmapFormat8Bit,
+#else
+   GBitmapFormat1Bit,
+#endif
+};
+
+bool  host_clock_24h = true;
+
+int  host_failures = 0;
+
+
+// ---------------------------------------------------------------------------
+//  Logging and trig.
+
+void  app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...)
+{
+
+   //  quiet unless asked for: the checks print their own results
+   if (getenv("HOST_APP_LOG") == NULL)
+   {
+      return;
+   }
+
+   va_list  args;
+
+   va_start(args, fmt);
+   printf("[%u] %s:%d ", (unsigned) log_level, src_filename, src_line_number);
+   vprintf(fmt, args);
+   printf("\n");
+   va_end(args);
+
+}
+
+
+int32_t  sin_lookup(int32_t angle)
+{
+   return (int32_t) lround(sin(angle * 2 * M_PI / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+}
+
+
+int32_t  cos_lookup(int32_t angle)
+{
+   return (int32_t) lround(cos(angle * 2 * M_PI / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+}
+
+
+int32_t  atan2_lookup(int16_t y, int16_t x)
+{
+
+   int32_t  angle = (int32_t) lround(atan2(y, x) * TRIG_MAX_ANGLE / (2 * M_PI));
+
+   return (angle < 0) ? angle + TRIG_MAX_ANGLE : angle;
+
+}
+
+
+// ---------------------------------------------------------------------------
+//  Frame buffer.
+
+///  Visible columns of a row: all of them, except on chalk's round display.
+static void  row_range(int y, int *pMinX, int *pMaxX)
+{
+
+#ifdef PBL_ROUND
+   double  dy   = y + 0.5 - HOST_SCREEN_H / 2.0;
+   double  half = sqrt((HOST_SCREEN_W / 2.0) * (HOST_SCREEN_W / 2.0) - dy * dy);
+
+   *pMinX = (int) ceil(HOST_SCREEN_W / 2.0 - half - 0.5);
+   *pMaxX = HOST_SCREEN_W - 1 - *pMinX;
+#else
+   (void) y;
+   *pMinX = 0;
+   *pMaxX = HOST_SCREEN_W - 1;
+#endif
+
+}
+
+
+void  host_fb_scramble(unsigned seed)
+{
+
+   srand(seed);
+   for (int i = 0;  i < HOST_SCREEN_BYTES;  i++)
+   {
+      aScreen[i] = (uint8_t) rand();
+   }
+
+}
+
+
+bool  host_fb_on_screen(int x, int y)
+{
+
+   if ((y < 0) || (y >= HOST_SCREEN_H))
+   {
+      return false;
+   }
+
+   int  minX, maxX;
+
+   row_range(y, &minX, &maxX);
+   return (x >= minX) && (x <= maxX);
+
+}
+
+
+GColor  host_fb_get(int x, int y)
+{
+
+#ifdef PBL_COLOR
+   return (GColor) { .argb = aScreen[y * HOST_SCREEN_ROW_BYTES + x] };
+#else
+   return ((aScreen[y * HOST_SCREEN_ROW_BYTES + x / 8] >> (x & 7)) & 1) ? GColorWhite : GColorBlack;
+#endif
+
+}
+
+
+void  host_fb_set(int x, int y, GColor color)
+{
+
+   if (! host_fb_on_screen(x, y) || (color.a == 0))
+   {
+      return;
+   }
+
+#ifdef PBL_COLOR
+   aScreen[y * HOST_SCREEN_ROW_BYTES + x] = color.argb;
+#else
+   uint8_t * pByte = &aScreen[y * HOST_SCREEN_ROW_BYTES + x / 8];
+
+   if (gcolor_equal(color, GColorBlack))
+   {
+      *pByte &= ~(1 << (x & 7));
+   }
+   else
+   {
+      *pByte |= 1 << (x & 7);
+   }
+#endif
+
+}
+
+
+GBitmap *  graphics_capture_frame_buffer(GContext *ctx)
+{
+   (void) ctx;
+   return &host_frame_buffer;
+}
+
+
+bool  graphics_release_frame_buffer(GContext *ctx, GBitmap *pBitmap)
+{
+   (void) ctx;
+   return pBitmap == &host_frame_buffer;
+}
+
+
+uint8_t *  gbitmap_get_data(const GBitmap *pBitmap)
+{
+   return pBitmap->data;
+}
+
+
+uint16_t  gbitmap_get_bytes_per_row(const GBitmap *pBitmap)
+{
+   return pBitmap->row_bytes;
+}
+
+
+GRect  gbitmap_get_bounds(const GBitmap *pBitmap)
+{
+   return pBitmap->bounds;
+}
+
+
+GBitmapFormat  gbitmap_get_format(const GBitmap *pBitmap)
+{
+   return pBitmap->format;
+}
+
+
+GBitmapDataRowInfo  gbitmap_get_data_row_info(const GBitmap *pBitmap, uint16_t y)
+{
+
+   int  minX, maxX;
+
+   row_range(y, &minX, &maxX);
+   return (GBitmapDataRowInfo) { pBitmap->data + y * pBitmap->row_bytes, minX, maxX };
+
+}
+
+
+// ---------------------------------------------------------------------------
+//  Drawing.
+
+static GColor  fillColor, strokeColor;
+
+void  graphics_context_set_fill_color(GContext *ctx, GColor color)
+{
+   (void) ctx;
+   fillColor = color;
+}
+
+
+void  graphics_context_set_stroke_color(GContext *ctx, GColor color)
+{
+   (void) ctx;
+   strokeColor = color;
+}
+
+
+void  graphics_draw_pixel(GContext *ctx, GPoint point)
+{
+   (void) ctx;
+   host_fb_set(point.x, point.y, strokeColor);
+}
+
+
+void  graphics_fill_rect(GContext *ctx, GRect rect, uint16_t radius, int corners)
+{
+
+   (void) ctx;
+   (void) radius;
+   (void) corners;
+
+   for (int y = rect.origin.y;  y < rect.origin.y + rect.size.h;  y++)
+   {
+      for (int x = rect.origin.x;  x < rect.origin.x + rect.size.w;  x++)
+      {
+         host_fb_set(x, y, fillColor);
+      }
+   }
+
+}
+
+
+void  graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1)
+{
+
+   (void) ctx;
+
+   //  Bresenham, both end points included
+   int  dx = abs(p1.x - p0.x), sx = (p0.x < p1.x) ? 1 : -1;
+   int  dy = -abs(p1.y - p0.y), sy = (p0.y < p1.y) ? 1 : -1;
+   int  err = dx + dy;
+   int  x = p0.x, y = p0.y;
+
+   for (;;)
+   {
+      host_fb_set(x, y, strokeColor);
+      if ((x == p1.x) && (y == p1.y))
+      {
+         break;
+      }
+
+      int  e2 = 2 * err;
+
+      if (e2 >= dy)
+      {
+         err += dy;
+         x   += sx;
+      }
+      if (e2 <= dx)
+      {
+         err += dx;
+         y   += sy;
+      }
+   }
+
+}
+
+
+void  graphics_draw_circle(GContext *ctx, GPoint center, uint16_t radius)
+{
+
+   (void) ctx;
+
+   //  midpoint circle
+   int  x = radius, y = 0, err = 1 - x;
+
+   while (x >= y)
+   {
+      const int  aOffsets[8][2] = {
+         {  x,  y }, {  y,  x }, { -y,  x }, { -x,  y },
+         { -x, -y }, { -y, -x }, {  y, -x }, {  x, -y },
+      };
+
+      for (int i = 0;  i < 8;  i++)
+      {
+         host_fb_set(center.x + aOffsets[i][0], center.y + aOffsets[i][1], strokeColor);
+      }
+
+      y++;
+      if (err < 0)
+      {
+         err += 2 * y + 1;
+      }
+      else
+      {
+         x--;
+         err += 2 * (y - x) + 1;
+      }
+   }
+
+}
+
+
+GPoint  grect_center_point(const GRect *pRect)
+{
+   return GPoint(pRect->origin.x + pRect->size.w / 2, pRect->origin.y + pRect->size.h / 2);
+}
+
+
+void  gpath_move_to(GPath *pPath, GPoint offset)
+{
+   pPath->offset = offset;
+}
+
+
+void  gpath_rotate_to(GPath *pPath, int32_t angle)
+{
+   pPath->rotation = angle;
+}
+
+
+///  A path's point i, rotated (clockwise, on screen) about the path's origin.
+static GPoint  path_point(const GPath *pPath, uint32_t i)
+{
+
+   int32_t  s = sin_lookup(pPath->rotation), c = cos_lookup(pPath->rotation);
+   GPoint   pt = pPath->points[i];
+
+   return GPoint((pt.x * c - pt.y * s) / TRIG_MAX_RATIO, (pt.x * s + pt.y * c) / TRIG_MAX_RATIO);
+
+}
+
+
+/*
+ *  Scanline fill, after the firmware's: each row crosses the edges which
+ *  span it (upper end included, lower excluded), at an x worked out in
+ *  integers, and is filled between pairs of crossings, both ends included.
+ *  Not the firmware's exact edge rule, so checks must allow for the odd
+ *  edge pixel.
+ */
+void  gpath_draw_filled(GContext *ctx, GPath *pPath)
+{
+
+   (void) ctx;
+
+   int  yMin = INT16_MAX, yMax = INT16_MIN;
+
+   for (uint32_t i = 0;  i < pPath->num_points;  i++)
+   {
+      GPoint  pt = path_point(pPath, i);
+
+      yMin = (pt.y < yMin) ? pt.y : yMin;
+      yMax = (pt.y > yMax) ? pt.y : yMax;
+   }
+
+   for (int y = yMin;  y <= yMax;  y++)
+   {
+      int  aX[16], cX = 0;
+
+      for (uint32_t i = 0;  (i < pPath->num_points) && (cX < 16);  i++)
+      {
+         GPoint  a = path_point(pPath, i);
+         GPoint  b = path_point(pPath, (i + 1) % pPath->num_points);
+
+         if ((a.y <= y) == (b.y <= y))
+         {
+            continue;
+         }
+         int  x = a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+
+         int  iIns = cX++;
+         while ((iIns > 0) && (aX[iIns - 1] > x))
+         {
+            aX[iIns] = aX[iIns - 1];
+            iIns--;
+         }
+         aX[iIns] = x;
+      }
+
+      for (int i = 0;  i + 1 < cX;  i += 2)
+      {
+         for (int x = aX[i];  x <= aX[i + 1];  x++)
+         {
+            host_fb_set(pPath->offset.x + x, pPath->offset.y + y, fillColor);
+         }
+      }
+   }
+
+}
+
+
+void  gpath_draw_outline(GContext *ctx, GPath *pPath)
+{
+
+   for (uint32_t i = 0;  i < pPath->num_points;  i++)
+   {
+      GPoint  a = path_point(pPath, i);
+      GPoint  b = path_point(pPath, (i + 1) % pPath->num_points);
+
+      graphics_draw_line(ctx, GPoint(pPath->offset.x + a.x, pPath->offset.y + a.y),
+                         GPoint(pPath->offset.x + b.x, pPath->offset.y + b.y));
+   }
+
+}
+
+
+void  graphics_fill_circle(GContext *ctx, GPoint center, uint16_t radius)
+{
+
+   (void) ctx;
+
+   for (int dy = -radius;  dy <= radius;  dy++)
+   {
+      for (int dx = -radius;  dx <= radius;  dx++)
+      {
+         if (dx * dx + dy * dy <= radius * radius)
+         {
+            host_fb_set(center.x + dx, center.y + dy, fillColor);
+         }
+      }
+   }
+
+}
+
+
+/*
+ *  Radial fill, pixel by pixel: a pixel is filled if it lies within the
+ *  rect's circle (centers within the radius count, as in dial_spans.c) but
+ *  no more than inset inside it, at an angle clockwise from 12 o'clock
+ *  between angle_start and angle_end.  Only GOvalScaleModeFitCircle, and
+ *  again not the firmware's exact edge rule.
+ */
+void  graphics_fill_radial(GContext *ctx, GRect rect, GOvalScaleMode scale_mode, uint16_t inset,
+                           int32_t angle_start, int32_t angle_end)
+{
+
+   (void) ctx;
+   (void) scale_mode;
+
+   int  radius = ((rect.size.w < rect.size.h) ? rect.size.w : rect.size.h) / 2;
+   int  cx     = rect.origin.x + rect.size.w / 2;
+   int  cy     = rect.origin.y + rect.size.h / 2;
+   int  rInner = (inset < radius) ? radius - inset : 0;
+
+   for (int y = cy - radius;  y <= cy + radius;  y++)
+   {
+      for (int x = cx - radius;  x <= cx + radius;  x++)
+      {
+         int  dx = x - cx, dy = y - cy;
+         int  d2 = dx * dx + dy * dy;
+
+         if ((d2 > radius * radius) || ((rInner > 0) && (d2 < rInner * rInner)))
+         {
+            continue;
+         }
+
+         double   turns = atan2(dx, -dy) / (2 * M_PI);
+         int32_t  angle = (int32_t) ((turns < 0 ? turns + 1 : turns) * TRIG_MAX_ANGLE);
+
+         if ((angle >= angle_start) && (angle <= angle_end))
+         {
+            host_fb_set(x, y, fillColor);
+         }
+      }
+   }
+
+}
+
+
+// ---------------------------------------------------------------------------
+//  Timers, clock.
+
+#define  HOST_TIMERS_MAX  8
+
+static struct {
+   AppTimerCallback   callback;
+   void             * pData;
+} aTimers[HOST_TIMERS_MAX];
+
+static int  cTimers = 0;
+
+
+AppTimer *  app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *pData)
+{
+
+   (void) timeout_ms;
+
+   if (cTimers == HOST_TIMERS_MAX)
+   {
+      return NULL;
+   }
+
+   aTimers[cTimers].callback = callback;
+   aTimers[cTimers].pData    = pData;
+   cTimers++;
+
+   //  (handle is the slot number plus one)
+   return (AppTimer *) (intptr_t) cTimers;
+
+}
+
+
+void  app_timer_cancel(AppTimer *pTimer)
+{
+
+   int  iSlot = (int) (intptr_t) pTimer - 1;
+
+   if ((iSlot >= 0) && (iSlot < cTimers))
+   {
+      aTimers[iSlot].callback = NULL;
+   }
+
+}
+
+
+bool  host_timer_pending(void)
+{
+
+   for (int iSlot = 0;  iSlot < cTimers;  iSlot++)
+   {
+      if (aTimers[iSlot].callback != NULL)
+      {
+         return true;
+      }
+   }
+   return false;
+
+}
+
+
+int  host_run_timers(void)
+{
+
+   int  cRun = 0;
+
+   while (host_timer_pending())
+   {
+      for (int iSlot = 0;  iSlot < cTimers;  iSlot++)
+      {
+         AppTimerCallback  callback = aTimers[iSlot].callback;
+
+         if (callback != NULL)
+         {
+            aTimers[iSlot].callback = NULL;
+            callback(aTimers[iSlot].pData);
+            cRun++;
+         }
+      }
+
+      //  slots free again once nothing is waiting
+      if (! host_timer_pending())
+      {
+         cTimers = 0;
+      }
+   }
+
+   return cRun;
+
+}
+
+
+uint16_t  time_ms(time_t *pSeconds, uint16_t *pMs)
+{
+
+   //  a few milliseconds on, each time it's asked
+   static unsigned  msNow = 0;
+
+   msNow += 3;
+   if (pSeconds != NULL)
+   {
+      *pSeconds = msNow / 1000;
+   }
+   if (pMs != NULL)
+   {
+      *pMs = msNow % 1000;
+   }
+   return msNow % 1000;
+
+}
+
+
+bool  clock_is_24h_style(void)
+{
+   return host_clock_24h;
+}
+
+
+double  host_time_us(int n, void (*fn)(int i))
+{
+
+   clock_t  start = clock();
+
+   for (int i = 0;  i < n;  i++)
+   {
+      fn(i);
+   }
+   return (double) (clock() - start) * 1e6 / CLOCKS_PER_SEC / n;
+
+}
+
+
+// ---------------------------------------------------------------------------
+//  Persistent storage.
+
+#define  HOST_PERSIST_KEYS  8
+
+static struct {
+   uint32_t  key;
+   size_t    cb;
+   uint8_t   aData[PERSIST_DATA_MAX_LENGTH];
+} aPersisted[HOST_PERSIST_KEYS];
+
+static int  cPersisted = 0;
+
+
+static int  find_key(uint32_t key)
+{
+
+   for (int i = 0;  i < cPersisted;  i++)
+   {
+      if (aPersisted[i].key == key)
+      {
+         return i;
+      }
+   }
+   return -1;
+
+}
+
+
+void  host_persist_clear(void)
+{
+   cPersisted = 0;
+}
+
+
+uint8_t *  host_persist_data(uint32_t key, size_t *pcb)
+{
+
+   int  i = find_key(key);
+
+   if (i < 0)
+   {
+      return NULL;
+   }
+   *pcb = aPersisted[i].cb;
+   return aPersisted[i].aData;
+
+}
+
+
+int  persist_write_data(uint32_t key, const void *pData, size_t cb)
+{
+
+   int  i = find_key(key);
+
+   if (cb > PERSIST_DATA_MAX_LENGTH)
+   {
+      cb = PERSIST_DATA_MAX_LENGTH;
+   }
+   if (i < 0)
+   {
+      if (cPersisted == HOST_PERSIST_KEYS)
+      {
+         return -1;
+      }
+      i = cPersisted++;
+      aPersisted[i].key = key;
+   }
+
+   memcpy(aPersisted[i].aData, pData, cb);
+   aPersisted[i].cb = cb;
+   return (int) cb;
+
+}
+
+
+int  persist_read_data(uint32_t key, void *pBuffer, size_t cbBuffer)
+{
+
+   int  i = find_key(key);
+
+   if (i < 0)
+   {
+      return -1;
+   }
+
+   size_t  cb = (aPersisted[i].cb < cbBuffer) ? aPersisted[i].cb : cbBuffer;
+
+   memcpy(pBuffer, aPersisted[i].aData, cb);
+   return (int) cb;
+
+}
+
+
+bool  persist_exists(uint32_t key)
+{
+   return find_key(key) >= 0;
+}
+
+
+int  persist_get_size(uint32_t key)
+{
+
+   int  i = find_key(key);
+
+   return (i < 0) ? -1 : (int) aPersisted[i].cb;
+
+}
+
+
+int  persist_delete(uint32_t key)
+{
+
+   int  i = find_key(key);
+
+   if (i >= 0)
+   {
+      aPersisted[i] = aPersisted[--cPersisted];
+   }
+   return 0;
+
+}
@@ -0,0 +1,83 @@
+/*
+ *  Host-side stand-ins for the SDK calls the checks exercise: a frame buffer
+ *  shaped like the target platform's, the drawing primitives the face uses
+ *  on top of it, app timers run on demand, and persistent storage in memory.
+ *  See host_sdk.c.
+ */
+
+#pragma once
+
+#include "pebble.h"
+
+
+///  The host's GBitmap: pixels in the frame buffer's layout.
+struct GBitmap {
+   uint8_t        *data;
+   uint16_t        row_bytes;
+   GRect           bounds;
+   GBitmapFormat   format;
+};
+
+#if defined(PBL_ROUND)
+# define  HOST_SCREEN_W          180
+# define  HOST_SCREEN_H          180
+# define  HOST_SCREEN_ROW_BYTES  180
+#elif defined(PBL_COLOR)
+# define  HOST_SCREEN_W          144
+# define  HOST_SCREEN_H          168
+# define  HOST_SCREEN_ROW_BYTES  144
+#else
+# define  HOST_SCREEN_W          144
+# define  HOST_SCREEN_H          168
+# define  HOST_SCREEN_ROW_BYTES  20
+#endif
+
+#define  HOST_SCREEN_BYTES  (HOST_SCREEN_H * HOST_SCREEN_ROW_BYTES)
+
+///  The screen, as graphics_capture_frame_buffer() hands it out.
+extern GBitmap  host_frame_buffer;
+
+///  Fill the frame buffer with pseudo-random bytes.
+void  host_fb_scramble(unsigned seed);
+
+///  Is (x, y) on the display?  (On chalk, within the row's visible range.)
+bool  host_fb_on_screen(int x, int y);
+
+///  Pixel at (x, y): black or white on aplite.
+GColor  host_fb_get(int x, int y);
+
+void  host_fb_set(int x, int y, GColor color);
+
+///  Run the app timers registered so far (and any they register) in turn.
+///  Returns how many ran.
+int  host_run_timers(void);
+
+///  Is an app timer waiting to run?
+bool  host_timer_pending(void);
+
+///  Forget everything persisted.
+void  host_persist_clear(void);
+
+///  Stored bytes for a key, or NULL; *pcb gets their count.
+uint8_t *  host_persist_data(uint32_t key, size_t *pcb);
+
+///  What clock_is_24h_style() answers.
+extern bool  host_clock_24h;
+
+///  Count of failed HOST_CHECK()s.
+extern int  host_failures;
+
+///  Report a failed check (and count it), but carry on.
+#define  HOST_CHECK(cond, ...)                                      \
+   do {                                                             \
+      if (! (cond))                                                 \
+      {                                                             \
+         printf("FAIL %s:%d: ", __FILE__, __LINE__);                \
+         printf(__VA_ARGS__);                                       \
+         printf("\n");                                              \
+         host_failures++;                                           \
+      }                                                             \
+   } while (0)
+
+///  Host microseconds per call of fn(i), averaged over calls for i = 0 .. n-1.
+double  host_time_us(int n, void (*fn)(int i));
@@ -0,0 +1,259 @@
+/*
+ *  Check aplite's pre-rotated hour hand sprites (src/hour_hand_bitmap.c,
+ *  with HOUR_HAND_SPRITE_STEPS set), two ways:
+ *
+ *   - round trip: at every angle step, the blitted sprite must leave the
+ *     frame buffer exactly as the module's own rotation, applied straight
+ *     to the screen, would;
+ *   - against the old per-frame look: for every minute of the day, the
+ *     frame is compared with a rotation of hour.png's masks written here,
+ *     independently of the module (double precision, at the exact angle of
+ *     that minute, nearest pixel, as a RotBitmapLayer samples).  Minutes
+ *     on a step must match to within STEP_TOLERANCE pixels; the rest differ
+ *     by the step's quantisation, which is reported for each step.
+ *
+ *  Prints the sprites' run sizes and host timings for the per-frame
+ *  rotation, the blit and a sprite's rendering.
+ *
+ *  hour_hand_bitmap.c is included, rather than linked, to get at its sprite
+ *  slots and encoder.
+ */
+
+#include <math.h>
+
+#include "host_sdk.h"
+
+#include "check_data.h"
+
+
+static GBitmap  bmpHandWhite = { aHourWhiteMask, HOUR_PNG_ROW_BYTES, { { 0, 0 }, { HOUR_PNG_W, HOUR_PNG_H } },
+                                 GBitmapFormat1Bit };
+static GBitmap  bmpHandBlack = { aHourBlackMask, HOUR_PNG_ROW_BYTES, { { 0, 0 }, { HOUR_PNG_W, HOUR_PNG_H } },
+                                 GBitmapFormat1Bit };
+
+GBitmap *  gbitmap_create_with_resource(uint32_t resource_id)
+{
+   return (resource_id == RESOURCE_ID_IMAGE_HOUR_WHITE) ? &bmpHandWhite
+        : (resource_id == RESOURCE_ID_IMAGE_HOUR_BLACK) ? &bmpHandBlack : NULL;
+}
+
+void  gbitmap_destroy(GBitmap *pBitmap)
+{
+   (void) pBitmap;
+}
+
+
+#include "hour_hand_bitmap.c"
+
+
+///  Radius around the hub the per-frame rotation covers: past the hand's tip.
+#define  ROTATE_RADIUS   60
+
+///  Pixels a frame at a step's own minute may differ from the exact
+///  rotation by: fixed point sin_lookup() rounding, at the odd pixel on a
+///  half-pixel boundary.
+#define  STEP_TOLERANCE  8
+
+///  Minutes in the 24 hour dial's revolution.
+#define  DAY_MINUTES     (24 * 60)
+
+
+/**
+ *  The module's own rotation, at an angle step, straight to the screen:
+ *  what the sprite's runs must reproduce.  White or'ed in, black cleared.
+ */
+static void  rotate_step_direct(int32_t angle)
+{
+
+   int32_t  sinA = sin_lookup(angle);
+   int32_t  cosA = cos_lookup(angle);
+
+   for (int dy = -ROTATE_RADIUS;  dy <= ROTATE_RADIUS;  dy++)
+   {
+      for (int dx = -ROTATE_RADIUS;  dx <= ROTATE_RADIUS;  dx++)
+      {
+         int  x = HAND_PIVOT_X + trig_ratio_round( dx * cosA + dy * sinA);
+         int  y = HAND_PIVOT_Y + trig_ratio_round(-dx * sinA + dy * cosA);
+
+         switch (hand_pixel_kind(x, y))
+         {
+         case RLE_RUN_WHITE:
+            host_fb_set(FACE_CENTER_X + dx, FACE_CENTER_Y + dy, GColorWhite);
+            break;
+         case RLE_RUN_BLACK:
+            host_fb_set(FACE_CENTER_X + dx, FACE_CENTER_Y + dy, GColorBlack);
+            break;
+         }
+      }
+   }
+
+}
+
+
+///  Is bit (x, y) of one of gen_check_data.py's hour.png masks set?
+static bool  mask_bit(const uint8_t *pMask, int x, int y)
+{
+   return (x >= 0) && (y >= 0) && (x < HOUR_PNG_W) && (y < HOUR_PNG_H) &&
+          (pMask[y * HOUR_PNG_ROW_BYTES + x / 8] & (1 << (x % 8)));
+}
+
+
+/**
+ *  Reference: hour.png's masks rotated clockwise by radians about the
+ *  hand's pivot (9, 56), drawn with the pivot on the face's centre.  Each
+ *  screen pixel takes the nearest source pixel, as a RotBitmapLayer does.
+ */
+static void  rotate_exact(double radians)
+{
+
+   double  s = sin(radians), c = cos(radians);
+
+   for (int dy = -ROTATE_RADIUS;  dy <= ROTATE_RADIUS;  dy++)
+   {
+      for (int dx = -ROTATE_RADIUS;  dx <= ROTATE_RADIUS;  dx++)
+      {
+         int  x = 9  + (int) floor( dx * c + dy * s + 0.5);
+         int  y = 56 + (int) floor(-dx * s + dy * c + 0.5);
+
+         if (mask_bit(aHourWhiteMask, x, y))
+         {
+            host_fb_set(FACE_CENTER_X + dx, FACE_CENTER_Y + dy, GColorWhite);
+         }
+         else if (mask_bit(aHourBlackMask, x, y))
+         {
+            host_fb_set(FACE_CENTER_X + dx, FACE_CENTER_Y + dy, GColorBlack);
+         }
+      }
+   }
+
+}
+
+
+///  Hand angle for a minute of the day, as sunclock.c's get24HourAngle() gives it: noon up.
+static int32_t  minute_angle(int minute)
+{
+   return (int32_t) (TRIG_MAX_ANGLE * ((12.0f + minute / 60.0f) / 24.0f));
+}
+
+
+static int  pixels_differing(const uint8_t *pA, const uint8_t *pB)
+{
+
+   int  cPixels = 0;
+
+   for (int i = 0;  i < HOST_SCREEN_BYTES;  i++)
+   {
+      cPixels += __builtin_popcount(pA[i] ^ pB[i]);
+   }
+   return cPixels;
+
+}
+
+
+static int32_t  step_angle(int step)
+{
+   return (int32_t) step * TRIG_MAX_ANGLE / HOUR_HAND_SPRITE_STEPS;
+}
+
+static void  time_rotate(int i) { rotate_step_direct(step_angle(i % HOUR_HAND_SPRITE_STEPS)); }
+static void  time_blit(int i)   { (void) i;  hour_hand_draw(NULL); }
+static void  time_render(int i) { render_sprite(&aSprites[0], i % HOUR_HAND_SPRITE_STEPS); }
+
+
+int  main(void)
+{
+
+   static uint8_t  aExpected[HOST_SCREEN_BYTES];
+   static int      aStepWorst[HOUR_HAND_SPRITE_STEPS];
+
+   hour_hand_init(NULL);
+   HOST_CHECK(pBmpHandWhite != NULL, "no hand bitmaps");
+
+   //  round trip, per step
+
+   size_t  cbTotal = 0, cbMax = 0;
+   int     cStepsWrong = 0;
+
+   for (int step = 0;  step < HOUR_HAND_SPRITE_STEPS;  step++)
+   {
+      host_fb_scramble(step);
+      rotate_step_direct(step_angle(step));
+      memcpy(aExpected, host_frame_buffer.data, HOST_SCREEN_BYTES);
+
+      host_fb_scramble(step);
+      HOST_CHECK(hour_hand_set_angle(step_angle(step)), "step %d: no change reported", step);
+      HOST_CHECK(! hour_hand_set_angle(step_angle(step)), "step %d: change reported twice", step);
+      hour_hand_draw(NULL);
+
+      if (memcmp(aExpected, host_frame_buffer.data, HOST_SCREEN_BYTES) != 0)
+      {
+         cStepsWrong++;
+      }
+
+      HandSprite * pSprite = &aSprites[0];
+      size_t       cbRuns  = encode_rotated_hand(NULL, GRect(pSprite->origin.x - FACE_CENTER_X,
+                                                             pSprite->origin.y - FACE_CENTER_Y,
+                                                             pSprite->mask.width, pSprite->mask.height),
+                                                 sin_lookup(step_angle(step)), cos_lookup(step_angle(step)));
+      cbTotal += cbRuns;
+      cbMax = (cbRuns > cbMax) ? cbRuns : cbMax;
+   }
+
+   HOST_CHECK(cStepsWrong == 0, "%d of %d steps' sprites differ from their direct rotation",
+              cStepsWrong, HOUR_HAND_SPRITE_STEPS);
+   printf("  %d steps, RLE round trip %s; runs %u bytes average, %u max\n",
+          HOUR_HAND_SPRITE_STEPS, (cStepsWrong == 0) ? "identical" : "WRONG",
+          (unsigned) (cbTotal / HOUR_HAND_SPRITE_STEPS), (unsigned) cbMax);
+
+   //  against the exact rotation, every minute
+
+   int  worstOnStep = 0, totalOff = 0;
+
+   for (int minute = 0;  minute < DAY_MINUTES;  minute++)
+   {
+      double  radians = 2 * M_PI * ((minute + DAY_MINUTES / 2) % DAY_MINUTES) / DAY_MINUTES;
+
+      host_fb_scramble(minute);
+      rotate_exact(radians);
+      memcpy(aExpected, host_frame_buffer.data, HOST_SCREEN_BYTES);
+
+      host_fb_scramble(minute);
+      hour_hand_set_angle(minute_angle(minute));
+      hour_hand_draw(NULL);
+
+      int  cPixels = pixels_differing(aExpected, host_frame_buffer.data);
+
+      aStepWorst[sStep] = (cPixels > aStepWorst[sStep]) ? cPixels : aStepWorst[sStep];
+      totalOff += cPixels;
+
+      //  (a minute is on its step when the step's angle is the minute's)
+      if ((minute * HOUR_HAND_SPRITE_STEPS) % DAY_MINUTES == 0)
+      {
+         worstOnStep = (cPixels > worstOnStep) ? cPixels : worstOnStep;
+         HOST_CHECK(cPixels <= STEP_TOLERANCE, "minute %d, on step %d: %d pixels unlike the exact rotation",
+                    minute, sStep, cPixels);
+      }
+   }
+
+   printf("  against exact per-minute rotation: %d pixels at most on a step's own minute;"
+          " %.1f average over the day\n", worstOnStep, (double) totalOff / DAY_MINUTES);
+   printf("  most pixels differing, any minute, by step:\n");
+   for (int step = 0;  step < HOUR_HAND_SPRITE_STEPS;  step += 12)
+   {
+      printf("   %3d:", step);
+      for (int i = step;  (i < step + 12) && (i < HOUR_HAND_SPRITE_STEPS);  i++)
+      {
+         printf(" %3d", aStepWorst[i]);
+      }
+      printf("\n");
+   }
+
+   printf("  host us: per-frame rotation %.1f, sprite blit %.2f, sprite render (once a step) %.1f\n",
+          host_time_us(2000, time_rotate), host_time_us(20000, time_blit),
+          host_time_us(2000, time_render));
+
+   hour_hand_deinit();
+
+   return host_failures != 0;
+
+}
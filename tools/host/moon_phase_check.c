@@ -0,0 +1,102 @@
+/*
+ *  Check src/moon_phase.c over a year of days: each day's lit pixels, as a
+ *  fraction of the disc, must be close to the exact illuminated fraction
+ *  (1 - cos(phase angle)) / 2; the southern hemisphere's moon must be the
+ *  northern one mirrored; and drawing must stay within the disc.  Prints
+ *  the largest error, and the shape's size in each DayPlan.
+ */
+
+#include <math.h>
+
+#include "host_sdk.h"
+
+#include "moon_phase.h"
+
+
+///  Mean lunation and a new moon's julian day, as in moon_phase.c.
+#define  SYNODIC_MONTH   29.530588853
+#define  NEW_MOON_EPOCH  2451550.26
+
+///  Largest lit fraction error allowed, for the terminator's rounding to whole pixels.
+#define  MAX_LIT_ERROR   0.03
+
+///  Days checked, from 2026-10-19.
+#define  FIRST_DAY       2461333
+#define  DAYS            365
+
+
+static int  row_limb(int iRow)
+{
+   int  dy = iRow - MOON_RADIUS;
+   return (int) floor(sqrt((MOON_RADIUS + 0.5) * (MOON_RADIUS + 0.5) - dy * dy));
+}
+
+
+int  main(void)
+{
+
+   double  maxError = 0;
+
+   for (int jd = FIRST_DAY;  jd < FIRST_DAY + DAYS;  jd++)
+   {
+      MoonShape  north, south;
+
+      moon_phase_compute(jd, false, &north);
+      moon_phase_compute(jd, true,  &south);
+
+      double  age = (jd - NEW_MOON_EPOCH) / SYNODIC_MONTH;
+      age -= floor(age);
+
+      int  cLit = 0, cDisc = 0;
+
+      for (int iRow = 0;  iRow < MOON_ROWS;  iRow++)
+      {
+         const MoonSpan * pSpan = &north.aSpans[iRow];
+         int              limb  = row_limb(iRow);
+
+         cDisc += 2 * limb + 1;
+         if (pSpan->left <= pSpan->right)
+         {
+            cLit += pSpan->right - pSpan->left + 1;
+            HOST_CHECK((pSpan->left >= -limb) && (pSpan->right <= limb),
+                       "day %d row %d: span %d..%d outside the disc", jd, iRow, pSpan->left, pSpan->right);
+         }
+
+         const MoonSpan * pMirror = &south.aSpans[iRow];
+         HOST_CHECK((pSpan->left > pSpan->right) ? (pMirror->left > pMirror->right)
+                        : ((pMirror->left == -pSpan->right) && (pMirror->right == -pSpan->left)),
+                    "day %d row %d: southern moon not the mirror image", jd, iRow);
+      }
+
+      double  exact = (1 - cos(2 * M_PI * age)) / 2;
+      double  error = fabs((double) cLit / cDisc - exact);
+
+      maxError = (error > maxError) ? error : maxError;
+      HOST_CHECK(error <= MAX_LIT_ERROR, "day %d (age %.3f): lit %.3f, exact %.3f",
+                 jd, age, (double) cLit / cDisc, exact);
+
+      //  drawn pixels, white on black, all within the outline
+      memset(host_frame_buffer.data, 0, HOST_SCREEN_BYTES);
+      moon_phase_draw(NULL, &north, GColorWhite);
+
+      for (int y = 0;  y < HOST_SCREEN_H;  y++)
+      {
+         for (int x = 0;  x < HOST_SCREEN_W;  x++)
+         {
+            int  dx = x - MOON_CENTER_X, dy = y - MOON_CENTER_Y;
+
+            if (gcolor_equal(host_fb_get(x, y), GColorWhite))
+            {
+               HOST_CHECK(dx * dx + dy * dy <= (MOON_RADIUS + 1) * (MOON_RADIUS + 1),
+                          "day %d: pixel (%d, %d) drawn outside the disc", jd, x, y);
+            }
+         }
+      }
+   }
+
+   printf("  %d days: lit fraction within %.3f of exact; shape %u bytes\n",
+          DAYS, maxError, (unsigned) sizeof(MoonShape));
+
+   return host_failures != 0;
+
+}
@@ -0,0 +1,167 @@
+/*
+ *  Host stand-in for the Pebble SDK's pebble.h, just enough of it for the
+ *  checks in this directory to compile src/ modules with the host's gcc.
+ *  Types match the SDK's; functions are declared here and defined, where a
+ *  check needs them, in host_sdk.c or the check itself.  Not for the watch.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+typedef struct GPoint { int16_t x, y; } GPoint;
+typedef struct GSize { int16_t w, h; } GSize;
+typedef struct GRect { GPoint origin; GSize size; } GRect;
+#define GPoint(x,y) ((GPoint){(x),(y)})
+#define GSize(w,h) ((GSize){(w),(h)})
+#define GRect(x,y,w,h) ((GRect){{(x),(y)},{(w),(h)}})
+#define GRectZero GRect(0,0,0,0)
+#define GPointZero GPoint(0,0)
+typedef union GColor8 { uint8_t argb; struct { uint8_t b:2, g:2, r:2, a:2; }; } GColor8;
+typedef GColor8 GColor;
+#define GColorBlack ((GColor8){.argb=0xC0})
+#define GColorWhite ((GColor8){.argb=0xFF})
+#define GColorClear ((GColor8){.argb=0x00})
+#define GColorDarkGray ((GColor8){.argb=0xD5})
+#define GColorLightGray ((GColor8){.argb=0xEA})
+#define GColorOxfordBlue ((GColor8){.argb=0xC1})
+#define GColorVividViolet ((GColor8){.argb=0xE7})
+#define GColorFolly ((GColor8){.argb=0xF1})
+#define GColorChromeYellow ((GColor8){.argb=0xF8})
+#define GColorPastelYellow ((GColor8){.argb=0xFE})
+#define GColorRed ((GColor8){.argb=0xF0})
+#define GColorOrange ((GColor8){.argb=0xF4})
+#define GColorFromRGB(r,g,b) ((GColor8){.argb=0xC0})
+#define GColorFromRGBA(r,g,b,a) ((GColor8){.argb=0xC0})
+static inline bool gcolor_equal(GColor a, GColor b){return a.argb==b.argb;}
+typedef struct GContext GContext;
+typedef struct Layer Layer;
+typedef struct Window Window;
+typedef struct TextLayer TextLayer;
+typedef struct GBitmap GBitmap;
+typedef struct RotBitmapLayer RotBitmapLayer;
+typedef struct GFont_ *GFont;
+typedef struct GPathInfo { uint32_t num_points; GPoint *points; } GPathInfo;
+typedef struct GPath { uint32_t num_points; GPoint *points; int32_t rotation; GPoint offset; } GPath;
+typedef enum { GCompOpAssign, GCompOpAssignInverted, GCompOpOr, GCompOpAnd, GCompOpClear, GCompOpSet } GCompOp;
+typedef enum { GTextAlignmentLeft, GTextAlignmentCenter, GTextAlignmentRight } GTextAlignment;
+typedef enum { GTextOverflowModeWordWrap, GTextOverflowModeTrailingEllipsis, GTextOverflowModeFill } GTextOverflowMode;
+typedef enum { GOvalScaleModeFitCircle, GOvalScaleModeFillCircle } GOvalScaleMode;
+typedef enum { GBitmapFormat1Bit = 0, GBitmapFormat8Bit, GBitmapFormat1BitPalette, GBitmapFormat2BitPalette, GBitmapFormat4BitPalette, GBitmapFormat8BitCircular } GBitmapFormat;
+typedef struct { uint8_t *data; int16_t min_x; int16_t max_x; } GBitmapDataRowInfo;
+typedef struct GTextAttributes GTextAttributes;
+typedef enum { SECOND_UNIT = 1, MINUTE_UNIT = 2, HOUR_UNIT = 4, DAY_UNIT = 8, MONTH_UNIT = 16, YEAR_UNIT = 32 } TimeUnits;
+typedef struct { uint8_t charge_percent; bool is_charging; bool is_plugged; } BatteryChargeState;
+typedef struct { uint32_t *durations; uint32_t num_segments; } VibePattern;
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)(void *data);
+typedef void (*LayerUpdateProc)(Layer *layer, GContext *ctx);
+typedef struct { void (*load)(Window*); void (*appear)(Window*); void (*disappear)(Window*); void (*unload)(Window*); } WindowHandlers;
+typedef void (*TickHandler)(struct tm *tick_time, TimeUnits units_changed);
+typedef void (*BatteryStateHandler)(BatteryChargeState charge);
+typedef enum { APP_LOG_LEVEL_ERROR = 1, APP_LOG_LEVEL_WARNING = 50, APP_LOG_LEVEL_INFO = 100, APP_LOG_LEVEL_DEBUG = 200 } AppLogLevel;
+void app_log(uint8_t log_level, const char* src_filename, int src_line_number, const char* fmt, ...);
+#define APP_LOG(level, fmt, args...) app_log(level, __FILE__, __LINE__, fmt, ## args)
+#define TRIG_MAX_RATIO 0xffff
+#define TRIG_MAX_ANGLE 0x10000
+#define DEG_TO_TRIGANGLE(a) (((a) * TRIG_MAX_ANGLE) / 360)
+int32_t sin_lookup(int32_t angle); int32_t cos_lookup(int32_t angle); int32_t atan2_lookup(int16_t y, int16_t x);
+#define RESOURCE_ID_IMAGE_WATCHFACE 1
+#define RESOURCE_ID_IMAGE_WATCHFACE_WHITE 2
+#define RESOURCE_ID_IMAGE_WATCHFACE_BLACK 3
+#define RESOURCE_ID_IMAGE_HOUR 4
+#define RESOURCE_ID_IMAGE_HOUR_WHITE 5
+#define RESOURCE_ID_IMAGE_HOUR_BLACK 6
+#define RESOURCE_ID_IMAGE_LIGHT_GREY 7
+#define RESOURCE_ID_IMAGE_GREY 8
+#define RESOURCE_ID_IMAGE_DARK_GREY 9
+#define RESOURCE_ID_FONT_ROBOTO_CONDENSED_42 11
+#define RESOURCE_ID_FONT_ROBOTO_CONDENSED_19 12
+#define FONT_KEY_GOTHIC_14_BOLD "a"
+#define FONT_KEY_GOTHIC_18 "b"
+#define FONT_KEY_GOTHIC_18_BOLD "b2"
+#define FONT_KEY_GOTHIC_24_BOLD "b3"
+#define FONT_KEY_GOTHIC_28_BOLD "b4"
+#define FONT_KEY_BITHAM_42_MEDIUM_NUMBERS "c1"
+#define FONT_KEY_LECO_42_NUMBERS "c2"
+#define FONT_KEY_DROID_SERIF_28_BOLD "c"
+typedef void* ResHandle;
+ResHandle resource_get_handle(uint32_t id);
+size_t resource_size(ResHandle h); size_t resource_load(ResHandle h, uint8_t *buffer, size_t max_length);
+GFont fonts_load_custom_font(ResHandle); void fonts_unload_custom_font(GFont); GFont fonts_get_system_font(const char*);
+Window *window_create(void); void window_destroy(Window*); Layer *window_get_root_layer(const Window*);
+void window_set_background_color(Window*, GColor); void window_set_window_handlers(Window*, WindowHandlers); void window_stack_push(Window*, bool); void window_stack_remove(Window*, bool);
+Layer *layer_create(GRect); Layer *layer_create_with_data(GRect, size_t); void *layer_get_data(const Layer*); void layer_destroy(Layer*);
+void layer_set_update_proc(Layer*, LayerUpdateProc); void layer_mark_dirty(Layer*); void layer_add_child(Layer*, Layer*); void layer_remove_from_parent(Layer*);
+GRect layer_get_frame(const Layer*); GRect layer_get_bounds(const Layer*); void layer_set_frame(Layer*, GRect); void layer_set_hidden(Layer*, bool);
+TextLayer *text_layer_create(GRect); void text_layer_destroy(TextLayer*); Layer *text_layer_get_layer(TextLayer*);
+void text_layer_set_text(TextLayer*, const char*); void text_layer_set_font(TextLayer*, GFont); void text_layer_set_text_color(TextLayer*, GColor);
+void text_layer_set_background_color(TextLayer*, GColor); void text_layer_set_text_alignment(TextLayer*, GTextAlignment); void text_layer_enable_screen_text_flow_and_paging(TextLayer*, uint8_t);
+GPath *gpath_create(const GPathInfo*); void gpath_destroy(GPath*); void gpath_move_to(GPath*, GPoint); void gpath_rotate_to(GPath*, int32_t);
+void gpath_draw_filled(GContext*, GPath*); void gpath_draw_outline(GContext*, GPath*);
+void graphics_context_set_fill_color(GContext*, GColor); void graphics_context_set_stroke_color(GContext*, GColor); void graphics_context_set_text_color(GContext*, GColor);
+void graphics_context_set_compositing_mode(GContext*, GCompOp); void graphics_context_set_antialiased(GContext*, bool); void graphics_context_set_stroke_width(GContext*, uint8_t);
+void graphics_fill_rect(GContext*, GRect, uint16_t, int); void graphics_fill_circle(GContext*, GPoint, uint16_t); void graphics_draw_circle(GContext*, GPoint, uint16_t);
+void graphics_draw_line(GContext*, GPoint, GPoint); void graphics_draw_pixel(GContext*, GPoint); void graphics_draw_rect(GContext*, GRect);
+void graphics_fill_radial(GContext*, GRect, GOvalScaleMode, uint16_t, int32_t, int32_t);
+void graphics_draw_text(GContext*, const char*, GFont, GRect, GTextOverflowMode, GTextAlignment, GTextAttributes*);
+GSize graphics_text_layout_get_content_size(const char*, GFont, GRect, GTextOverflowMode, GTextAlignment);
+void graphics_draw_bitmap_in_rect(GContext*, const GBitmap*, GRect);
+GBitmap *graphics_capture_frame_buffer(GContext*); bool graphics_release_frame_buffer(GContext*, GBitmap*);
+GBitmap *gbitmap_create_with_resource(uint32_t); GBitmap *gbitmap_create_blank(GSize, GBitmapFormat); void gbitmap_destroy(GBitmap*);
+uint8_t *gbitmap_get_data(const GBitmap*); uint16_t gbitmap_get_bytes_per_row(const GBitmap*); GRect gbitmap_get_bounds(const GBitmap*);
+GBitmapFormat gbitmap_get_format(const GBitmap*); GBitmapDataRowInfo gbitmap_get_data_row_info(const GBitmap*, uint16_t);
+RotBitmapLayer *rot_bitmap_layer_create(GBitmap*); void rot_bitmap_layer_destroy(RotBitmapLayer*); void rot_bitmap_set_compositing_mode(RotBitmapLayer*, GCompOp);
+void rot_bitmap_set_src_ic(RotBitmapLayer*, GPoint); void rot_bitmap_layer_set_angle(RotBitmapLayer*, int32_t);
+GPoint grect_center_point(const GRect*);
+void tick_timer_service_subscribe(TimeUnits, TickHandler); void tick_timer_service_unsubscribe(void);
+BatteryChargeState battery_state_service_peek(void); void battery_state_service_subscribe(BatteryStateHandler); void battery_state_service_unsubscribe(void);
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback cb, void *data); void app_timer_cancel(AppTimer*); bool app_timer_reschedule(AppTimer*, uint32_t);
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms);
+bool clock_is_24h_style(void); void clock_copy_time_string(char*, uint8_t); bool clock_is_timezone_set(void); void clock_get_timezone(char *timezone, const size_t buffer_size);
+#define TIMEZONE_NAME_LENGTH 32
+size_t heap_bytes_free(void); size_t heap_bytes_used(void);
+int persist_read_data(uint32_t key, void *buffer, size_t buffer_size); int persist_write_data(uint32_t key, const void *data, size_t size);
+int persist_delete(uint32_t key); bool persist_exists(uint32_t key); int persist_get_size(uint32_t key);
+#define PERSIST_DATA_MAX_LENGTH 256
+void vibes_enqueue_custom_pattern(VibePattern);
+void app_event_loop(void);
+typedef struct DictionaryIterator DictionaryIterator;
+typedef struct Tuple { uint32_t key; uint8_t type; uint16_t length; union { int32_t int32; uint32_t uint32; char cstring[0]; } value[]; } Tuple;
+typedef struct { uint32_t key; int type; union { struct { int32_t storage; uint16_t width; } integer; } ; } Tuplet;
+#define TupletInteger(k,i) ((Tuplet){.key=(k)})
+typedef int AppMessageResult; typedef int DictionaryResult;
+#define APP_MSG_OK 0
+#define DICT_OK 0
+AppMessageResult app_message_outbox_begin(DictionaryIterator**); DictionaryResult dict_write_tuplet(DictionaryIterator*, const Tuplet*); uint32_t dict_write_end(DictionaryIterator*);
+AppMessageResult app_message_outbox_send(void); Tuple *dict_find(const DictionaryIterator*, uint32_t);
+typedef void (*AppMessageInboxReceived)(DictionaryIterator*, void*); typedef void (*AppMessageInboxDropped)(AppMessageResult, void*);
+typedef void (*AppMessageOutboxSent)(DictionaryIterator*, void*); typedef void (*AppMessageOutboxFailed)(DictionaryIterator*, AppMessageResult, void*);
+void app_message_register_inbox_received(AppMessageInboxReceived); void app_message_register_inbox_dropped(AppMessageInboxDropped);
+void app_message_register_outbox_sent(AppMessageOutboxSent); void app_message_register_outbox_failed(AppMessageOutboxFailed);
+AppMessageResult app_message_open(uint32_t, uint32_t); uint32_t app_message_inbox_size_maximum(void); uint32_t app_message_outbox_size_maximum(void);
+void app_message_deregister_callbacks(void);
+#define APP_MSG_SEND_TIMEOUT 2
+#define APP_MSG_BUSY 3
+#define APP_MESSAGE_INBOX_SIZE_MINIMUM 124
+#define APP_MESSAGE_OUTBOX_SIZE_MINIMUM 636
+void layer_remove_child_layers(Layer*); Window *window_stack_get_top_window(void); Window *window_stack_pop(bool);
+#define APP_MSG_SEND_REJECTED 4
+#define APP_MSG_NOT_CONNECTED 5
+#define APP_MSG_APP_NOT_RUNNING 6
+#define APP_MSG_INVALID_ARGS 7
+#define APP_MSG_BUFFER_OVERFLOW 8
+#define APP_MSG_ALREADY_RELEASED 9
+#define APP_MSG_CALLBACK_ALREADY_REGISTERED 10
+#define APP_MSG_CALLBACK_NOT_REGISTERED 11
+#define APP_MSG_OUT_OF_MEMORY 12
+#define APP_MSG_CLOSED 13
+#define APP_MSG_INTERNAL_ERROR 14
+#define ARRAY_LENGTH(a) (sizeof(a)/sizeof((a)[0]))
+#define SECONDS_PER_DAY 86400
+#define GCornerNone 0
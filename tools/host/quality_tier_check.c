@@ -0,0 +1,50 @@
+/*
+ *  Check src/quality_tier.c's ladder for the platform it's built for: print
+ *  the least free heap at which each tier is chosen, and fail if a tier can
+ *  never be chosen (other than anti-aliasing on aplite, which has none to
+ *  drop) or if more heap ever picks a worse tier.
+ *
+ *  The heap figures are quality_tier.c's estimates, not measurements; on
+ *  the emulator, TESTING_HEAP_BUDGET (testing.h) tries each tier for real.
+ */
+
+#include "host_sdk.h"
+
+#include "quality_tier.h"
+
+
+int  main(void)
+{
+
+   for (int iTier = 0;  iTier < QUALITY_TIER_COUNT;  iTier++)
+   {
+      size_t       cbMin  = quality_tier_get_min_heap((QualityTier) iTier);
+      QualityTier  chosen = quality_tier_choose(cbMin);
+      bool         fReachable = (chosen == (QualityTier) iTier);
+
+      printf("  %-17s >= %5u bytes%s\n", quality_tier_get_name((QualityTier) iTier),
+             (unsigned) cbMin, fReachable ? "" : "  (never chosen)");
+
+#ifdef PBL_PLATFORM_APLITE
+      if (iTier == QUALITY_TIER_NO_ANTIALIAS)
+      {
+         continue;
+      }
+#endif
+      HOST_CHECK(fReachable, "tier %s is never chosen", quality_tier_get_name((QualityTier) iTier));
+   }
+
+   QualityTier  previous = QUALITY_TIER_FLOOR;
+
+   for (size_t cbFree = 0;  cbFree <= 32768;  cbFree += 16)
+   {
+      QualityTier  tier = quality_tier_choose(cbFree);
+
+      HOST_CHECK(tier <= previous, "%u bytes picks %s, worse than with less heap",
+                 (unsigned) cbFree, quality_tier_get_name(tier));
+      previous = tier;
+   }
+
+   return host_failures != 0;
+
+}
@@ -0,0 +1,81 @@
+/*
+ *  Check src/rle_mask.c and the checked-in src/watchface_rle.h against
+ *  resources/images/watchface.png: drawing the mask over a scrambled frame
+ *  buffer must set the png's white pixels, clear its black ones and leave
+ *  the rest, also when the mask is clipped by the screen edges.  Prints
+ *  the frame buffer bytes written per draw.
+ */
+
+#include "host_sdk.h"
+
+#include "rle_mask.h"
+#include "watchface_rle.h"
+
+#include "check_data.h"
+
+
+///  Draw the watchface mask at an origin; count pixels unlike the png's.
+static int  check_at(GPoint origin, size_t *pcbWritten)
+{
+
+   static uint8_t  aBefore[HOST_SCREEN_BYTES];
+
+   host_fb_scramble(origin.x * 31 + origin.y);
+   memcpy(aBefore, host_frame_buffer.data, HOST_SCREEN_BYTES);
+
+   *pcbWritten = rle_mask_draw(&watchfaceRleMask, NULL, origin);
+
+   int  cBad = 0;
+
+   for (int y = 0;  y < HOST_SCREEN_H;  y++)
+   {
+      for (int x = 0;  x < HOST_SCREEN_W;  x++)
+      {
+         int  mx = x - origin.x, my = y - origin.y;
+         int  kind = RLE_RUN_SKIP;
+
+         if ((mx >= 0) && (my >= 0) && (mx < WATCHFACE_PNG_W) && (my < WATCHFACE_PNG_H))
+         {
+            kind = aWatchfaceKinds[my * WATCHFACE_PNG_W + mx];
+         }
+
+         bool  fBefore = (aBefore[y * HOST_SCREEN_ROW_BYTES + x / 8] >> (x & 7)) & 1;
+         bool  fWant   = (kind == RLE_RUN_WHITE) || ((kind == RLE_RUN_SKIP) && fBefore);
+
+         if (fWant != gcolor_equal(host_fb_get(x, y), GColorWhite))
+         {
+            cBad++;
+         }
+      }
+   }
+
+   return cBad;
+
+}
+
+
+int  main(void)
+{
+
+   HOST_CHECK((watchfaceRleMask.width == WATCHFACE_PNG_W) && (watchfaceRleMask.height == WATCHFACE_PNG_H),
+              "mask is %d x %d, png %d x %d: re-run tools/gen_rle_mask.py",
+              watchfaceRleMask.width, watchfaceRleMask.height, WATCHFACE_PNG_W, WATCHFACE_PNG_H);
+
+   const GPoint  aOrigins[] = { { 0, 0 }, { -5, -7 }, { 9, 13 }, { -150, 0 } };
+
+   for (unsigned i = 0;  i < ARRAY_LENGTH(aOrigins);  i++)
+   {
+      size_t  cbWritten;
+      int     cBad = check_at(aOrigins[i], &cbWritten);
+
+      HOST_CHECK(cBad == 0, "at (%d, %d): %d pixels differ from the png",
+                 aOrigins[i].x, aOrigins[i].y, cBad);
+      printf("  at (%4d, %3d): %4u frame buffer bytes written, %d pixels wrong\n",
+             aOrigins[i].x, aOrigins[i].y, (unsigned) cbWritten, cBad);
+   }
+
+   printf("  (a png-trans overlay composites 2 x %d bytes)\n", HOST_SCREEN_BYTES);
+
+   return host_failures != 0;
+
+}
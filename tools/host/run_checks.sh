@@ -0,0 +1,94 @@
+#!/bin/sh
+#
+#  Build and run the host checks in this directory: each compiles some of
+#  src/ with the host's gcc, against the stand-in pebble.h and host_sdk.c,
+#  once per platform it applies to, and exits non-zero if anything in it
+#  fails.  Figures they print (sizes, host timings) are host figures, not
+#  the watch's.
+#
+#  Usage:
+#
+#     tools/host/run_checks.sh [check ...]
+#
+#  with checks named as in CHECKS below (default: all of them).  Set
+#  HOST_APP_LOG=1 to see the modules' APP_LOG output, and HOST_CFLAGS for
+#  extra compiler flags (e.g. -mavx2, for suncalc's 8-wide forms).
+#
+
+set -u
+
+HOST_DIR=$(cd "$(dirname "$0")" && pwd)
+SRC_DIR=$(cd "$HOST_DIR/../../src" && pwd)
+BUILD_DIR=$(mktemp -d "${TMPDIR:-/tmp}/sunclock-host.XXXXXX")
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+APLITE="-DPBL_PLATFORM_APLITE -DPBL_BW -DPBL_RECT"
+BASALT="-DPBL_PLATFORM_BASALT -DPBL_COLOR -DPBL_RECT"
+CHALK="-DPBL_PLATFORM_CHALK -DPBL_COLOR -DPBL_ROUND"
+
+#  check name : platforms : src/ modules it links
+CHECKS="
+day_plan     : aplite basalt chalk : DayPlan.c TwilightPath.c arena.c dither_fill.c suncalc.c moon_phase.c my_math.c
+quality_tier : aplite basalt chalk : quality_tier.c
+rle_mask     : aplite              : rle_mask.c
+hour_hand    : aplite              : rle_mask.c
+digit_atlas  : aplite basalt chalk : digit_atlas.c
+moon_phase   : aplite basalt chalk : moon_phase.c my_math.c
+dither_fill  : aplite              : dither_fill.c arena.c rle_mask.c suncalc.c my_math.c
+suncalc      : aplite              : suncalc.c my_math.c
+angle_map    : aplite basalt chalk : TwilightPath.c dither_fill.c dial_spans.c rle_mask.c arena.c suncalc.c my_math.c
+dial_cache   : aplite basalt chalk : DayPlan.c TwilightPath.c dial_mask_path.c dial_spans.c rle_mask.c arena.c dither_fill.c suncalc.c moon_phase.c my_math.c
+"
+
+failed=0
+
+if ! "$HOST_DIR/gen_check_data.py" -o "$BUILD_DIR/check_data.h"; then
+   echo "FAIL: can't generate check data"
+   exit 1
+fi
+
+run_check()
+{
+   name=$1; platforms=$2; modules=$3
+
+   for platform in $platforms; do
+      case $platform in
+         aplite) flags=$APLITE ;;
+         basalt) flags=$BASALT ;;
+         chalk)  flags=$CHALK ;;
+      esac
+
+      sources=""
+      for module in $modules; do
+         sources="$sources $SRC_DIR/$module"
+      done
+
+      exe="$BUILD_DIR/${name}_$platform"
+      echo "== $name ($platform)"
+      if ! gcc -std=gnu99 -D_DEFAULT_SOURCE -O2 -Wall -Wno-unused-function \
+               -I"$HOST_DIR" -I"$SRC_DIR" -I"$BUILD_DIR" $flags ${HOST_CFLAGS:-} \
+               -o "$exe" "$HOST_DIR/${name}_check.c" "$HOST_DIR/host_sdk.c" $sources -lm; then
+         echo "FAIL $name ($platform): does not build"
+         failed=1
+      elif ! (cd "$HOST_DIR/../.." && "$exe"); then
+         echo "FAIL $name ($platform)"
+         failed=1
+      fi
+   done
+}
+
+while IFS=: read -r name platforms modules; do
+   name=$(echo $name)
+   [ -n "$name" ] || continue
+   if [ $# -gt 0 ]; then
+      case " $* " in
+         *" $name "*) ;;
+         *) continue ;;
+      esac
+   fi
+   run_check "$name" "$platforms" "$modules"
+done <<EOF
+$CHECKS
+EOF
+
+exit $failed
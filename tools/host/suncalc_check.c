@@ -0,0 +1,181 @@
+/*
+ *  Check and time the batched solar math in src/my_math.c and
+ *  src/suncalc.c: my_sin_n() / my_cos_n() must give exactly my_sin() /
+ *  my_cos()'s results, and calcSun_n() calcSun()'s, for every day of a
+ *  year over a global grid of locations, at each of the face's zeniths.
+ *  Prints the vector width the host build got and host throughput, batched
+ *  against one call per value, for the trig kernels, a full year at one
+ *  location, and the whole grid.
+ *
+ *  Build with HOST_CFLAGS=-mavx2 (see run_checks.sh) for the 8-wide forms.
+ */
+
+#include "host_sdk.h"
+
+#include "my_math.h"
+#include "suncalc.h"
+
+
+///  Trig arguments per timed batch, over [-TRIG_RANGE, TRIG_RANGE] radians.
+#define  TRIG_SAMPLES   4096
+#define  TRIG_RANGE     1000.0f
+
+///  Days per year run, from January 1st.
+#define  YEAR           2026
+#define  DAYS           365
+
+///  Grid: every GRID_STEP degrees of latitude, within the polar circles, and of longitude.
+#define  GRID_LAT_MAX   65
+#define  GRID_STEP      15
+
+static const float  aZeniths[] = { 90.833f, 96.0f, 102.0f, 108.0f };
+
+static float  aTrigIn[TRIG_SAMPLES];
+static float  aTrigOut[TRIG_SAMPLES];
+
+static float  aYear[DAYS];
+
+
+static void  time_sin_scalar(int i)
+{
+   (void) i;
+   for (int k = 0;  k < TRIG_SAMPLES;  k++)
+   {
+      aTrigOut[k] = my_sin(aTrigIn[k]);
+   }
+}
+
+static void  time_sin_batched(int i)
+{
+   (void) i;
+   my_sin_n(aTrigIn, aTrigOut, TRIG_SAMPLES);
+}
+
+
+static void  year_scalar(float latitude, float longitude, int sunset, float zenith)
+{
+   for (int d = 0;  d < DAYS;  d++)
+   {
+      //  (calcSun() takes day numbers past the month's end, as calcSun_n() does)
+      aYear[d] = calcSun(YEAR, 1, 1 + d, latitude, longitude, sunset, zenith);
+   }
+}
+
+static void  year_batched(float latitude, float longitude, int sunset, float zenith)
+{
+   calcSun_n(YEAR, 1, 1, DAYS, latitude, longitude, sunset, zenith, aYear);
+}
+
+static void  time_year_scalar(int i)  { year_scalar(51.5f, -0.1f, i & 1, aZeniths[0]); }
+static void  time_year_batched(int i) { year_batched(51.5f, -0.1f, i & 1, aZeniths[0]); }
+
+
+static void  grid_run(void (*year)(float, float, int, float))
+{
+   for (int lat = -GRID_LAT_MAX;  lat <= GRID_LAT_MAX;  lat += GRID_STEP)
+   {
+      for (int lon = -180;  lon < 180;  lon += GRID_STEP)
+      {
+         for (unsigned z = 0;  z < ARRAY_LENGTH(aZeniths);  z++)
+         {
+            year(lat, lon, 0, aZeniths[z]);
+            year(lat, lon, 1, aZeniths[z]);
+         }
+      }
+   }
+}
+
+static void  time_grid_scalar(int i)  { (void) i;  grid_run(year_scalar); }
+static void  time_grid_batched(int i) { (void) i;  grid_run(year_batched); }
+
+
+int  main(void)
+{
+
+   //  trig kernels, lane for lane
+   for (int k = 0;  k < TRIG_SAMPLES;  k++)
+   {
+      aTrigIn[k] = TRIG_RANGE * (2.0f * k / (TRIG_SAMPLES - 1) - 1.0f);
+   }
+
+   int  cTrigWrong = 0;
+
+   my_sin_n(aTrigIn, aTrigOut, TRIG_SAMPLES);
+   for (int k = 0;  k < TRIG_SAMPLES;  k++)
+   {
+      cTrigWrong += (aTrigOut[k] != my_sin(aTrigIn[k]));
+   }
+   my_cos_n(aTrigIn, aTrigOut, TRIG_SAMPLES);
+   for (int k = 0;  k < TRIG_SAMPLES;  k++)
+   {
+      cTrigWrong += (aTrigOut[k] != my_cos(aTrigIn[k]));
+   }
+   HOST_CHECK(cTrigWrong == 0, "%d batched sin / cos values differ from my_sin() / my_cos()", cTrigWrong);
+
+   //  a year at each grid point, zenith, rise and set
+   static float  aExpected[DAYS];
+
+   int  cYears = 0, cDaysWrong = 0;
+
+   for (int lat = -GRID_LAT_MAX;  lat <= GRID_LAT_MAX;  lat += GRID_STEP)
+   {
+      for (int lon = -180;  lon < 180;  lon += GRID_STEP)
+      {
+         for (unsigned z = 0;  z < ARRAY_LENGTH(aZeniths);  z++)
+         {
+            for (int sunset = 0;  sunset <= 1;  sunset++)
+            {
+               year_scalar(lat, lon, sunset, aZeniths[z]);
+               memcpy(aExpected, aYear, sizeof(aYear));
+               year_batched(lat, lon, sunset, aZeniths[z]);
+
+               for (int d = 0;  d < DAYS;  d++)
+               {
+                  if (aYear[d] != aExpected[d])
+                  {
+                     if (cDaysWrong++ == 0)
+                     {
+                        printf("  first difference: lat %d lon %d zenith %.3f %s, day %d: %f, %f\n",
+                               lat, lon, (double) aZeniths[z], sunset ? "set" : "rise", d,
+                               (double) aYear[d], (double) aExpected[d]);
+                     }
+                  }
+               }
+               cYears++;
+            }
+         }
+      }
+   }
+   HOST_CHECK(cDaysWrong == 0, "%d of %d days differ between calcSun_n() and calcSun()",
+              cDaysWrong, cYears * DAYS);
+
+#ifdef __AVX2__
+   const char * pszLanes = "8 lanes (AVX2)";
+#elif defined(__SSE2__)
+   const char * pszLanes = "4 lanes (SSE2)";
+#else
+   const char * pszLanes = "scalar only";
+#endif
+
+   printf("  %d years (%d locations x %u zeniths x rise / set) identical; batched kernels %s\n",
+          cYears, cYears / (2 * (int) ARRAY_LENGTH(aZeniths)), (unsigned) ARRAY_LENGTH(aZeniths),
+          pszLanes);
+
+   double  sinScalar   = host_time_us(2000, time_sin_scalar);
+   double  sinBatched  = host_time_us(2000, time_sin_batched);
+   double  yearScalar  = host_time_us(2000, time_year_scalar);
+   double  yearBatched = host_time_us(2000, time_year_batched);
+   double  gridScalar  = host_time_us(3, time_grid_scalar);
+   double  gridBatched = host_time_us(3, time_grid_batched);
+
+   printf("  host us, scalar / batched (speed-up):\n");
+   printf("    %-18s %9.1f / %9.1f  (%.2fx)\n", "my_sin() x 4096", sinScalar, sinBatched,
+          sinScalar / sinBatched);
+   printf("    %-18s %9.1f / %9.1f  (%.2fx)\n", "one year", yearScalar, yearBatched,
+          yearScalar / yearBatched);
+   printf("    %-18s %9.1f / %9.1f  (%.2fx)\n", "grid, every year", gridScalar, gridBatched,
+          gridScalar / gridBatched);
+
+   return host_failures != 0;
+
+}
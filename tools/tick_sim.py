@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+#
+#  Simulate a day of minute ticks and count the work the watchface's tick
+#  handler does, before and after src/tick_scheduler.c.
+#
+#  "Before" is the old handle_minute_tick(), which did everything every
+#  minute.  "After" runs each job only when tick_scheduler_poll() says it is
+#  due, and checks the tz offset against ConfigData.c's predicted next DST
+#  switch.  The scheduling rules below mirror tick_scheduler.c's
+#  next_due_minute(); keep the two in step.
+#
+#  Work is reported as calls per simulated day, per watch API or helper,
+#  since the cost of each varies by platform and firmware.
+#
+#  Usage:
+#
+#     tools/tick_sim.py [--platform basalt|chalk|aplite] [--dawn 300 --dusk 1140]
+#                       [--dst none|spring|fall]
+#
+#  Dawn / dusk are the active plan's astronomical twilight band edges, as
+#  local minutes of day (-1 for none).
+#
+
+import argparse
+import collections
+import math
+
+
+MINUTES_PER_DAY = 24 * 60
+NEVER_TODAY = MINUTES_PER_DAY
+HAND_SCAN_LIMIT = 60
+DAY_PLAN_PREPARE_MINUTE = 23 * 60
+
+#  localtime() calls to predict the next DST switch: weekly probes up to the
+#  switch (taken as half a year off) plus bisecting the week to the minute.
+TZ_PREDICTION_CALLS = 26 + 14
+
+TRIG_MAX_ANGLE = 0x10000
+TRIG_MAX_RATIO = 0xffff
+
+#  FACE_CENTER_X, FACE_CENTER_Y, HOUR_HAND_L_RADIUS from src/geometry.h
+GEOMETRY = {
+    'aplite': (72, 95, 57),
+    'basalt': (72, 95, 57),
+    'chalk':  (90, 90, 71),
+}
+
+EVENTS = ['MIDNIGHT', 'PLAN_PREPARE', 'TEXT_MINUTE', 'HAND_PIXEL', 'BAND_CHANGE']
+
+
+def trig_lookup(fn, angle):
+    """Integer sin_lookup() / cos_lookup() equivalent."""
+    return int(round(fn(2 * math.pi * angle / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO))
+
+
+def c_div(a, b):
+    """C integer division, truncating toward zero."""
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b >= 0) else -q
+
+
+def local_minutes(dst):
+    """
+    Local minute of day at each tick of a simulated day, and the index of
+    the first tick after a DST switch (or None).
+    """
+    if dst == 'spring':
+        #  02:00 never happens: clocks go from 01:59 to 03:00
+        return [m for m in range(MINUTES_PER_DAY) if not 120 <= m < 180], 120
+    if dst == 'fall':
+        #  01:00 - 01:59 happens twice
+        return list(range(120)) + list(range(60, MINUTES_PER_DAY)), 120
+    return list(range(MINUTES_PER_DAY)), None
+
+
+class Scheduler:
+
+    def __init__(self, platform, dawn, dusk):
+        self.cx, self.cy, self.radius = GEOMETRY[platform]
+        self.dawn, self.dusk = dawn, dusk
+        self.next_due = dict.fromkeys(EVENTS, 0)
+        self.last_minute = 0
+        self.work = collections.Counter()
+
+    def hand_tip_pixel(self, minute):
+        self.work['sched: sin/cos_lookup pair'] += 1
+        angle = ((minute + MINUTES_PER_DAY // 2) % MINUTES_PER_DAY) * TRIG_MAX_ANGLE // MINUTES_PER_DAY
+        x = self.cx + c_div(self.radius * trig_lookup(math.sin, angle), TRIG_MAX_RATIO)
+        y = self.cy - c_div(self.radius * trig_lookup(math.cos, angle), TRIG_MAX_RATIO)
+        return (x, y)
+
+    def next_due_minute(self, event, minute):
+        if event == 'MIDNIGHT':
+            return NEVER_TODAY
+        if event == 'PLAN_PREPARE':
+            return DAY_PLAN_PREPARE_MINUTE if minute < DAY_PLAN_PREPARE_MINUTE else NEVER_TODAY
+        if event == 'TEXT_MINUTE':
+            return minute + 1
+        if event == 'HAND_PIXEL':
+            tip = self.hand_tip_pixel(minute)
+            nxt = minute + 1
+            while (nxt < MINUTES_PER_DAY and nxt - minute < HAND_SCAN_LIMIT and
+                   self.hand_tip_pixel(nxt) == tip):
+                nxt += 1
+            return nxt
+        if event == 'BAND_CHANGE':
+            edges = [e for e in (self.dawn, self.dusk + 1) if e > minute]
+            return min(edges, default=NEVER_TODAY)
+        raise ValueError(event)
+
+    def poll(self, minute, new_day):
+        self.work['sched: poll'] += 1
+        if new_day or minute < self.last_minute:
+            self.next_due = dict.fromkeys(EVENTS, 0)
+        self.last_minute = minute
+        due = []
+        for event in EVENTS:
+            if self.next_due[event] <= minute:
+                due.append(event)
+                self.next_due[event] = self.next_due_minute(event, minute)
+        return due
+
+
+def old_tick_work(work, minute, round_face, hand_path):
+    """Everything the old handle_minute_tick() did, every minute."""
+    work['localtime (tz check)'] += 1
+    work['strftime'] += 2
+    work['clock_copy_time_string'] += 1
+    work['text_layer_set_text'] += 2 if round_face else 3
+    work['text_layer_set_background_color'] += 1
+    work['text_layer_set_text_alignment'] += 1
+    work['hour_hand_set_angle'] += 1
+    if hand_path:
+        work['is_dark_time'] += 1
+    work['layer_mark_dirty'] += 1
+    work['localtime (day check)'] += 1
+    if minute >= DAY_PLAN_PREPARE_MINUTE:
+        work['localtime (day check)'] += 1
+
+
+def new_tick_work(work, due, minute, round_face, hand_path, tz_switch):
+    """What handle_minute_tick() does now, for the events due."""
+    work['time() + compare (tz)'] += 1
+    if 'MIDNIGHT' in due or tz_switch:
+        #  daily verify, or the predicted switch: a real look, and on a
+        #  switch a new prediction
+        work['localtime (tz check)'] += 1
+    if tz_switch:
+        work['localtime (tz prediction)'] += TZ_PREDICTION_CALLS
+    if 'MIDNIGHT' in due:
+        work['strftime'] += 2
+        work['text_layer_set_text'] += 1 if round_face else 2
+    if 'TEXT_MINUTE' in due:
+        work['clock_copy_time_string'] += 1
+        work['text_layer_set_text'] += 1
+        work['layer_mark_dirty'] += 1
+    if 'HAND_PIXEL' in due:
+        work['hour_hand_set_angle'] += 1
+    if 'BAND_CHANGE' in due and hand_path:
+        work['is_dark_time'] += 1
+    if 'MIDNIGHT' in due or 'PLAN_PREPARE' in due:
+        work['localtime (day check)'] += 1
+        if minute >= DAY_PLAN_PREPARE_MINUTE:
+            work['localtime (day check)'] += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--platform', choices=sorted(GEOMETRY), default='basalt')
+    parser.add_argument('--dawn', type=int, default=300,
+                        help='astro band dawn, local minute of day (default 05:00)')
+    parser.add_argument('--dusk', type=int, default=1140,
+                        help='astro band dusk, local minute of day (default 19:00)')
+    parser.add_argument('--dst', choices=['none', 'spring', 'fall'], default='none')
+    args = parser.parse_args()
+
+    round_face = (args.platform == 'chalk')
+    hand_path = (args.platform != 'aplite')      # HOUR_HAND_USE_PATH
+    minutes, switch_tick = local_minutes(args.dst)
+
+    before = collections.Counter()
+    for minute in minutes:
+        old_tick_work(before, minute, round_face, hand_path)
+
+    sched = Scheduler(args.platform, args.dawn, args.dusk)
+    after = sched.work
+    due_counts = collections.Counter()
+    for i, minute in enumerate(minutes):
+        due = sched.poll(minute, new_day=(i == 0))
+        due_counts.update(due)
+        new_tick_work(after, due, minute, round_face, hand_path, i == switch_tick)
+
+    print('%s, dawn %d, dusk %d, dst %s: %d ticks' %
+          (args.platform, args.dawn, args.dusk, args.dst, len(minutes)))
+    print()
+    print('  %-34s %8s %8s' % ('calls per day', 'before', 'after'))
+    for key in sorted(set(before) | set(after)):
+        print('  %-34s %8d %8d' % (key, before[key], after[key]))
+    print('  %-34s %8d %8d' % ('total', sum(before.values()), sum(after.values())))
+    print()
+    print('  events due:')
+    for event in EVENTS:
+        print('    %-16s %6d' % (event, due_counts[event]))
+
+
+if __name__ == '__main__':
+    main()
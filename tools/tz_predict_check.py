@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+#
+#  Check src/ConfigData.c's prediction of the next DST / UTC offset change
+#  against the host's timezone database, for a set of zones with awkward
+#  rules: both hemispheres, 30 minute DST, switches at :45, Ramadan
+#  suspensions of DST, zones that have abolished DST, and zones without it.
+#
+#  predict_next_tz_change() below mirrors the C function; keep the two in
+#  step.  For each zone, the watch is simulated from a series of start
+#  times: predict, "wake" at the predicted minute, re-read the offset,
+#  predict again.  Each prediction is compared with the true next change,
+#  found by brute force scan.
+#
+#  Usage:
+#
+#     tools/tz_predict_check.py [--from 2024-01-01] [--years 3] [zone ...]
+#
+#  This checks the search against the host's tz database, through a copy
+#  of the C code: it can't catch a fault in the C itself, nor the case of a
+#  watch whose localtime() doesn't yet know the next switch when predicting
+#  (ConfigData.c re-predicts at its daily check for that).
+#
+#  Exits non-zero if any prediction is wrong.  Needs python 3.9+ (zoneinfo)
+#  and the system tz database.
+#
+
+import argparse
+import datetime
+import sys
+import zoneinfo
+
+
+TZ_PROBE_STEP_SECS = 7 * 24 * 3600
+TZ_PROBE_STEPS = 53
+
+DEFAULT_ZONES = [
+    'America/Los_Angeles',
+    'America/Santiago',
+    'America/Sao_Paulo',
+    'Europe/Berlin',
+    'Europe/London',
+    'Africa/Casablanca',
+    'Asia/Tehran',
+    'Asia/Tokyo',
+    'Australia/Sydney',
+    'Australia/Lord_Howe',
+    'Pacific/Chatham',
+]
+
+
+class Watch:
+    """The watch's view of one zone: localtime() offsets, with a call count."""
+
+    def __init__(self, zone):
+        self.zone = zoneinfo.ZoneInfo(zone)
+        self.calls = 0
+
+    def tz_secs_at(self, t):
+        self.calls += 1
+        return self.offset(t)
+
+    def offset(self, t):
+        dt = datetime.datetime.fromtimestamp(t, tz=self.zone)
+        return int(dt.utcoffset().total_seconds())
+
+
+def predict_next_tz_change(watch, time_from, tz_secs_from):
+    """Mirror of ConfigData.c's predict_next_tz_change()."""
+    time_before = time_from - (time_from % 60)
+
+    for _ in range(TZ_PROBE_STEPS):
+        time_probe = time_before + TZ_PROBE_STEP_SECS
+
+        if watch.tz_secs_at(time_probe) != tz_secs_from:
+            while time_probe - time_before > 60:
+                time_mid = time_before + ((time_probe - time_before) // 120) * 60
+                if watch.tz_secs_at(time_mid) == tz_secs_from:
+                    time_before = time_mid
+                else:
+                    time_probe = time_mid
+            return time_probe
+
+        time_before = time_probe
+
+    return time_before
+
+
+def true_next_change(watch, time_from, limit):
+    """First whole minute after time_from with a different offset, or None."""
+    start = time_from - (time_from % 60)
+    offset = watch.offset(start)
+    t = start
+    while t < limit:
+        #  hourly scan, then back up to the minute
+        step = min(3600, limit - t)
+        if watch.offset(t + step) != offset:
+            for m in range(t + 60, t + step + 1, 60):
+                if watch.offset(m) != offset:
+                    return m
+        t += step
+    return None
+
+
+def check_zone(zone, start, end, start_step):
+    watch = Watch(zone)
+    failures = 0
+    predictions = 0
+    switches = set()
+
+    t0 = start
+    while t0 < end:
+        t = t0
+        #  follow the watch through two predictions from each start time
+        for _ in range(2):
+            offset = watch.tz_secs_at(t)
+            predicted = predict_next_tz_change(watch, t, offset)
+            predictions += 1
+
+            horizon = (t - t % 60) + TZ_PROBE_STEPS * TZ_PROBE_STEP_SECS
+            actual = true_next_change(watch, t, horizon)
+            expected = actual if actual is not None else horizon
+            if predicted != expected:
+                failures += 1
+                print('  FAIL %s from %s: predicted %s, expected %s' %
+                      (zone, iso(t), iso(predicted), iso(expected)))
+            if actual is not None:
+                switches.add(actual)
+            t = predicted
+        t0 += start_step
+
+    print('%-22s %4d predictions, %3d distinct switches, %5.1f localtime() calls each, %d wrong' %
+          (zone, predictions, len(switches), watch.calls / predictions, failures))
+    return failures
+
+
+def iso(t):
+    return datetime.datetime.fromtimestamp(t, tz=datetime.timezone.utc).strftime('%Y-%m-%d %H:%MZ')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--from', dest='start', default='2024-01-01')
+    parser.add_argument('--years', type=int, default=3)
+    parser.add_argument('--start-step-days', type=int, default=23,
+                        help='spacing of simulated start times')
+    parser.add_argument('zones', nargs='*', default=DEFAULT_ZONES)
+    args = parser.parse_args()
+
+    start = int(datetime.datetime.fromisoformat(args.start)
+                .replace(tzinfo=datetime.timezone.utc).timestamp())
+    end = start + args.years * 365 * 24 * 3600
+
+    failures = 0
+    for zone in args.zones:
+        #  (an odd number of seconds, so start times aren't minute aligned)
+        failures += check_zone(zone, start + 17, end, args.start_step_days * 24 * 3600 + 17)
+
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())